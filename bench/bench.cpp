@@ -0,0 +1,150 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "bench.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+namespace libbitcoin {
+namespace bench {
+
+// Consecutive mainnet blocks, stored as base16 in the archived test data.
+struct fixture
+{
+    const char* file;
+    const char* hash;
+};
+
+static const fixture mainnet_blocks[] =
+{
+    { "blk0", "00000000000008324ab78e2274603ef9ab8b5f8238c6d9409236e121bf720785" },
+    { "blk1", "000000000000047a70dd377762e9d134e8d2268a238174c11db5bb0829c1ac58" },
+    { "blk2", "0000000000000130767cce191b7e515df6563c02ed7ed6fbe14526fe31817137" }
+};
+
+void escape(const void*)
+{
+}
+
+context::context(const std::string& name, scale kind,
+    const bench::settings& settings, const bench::fixtures& fixtures)
+  : name_(name), kind_(kind), settings_(settings), fixtures_(fixtures)
+{
+}
+
+const bench::fixtures& context::fixtures() const
+{
+    return fixtures_;
+}
+
+const result::list& context::results() const
+{
+    return results_;
+}
+
+const std::string& context::failure() const
+{
+    return failure_;
+}
+
+void context::fail(const std::string& reason)
+{
+    failure_ = reason;
+}
+
+void context::record(const std::string& variant, size_t items,
+    size_t iterations, std::vector<double>& samples)
+{
+    std::sort(samples.begin(), samples.end());
+    const auto middle = samples.size() / 2;
+    const auto median = samples.size() % 2 != 0 ? samples[middle] :
+        (samples[middle - 1] + samples[middle]) / 2;
+
+    results_.push_back(
+    {
+        variant.empty() ? name_ : name_ + "/" + variant,
+        kind_,
+        samples.size(),
+        iterations,
+        items,
+        samples.front(),
+        median,
+        samples.back()
+    });
+}
+
+benchmark::list& registry()
+{
+    static benchmark::list benchmarks;
+    return benchmarks;
+}
+
+registrar::registrar(const std::string& name, scale kind,
+    benchmark::function run)
+{
+    registry().push_back({ name, kind, run });
+}
+
+static bool read_base16(data_chunk& out, const std::string& path)
+{
+    std::ifstream file(path);
+
+    if (!file)
+        return false;
+
+    std::string text;
+    std::copy_if(std::istreambuf_iterator<char>(file),
+        std::istreambuf_iterator<char>(), std::back_inserter(text),
+        [](char character) { return !std::isspace(character); });
+
+    return decode_base16(out, text);
+}
+
+bool load(bench::fixtures& out, const std::string& directory)
+{
+    out.raw_blocks.clear();
+    out.blocks.clear();
+
+    for (const auto& fixture: mainnet_blocks)
+    {
+        data_chunk raw;
+        chain::block block;
+        hash_digest expected;
+
+        if (!read_base16(raw, directory + "/" + fixture.file) ||
+            !block.from_data(raw) || !decode_hash(expected, fixture.hash) ||
+            block.hash() != expected)
+            return false;
+
+        out.raw_blocks.push_back(std::move(raw));
+        out.blocks.push_back(std::move(block));
+    }
+
+    return true;
+}
+
+} // namespace bench
+} // namespace libbitcoin
@@ -0,0 +1,209 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_BENCH_BENCH_HPP
+#define LIBBITCOIN_BENCH_BENCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+namespace libbitcoin {
+namespace bench {
+
+/// Micro benchmarks repeat an operation until each sample reaches the
+/// minimum sample time. Macro benchmarks time one operation per sample.
+enum class scale
+{
+    micro,
+    macro
+};
+
+struct settings
+{
+    /// The number of timed samples of each measurement.
+    size_t samples;
+
+    /// The minimum duration of a micro benchmark sample.
+    std::chrono::milliseconds minimum;
+
+    /// Run only benchmarks with names containing this text.
+    std::string filter;
+};
+
+/// Mainnet blocks, verified against their hashes when loaded.
+struct fixtures
+{
+    data_stack raw_blocks;
+    chain::block::list blocks;
+};
+
+/// The timing of one measurement, in nanoseconds per operation.
+struct result
+{
+    typedef std::vector<result> list;
+
+    std::string name;
+    scale kind;
+    size_t samples;
+    size_t iterations;
+    size_t items;
+    double minimum;
+    double median;
+    double maximum;
+};
+
+/// Prevent the optimizer from discarding the value at the pointer.
+void escape(const void* pointer);
+
+/// Prevent the optimizer from discarding the computation of a value.
+template <typename Value>
+inline void consume(const Value& value)
+{
+#ifdef __GNUC__
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    escape(&value);
+#endif
+}
+
+/// The state of a running benchmark, which may record many measurements.
+class context
+{
+public:
+    context(const std::string& name, scale kind,
+        const bench::settings& settings,
+        const bench::fixtures& fixtures);
+
+    const bench::fixtures& fixtures() const;
+    const result::list& results() const;
+
+    /// The reason the benchmark could not be run, empty if none.
+    const std::string& failure() const;
+
+    /// Abandon the benchmark, for example if its setup cannot be verified.
+    void fail(const std::string& reason);
+
+    /// Time the operation, which processes the given number of items.
+    template <typename Operation>
+    void measure(size_t items, Operation operation)
+    {
+        measure("", items, operation);
+    }
+
+    /// Time the operation, as above, recorded as a variant of the benchmark.
+    template <typename Operation>
+    void measure(const std::string& variant, size_t items,
+        Operation operation)
+    {
+        const auto iterations = kind_ == scale::micro ?
+            calibrate(operation) : 1;
+
+        std::vector<double> samples;
+        samples.reserve(settings_.samples);
+
+        for (size_t sample = 0; sample < settings_.samples; ++sample)
+        {
+            const auto elapsed = time(iterations, operation);
+            samples.push_back(static_cast<double>(elapsed.count()) /
+                iterations);
+        }
+
+        record(variant, items, iterations, samples);
+    }
+
+private:
+    typedef std::chrono::steady_clock clock;
+
+    template <typename Operation>
+    static std::chrono::nanoseconds time(size_t iterations,
+        Operation& operation)
+    {
+        const auto start = clock::now();
+
+        for (size_t iteration = 0; iteration < iterations; ++iteration)
+            operation();
+
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            clock::now() - start);
+    }
+
+    // Double the iterations until a sample takes the minimum time. This also
+    // warms caches and lazily initialized state before timing starts.
+    template <typename Operation>
+    size_t calibrate(Operation& operation) const
+    {
+        size_t iterations = 1;
+
+        while (time(iterations, operation) < settings_.minimum)
+            iterations *= 2;
+
+        return iterations;
+    }
+
+    void record(const std::string& variant, size_t items, size_t iterations,
+        std::vector<double>& samples);
+
+    const std::string name_;
+    const scale kind_;
+    const settings& settings_;
+    const bench::fixtures& fixtures_;
+    result::list results_;
+    std::string failure_;
+};
+
+/// A registered benchmark.
+struct benchmark
+{
+    typedef std::function<void(context&)> function;
+    typedef std::vector<benchmark> list;
+
+    std::string name;
+    scale kind;
+    function run;
+};
+
+/// All benchmarks registered by BC_BENCHMARK, in order of registration.
+benchmark::list& registry();
+
+/// Load and verify the mainnet block fixtures from the directory.
+bool load(bench::fixtures& out, const std::string& directory);
+
+class registrar
+{
+public:
+    registrar(const std::string& name, scale kind,
+        benchmark::function run);
+};
+
+} // namespace bench
+} // namespace libbitcoin
+
+/// Define and register a benchmark of the given scale (micro or macro).
+#define BC_BENCHMARK(name, kind) \
+    static void name(bc::bench::context& context); \
+    static const bc::bench::registrar name##_registrar(#name, \
+        bc::bench::scale::kind, name); \
+    static void name(bc::bench::context& context)
+
+#endif
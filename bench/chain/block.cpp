@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <bitcoin/bitcoin.hpp>
+#include "../bench.hpp"
+
+using namespace bc;
+using namespace bc::chain;
+
+static size_t transaction_count(const block::list& blocks)
+{
+    size_t count = 0;
+
+    for (const auto& block: blocks)
+        count += block.transactions().size();
+
+    return count;
+}
+
+BC_BENCHMARK(block__from_data, micro)
+{
+    const auto& raw_blocks = context.fixtures().raw_blocks;
+    const auto count = transaction_count(context.fixtures().blocks);
+
+    context.measure(count, [&raw_blocks]()
+    {
+        for (const auto& raw: raw_blocks)
+            bench::consume(block::factory_from_data(raw));
+    });
+}
+
+BC_BENCHMARK(block__to_data, micro)
+{
+    const auto& blocks = context.fixtures().blocks;
+    const auto count = transaction_count(blocks);
+
+    context.measure(count, [&blocks]()
+    {
+        for (const auto& block: blocks)
+            bench::consume(block.to_data());
+    });
+}
+
+// Transaction hashes are cached by the fixtures, so this times the tree.
+BC_BENCHMARK(block__generate_merkle_root, micro)
+{
+    const auto& blocks = context.fixtures().blocks;
+    const auto count = transaction_count(blocks);
+
+    for (const auto& block: blocks)
+    {
+        if (!block.is_valid_merkle_root())
+        {
+            context.fail("fixture merkle root mismatch");
+            return;
+        }
+    }
+
+    context.measure(count, [&blocks]()
+    {
+        for (const auto& block: blocks)
+            bench::consume(block.generate_merkle_root());
+    });
+}
+
+BC_BENCHMARK(header__check, micro)
+{
+    const auto& blocks = context.fixtures().blocks;
+
+    context.measure(blocks.size(), [&blocks]()
+    {
+        for (const auto& block: blocks)
+            bench::consume(block.header().check());
+    });
+}
+
+// Parse each raw block and run the context free checks, from cold hashes.
+BC_BENCHMARK(block__check, macro)
+{
+    const auto& raw_blocks = context.fixtures().raw_blocks;
+    const auto count = transaction_count(context.fixtures().blocks);
+
+    for (const auto& raw: raw_blocks)
+    {
+        if (block::factory_from_data(raw).check())
+        {
+            context.fail("fixture block check failed");
+            return;
+        }
+    }
+
+    context.measure(count, [&raw_blocks]()
+    {
+        for (const auto& raw: raw_blocks)
+            bench::consume(block::factory_from_data(raw).check());
+    });
+}
@@ -0,0 +1,219 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <bitcoin/bitcoin.hpp>
+#include "../bench.hpp"
+
+using namespace bc;
+using namespace bc::chain;
+
+static const uint32_t flags = rule_fork::bip16_rule | rule_fork::bip65_rule |
+    rule_fork::bip66_rule;
+
+// A signed single input spend of a standard template.
+struct spend
+{
+    transaction tx;
+    script prevout;
+};
+
+static operation push(const data_chunk& data)
+{
+    return{ data_to_opcode(data), data };
+}
+
+static ec_secret make_secret(uint8_t seed)
+{
+    return sha256_hash(data_chunk{ seed });
+}
+
+static data_chunk make_point(const ec_secret& secret)
+{
+    ec_compressed point;
+    secret_to_public(point, secret);
+    return to_chunk(point);
+}
+
+static transaction make_transaction()
+{
+    const output_point previous(bitcoin_hash(data_chunk{ 0x2a }), 0);
+    const script payment(operation::to_pay_key_hash_pattern(
+        bitcoin_short_hash(data_chunk{ 0x2a })));
+
+    return
+    {
+        1, 0,
+        { { previous, {}, max_input_sequence } },
+        { { 50000, payment } }
+    };
+}
+
+static bool endorse(data_stack& out, const transaction& tx,
+    const script& script_code, const std::vector<ec_secret>& secrets)
+{
+    for (const auto& secret: secrets)
+    {
+        endorsement endorsement;
+        if (!script::create_endorsement(endorsement, secret, script_code, tx,
+            0, sighash_algorithm::all))
+            return false;
+
+        out.push_back(endorsement);
+    }
+
+    return true;
+}
+
+static bool make_pay_key_hash(spend& out)
+{
+    const auto secret = make_secret(1);
+    const auto point = make_point(secret);
+    out.prevout = operation::to_pay_key_hash_pattern(bitcoin_short_hash(point));
+    out.tx = make_transaction();
+
+    data_stack endorsements;
+    if (!endorse(endorsements, out.tx, out.prevout, { secret }))
+        return false;
+
+    out.tx.inputs().front().set_script(operation::stack
+    {
+        push(endorsements.front()),
+        push(point)
+    });
+
+    return true;
+}
+
+static bool make_pay_public_key(spend& out)
+{
+    const auto secret = make_secret(1);
+    out.prevout = operation::to_pay_public_key_pattern(make_point(secret));
+    out.tx = make_transaction();
+
+    data_stack endorsements;
+    if (!endorse(endorsements, out.tx, out.prevout, { secret }))
+        return false;
+
+    out.tx.inputs().front().set_script(operation::stack
+    {
+        push(endorsements.front())
+    });
+
+    return true;
+}
+
+// Two of three multisig, spent directly or through a script hash.
+static bool make_multisig(spend& out, bool script_hash)
+{
+    const std::vector<ec_secret> secrets
+    {
+        make_secret(1), make_secret(2), make_secret(3)
+    };
+
+    const data_stack points
+    {
+        make_point(secrets[0]), make_point(secrets[1]), make_point(secrets[2])
+    };
+
+    const script redeem(operation::to_pay_multisig_pattern(2, points));
+    const auto redeem_data = redeem.to_data(false);
+    out.prevout = script_hash ? script(operation::to_pay_script_hash_pattern(
+        bitcoin_short_hash(redeem_data))) : redeem;
+    out.tx = make_transaction();
+
+    data_stack endorsements;
+    if (!endorse(endorsements, out.tx, redeem, { secrets[0], secrets[1] }))
+        return false;
+
+    operation::stack input_script
+    {
+        { opcode::zero, {} },
+        push(endorsements[0]),
+        push(endorsements[1])
+    };
+
+    if (script_hash)
+        input_script.push_back(push(redeem_data));
+
+    out.tx.inputs().front().set_script(input_script);
+    return true;
+}
+
+// Time verification with and without the process-wide signature cache.
+static void measure(bench::context& context, const spend& payment)
+{
+    const auto& tx = payment.tx;
+    const auto& prevout = payment.prevout;
+
+    if (script::verify(tx, 0, prevout, flags))
+    {
+        context.fail("script verification failed");
+        return;
+    }
+
+    context.measure("cached", 1, [&tx, &prevout]()
+    {
+        bench::consume(script::verify(tx, 0, prevout, flags));
+    });
+
+    context.measure("uncached", 1, [&tx, &prevout]()
+    {
+        signature_cache::instance().clear();
+        bench::consume(script::verify(tx, 0, prevout, flags));
+    });
+}
+
+BC_BENCHMARK(script__verify__pay_key_hash, micro)
+{
+    spend payment;
+    if (!make_pay_key_hash(payment))
+        context.fail("signing failed");
+    else
+        measure(context, payment);
+}
+
+BC_BENCHMARK(script__verify__pay_public_key, micro)
+{
+    spend payment;
+    if (!make_pay_public_key(payment))
+        context.fail("signing failed");
+    else
+        measure(context, payment);
+}
+
+BC_BENCHMARK(script__verify__pay_multisig, micro)
+{
+    spend payment;
+    if (!make_multisig(payment, false))
+        context.fail("signing failed");
+    else
+        measure(context, payment);
+}
+
+BC_BENCHMARK(script__verify__pay_script_hash, micro)
+{
+    spend payment;
+    if (!make_multisig(payment, true))
+        context.fail("signing failed");
+    else
+        measure(context, payment);
+}
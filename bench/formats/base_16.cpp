@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <bitcoin/bitcoin.hpp>
+#include "../bench.hpp"
+
+using namespace bc;
+
+// The stream formatting and character tests replaced by the table codec,
+// retained here as the baseline of its measurements.
+namespace baseline {
+
+static std::string encode_base16(data_slice data)
+{
+    std::stringstream ss;
+    ss << std::hex << std::setfill('0');
+    for (int val: data)
+        ss << std::setw(2) << val;
+    return ss.str();
+}
+
+static unsigned from_hex(const char c)
+{
+    if ('A' <= c && c <= 'F')
+        return 10 + c - 'A';
+    if ('a' <= c && c <= 'f')
+        return 10 + c - 'a';
+    return c - '0';
+}
+
+static bool decode_base16(data_chunk& out, const std::string& in)
+{
+    if (in.size() % 2 != 0 || !std::all_of(in.begin(), in.end(), is_base16))
+        return false;
+
+    data_chunk result(in.size() / 2);
+    auto cursor = in.data();
+
+    for (auto& byte: result)
+    {
+        byte = (from_hex(cursor[0]) << 4) + from_hex(cursor[1]);
+        cursor += 2;
+    }
+
+    out = result;
+    return true;
+}
+
+} // namespace baseline
+
+BC_BENCHMARK(base16__encode_hash, micro)
+{
+    const auto hash = context.fixtures().blocks.front().hash();
+
+    context.measure(1, [&hash]()
+    {
+        bench::consume(encode_hash(hash));
+    });
+}
+
+BC_BENCHMARK(base16__decode_hash, micro)
+{
+    const auto encoded = encode_hash(context.fixtures().blocks.front().hash());
+
+    context.measure(1, [&encoded]()
+    {
+        hash_digest decoded;
+        bench::consume(decode_hash(decoded, encoded));
+        bench::consume(decoded);
+    });
+}
+
+// Bulk conversion of a raw block, with an item for each byte.
+BC_BENCHMARK(base16__encode_block, micro)
+{
+    const auto& raw = context.fixtures().raw_blocks.front();
+    std::string encoded(2 * raw.size(), '\0');
+
+    context.measure("buffer", raw.size(), [&raw, &encoded]()
+    {
+        encode_base16(&encoded.front(), raw);
+        bench::consume(encoded);
+    });
+
+    context.measure("string", raw.size(), [&raw]()
+    {
+        bench::consume(encode_base16(raw));
+    });
+
+    context.measure("baseline", raw.size(), [&raw]()
+    {
+        bench::consume(baseline::encode_base16(raw));
+    });
+}
+
+BC_BENCHMARK(base16__decode_block, micro)
+{
+    const auto& raw = context.fixtures().raw_blocks.front();
+    const auto encoded = encode_base16(raw);
+    data_chunk decoded(raw.size());
+
+    context.measure("buffer", raw.size(), [&encoded, &decoded]()
+    {
+        bench::consume(decode_base16(decoded.data(), decoded.size(),
+            encoded.c_str()));
+        bench::consume(decoded);
+    });
+
+    context.measure("chunk", raw.size(), [&encoded]()
+    {
+        data_chunk decoded;
+        bench::consume(decode_base16(decoded, encoded));
+        bench::consume(decoded);
+    });
+
+    context.measure("baseline", raw.size(), [&encoded]()
+    {
+        data_chunk decoded;
+        bench::consume(baseline::decode_base16(decoded, encoded));
+        bench::consume(decoded);
+    });
+}
@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <bitcoin/bitcoin.hpp>
+#include "../bench.hpp"
+
+using namespace bc;
+
+// A version byte and a short hash, the payload of a payment address.
+static const data_chunk address_payload
+{
+    0x00, 0x88, 0x35, 0x05, 0x74, 0x28, 0x03, 0x95, 0xad, 0x2c, 0x3e, 0x2e,
+    0xe2, 0x0e, 0x32, 0x20, 0x73, 0xd9, 0x4e, 0x5e, 0x40
+};
+
+BC_BENCHMARK(base58__encode, micro)
+{
+    context.measure(1, []()
+    {
+        bench::consume(encode_base58(address_payload));
+    });
+}
+
+BC_BENCHMARK(base58__decode, micro)
+{
+    const auto encoded = encode_base58(address_payload);
+
+    context.measure(1, [&encoded]()
+    {
+        data_chunk decoded;
+        bench::consume(decode_base58(decoded, encoded));
+        bench::consume(decoded);
+    });
+}
+
+BC_BENCHMARK(base58__encode_checked, micro)
+{
+    context.measure(1, []()
+    {
+        bench::consume(encode_base58_checked(address_payload));
+    });
+}
+
+BC_BENCHMARK(base58__decode_checked, micro)
+{
+    const auto encoded = encode_base58_checked(address_payload);
+
+    context.measure(1, [&encoded]()
+    {
+        byte_array<25> decoded;
+        bench::consume(decode_base58_checked(decoded, encoded));
+        bench::consume(decoded);
+    });
+}
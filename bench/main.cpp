@@ -0,0 +1,211 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <boost/lexical_cast.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include "bench.hpp"
+
+BC_USE_LIBBITCOIN_MAIN
+
+using namespace bc;
+using namespace bc::bench;
+
+// Relative to the source root, from which the benchmarks are expected to run.
+static const std::string default_fixtures = "archive/oldtests/fork-blks";
+
+static const auto usage =
+    "Usage: libbitcoin_bench [--json] [--samples=<count>] "
+    "[--minimum=<milliseconds>] [--filter=<text>] [--fixtures=<directory>]";
+
+struct options
+{
+    bench::settings settings;
+    std::string fixtures;
+    bool json;
+};
+
+static bool starts_with(const std::string& text, const std::string& prefix,
+    std::string& remainder)
+{
+    if (text.compare(0, prefix.size(), prefix) != 0)
+        return false;
+
+    remainder = text.substr(prefix.size());
+    return true;
+}
+
+template <typename Value>
+static bool parse(Value& out, const std::string& text)
+{
+    try
+    {
+        out = boost::lexical_cast<Value>(text);
+        return true;
+    }
+    catch (const boost::bad_lexical_cast&)
+    {
+        return false;
+    }
+}
+
+static bool parse(options& out, int argc, char* argv[])
+{
+    out.settings.samples = 10;
+    out.settings.minimum = std::chrono::milliseconds(50);
+    out.fixtures = default_fixtures;
+    out.json = false;
+
+    for (auto index = 1; index < argc; ++index)
+    {
+        size_t milliseconds;
+        std::string value;
+        const std::string argument(argv[index]);
+
+        if (argument == "--json")
+            out.json = true;
+        else if (starts_with(argument, "--samples=", value))
+        {
+            if (!parse(out.settings.samples, value) ||
+                out.settings.samples == 0)
+                return false;
+        }
+        else if (starts_with(argument, "--minimum=", value))
+        {
+            if (!parse(milliseconds, value))
+                return false;
+
+            out.settings.minimum = std::chrono::milliseconds(milliseconds);
+        }
+        else if (starts_with(argument, "--filter=", value))
+            out.settings.filter = value;
+        else if (starts_with(argument, "--fixtures=", value))
+            out.fixtures = value;
+        else
+            return false;
+    }
+
+    return true;
+}
+
+static std::string to_string(scale kind)
+{
+    return kind == scale::micro ? "micro" : "macro";
+}
+
+// Benchmark names are identifiers, so they require no json escaping.
+static void write_json(std::ostream& out, const options& options,
+    const result::list& results)
+{
+    out << "{" << std::endl
+        << "  \"library\": \"" << LIBBITCOIN_VERSION << "\"," << std::endl
+        << "  \"unit\": \"ns/op\"," << std::endl
+        << "  \"samples\": " << options.settings.samples << "," << std::endl
+        << "  \"minimum_ms\": " << options.settings.minimum.count() << ","
+        << std::endl << "  \"results\": [" << std::endl;
+
+    for (size_t index = 0; index < results.size(); ++index)
+    {
+        const auto& result = results[index];
+        out << "    { \"name\": \"" << result.name << "\", "
+            << "\"scale\": \"" << to_string(result.kind) << "\", "
+            << "\"samples\": " << result.samples << ", "
+            << "\"iterations\": " << result.iterations << ", "
+            << "\"items\": " << result.items << ", "
+            << "\"minimum\": " << result.minimum << ", "
+            << "\"median\": " << result.median << ", "
+            << "\"maximum\": " << result.maximum << " }"
+            << (index + 1 < results.size() ? "," : "") << std::endl;
+    }
+
+    out << "  ]" << std::endl << "}" << std::endl;
+}
+
+static void write_text(std::ostream& out, const result& result)
+{
+    const auto per_item = result.items == 0 ? 0.0 :
+        result.median / result.items;
+
+    out << std::left << std::setw(48) << result.name << std::right
+        << std::setw(6) << to_string(result.kind)
+        << std::setw(16) << result.median << " ns/op"
+        << std::setw(14) << per_item << " ns/item"
+        << "  [" << result.minimum << ", " << result.maximum << "]"
+        << std::endl;
+}
+
+int bc::main(int argc, char* argv[])
+{
+    set_utf8_stdio();
+
+    options options;
+    if (!parse(options, argc, argv))
+    {
+        bc::cerr << usage << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    bench::fixtures fixtures;
+    if (!load(fixtures, options.fixtures))
+    {
+        bc::cerr << "Failed to load block fixtures from: " << options.fixtures
+            << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    auto success = true;
+    result::list results;
+    bc::cout << std::fixed << std::setprecision(1);
+
+    for (const auto& benchmark: registry())
+    {
+        if (benchmark.name.find(options.settings.filter) == std::string::npos)
+            continue;
+
+        context context(benchmark.name, benchmark.kind, options.settings,
+            fixtures);
+        benchmark.run(context);
+
+        if (!context.failure().empty())
+        {
+            bc::cerr << benchmark.name << " failed: " << context.failure()
+                << std::endl;
+            success = false;
+            continue;
+        }
+
+        for (const auto& result: context.results())
+        {
+            if (!options.json)
+                write_text(bc::cout, result);
+
+            results.push_back(result);
+        }
+    }
+
+    if (options.json)
+        write_json(bc::cout, options, results);
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin.hpp>
+#include "../bench.hpp"
+
+using namespace bc;
+
+static const ec_secret secret = hash_literal(
+    "ce8f4b713ffdd2658900845251890f30371856be201cd1f5b3d970f793634333");
+
+BC_BENCHMARK(elliptic_curve__sign, micro)
+{
+    const auto hash = bitcoin_hash(data_chunk{ 0x2a });
+
+    context.measure(1, [&hash]()
+    {
+        ec_signature signature;
+        bench::consume(sign(signature, secret, hash));
+        bench::consume(signature);
+    });
+}
+
+BC_BENCHMARK(elliptic_curve__verify_signature, micro)
+{
+    ec_compressed point;
+    ec_signature signature;
+    const auto hash = bitcoin_hash(data_chunk{ 0x2a });
+
+    if (!secret_to_public(point, secret) || !sign(signature, secret, hash) ||
+        !verify_signature(point, hash, signature))
+    {
+        context.fail("signing failed");
+        return;
+    }
+
+    context.measure("compressed", 1, [&point, &hash, &signature]()
+    {
+        bench::consume(verify_signature(point, hash, signature));
+    });
+
+    ec_uncompressed uncompressed;
+    decompress(uncompressed, point);
+
+    context.measure("uncompressed", 1, [&uncompressed, &hash, &signature]()
+    {
+        bench::consume(verify_signature(uncompressed, hash, signature));
+    });
+
+    // Verification through a private cache, which hits after calibration.
+    signature_cache cache;
+
+    context.measure("cached", 1, [&cache, &point, &hash, &signature]()
+    {
+        bench::consume(cache.verify(point, hash, signature));
+    });
+}
+
+BC_BENCHMARK(elliptic_curve__secret_to_public, micro)
+{
+    context.measure(1, []()
+    {
+        ec_compressed point;
+        bench::consume(secret_to_public(point, secret));
+        bench::consume(point);
+    });
+}
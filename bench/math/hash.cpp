@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <bitcoin/bitcoin.hpp>
+#include "../bench.hpp"
+
+using namespace bc;
+using namespace bc::chain;
+
+BC_BENCHMARK(bitcoin_hash__header, micro)
+{
+    const auto header = context.fixtures().blocks.front().header().to_data();
+
+    context.measure(1, [&header]()
+    {
+        bench::consume(bitcoin_hash(header));
+    });
+}
+
+BC_BENCHMARK(bitcoin_hash__kilobyte, micro)
+{
+    const data_chunk data(1024, 0x42);
+
+    context.measure(1, [&data]()
+    {
+        bench::consume(bitcoin_hash(data));
+    });
+}
+
+// Hash each serialized transaction of each block, as for a merkle root.
+BC_BENCHMARK(bitcoin_hash__transactions, micro)
+{
+    data_stack transactions;
+
+    for (const auto& block: context.fixtures().blocks)
+        for (const auto& tx: block.transactions())
+            transactions.push_back(tx.to_data());
+
+    context.measure(transactions.size(), [&transactions]()
+    {
+        for (const auto& tx: transactions)
+            bench::consume(bitcoin_hash(tx));
+    });
+}
+
+BC_BENCHMARK(sha256_hash__kilobyte, micro)
+{
+    const data_chunk data(1024, 0x42);
+
+    context.measure(1, [&data]()
+    {
+        bench::consume(sha256_hash(data));
+    });
+}
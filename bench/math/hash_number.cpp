@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include "../bench.hpp"
+
+using namespace bc;
+
+static const size_t headers = 500000;
+
+// Compact targets falling from the genesis difficulty, as on mainnet.
+static std::vector<uint32_t> make_bits(size_t count)
+{
+    static const uint32_t first_exponent = 0x1d;
+    static const uint32_t exponents = 6;
+    static const uint32_t mantissa_limit = 0x7f0000;
+    std::vector<uint32_t> bits;
+    bits.reserve(count);
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        const auto exponent = first_exponent -
+            static_cast<uint32_t>(index * exponents / count);
+        const auto mantissa = 0x00ffff +
+            static_cast<uint32_t>(index * 7919 % mantissa_limit);
+        bits.push_back(exponent << 24 | mantissa);
+    }
+
+    return bits;
+}
+
+// The work of a header is 2^256 / (target + 1), or ~target / (target + 1) + 1
+// within 256 bits, summed to compare the work of chains.
+static bool sum_work(hash_number& out, const std::vector<uint32_t>& bits)
+{
+    out = 0;
+    const hash_number one(1);
+
+    for (const auto compact: bits)
+    {
+        hash_number target;
+        if (!target.set_compact(compact))
+            return false;
+
+        out += (~target / (target + one)) + one;
+    }
+
+    return true;
+}
+
+BC_BENCHMARK(hash_number__sum_work, macro)
+{
+    const auto bits = make_bits(headers);
+    hash_number total;
+
+    if (!sum_work(total, bits))
+    {
+        context.fail("invalid compact target");
+        return;
+    }
+
+    context.measure(headers, [&bits]()
+    {
+        hash_number total;
+        bench::consume(sum_work(total, bits));
+        bench::consume(total);
+    });
+}
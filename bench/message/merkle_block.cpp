@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include "../bench.hpp"
+
+using namespace bc;
+
+typedef std::vector<message::merkle_block> merkle_blocks;
+
+// One merkle block per fixture, matching every stride-th transaction.
+static merkle_blocks filter(const chain::block::list& blocks, size_t stride)
+{
+    merkle_blocks out;
+
+    for (const auto& block: blocks)
+    {
+        std::vector<bool> matches(block.transactions().size());
+
+        for (size_t index = 0; index < matches.size(); index += stride)
+            matches[index] = true;
+
+        out.emplace_back(block, matches);
+    }
+
+    return out;
+}
+
+// Each item is a merkle block, as received from a peer by an spv client.
+BC_BENCHMARK(merkle_block__extract_matches, micro)
+{
+    const auto& blocks = context.fixtures().blocks;
+    const auto single = filter(blocks, max_size_t);
+    const auto sparse = filter(blocks, 16);
+    const auto dense = filter(blocks, 1);
+
+    for (const auto& merkle: dense)
+    {
+        if (!merkle.is_valid_merkle_root())
+        {
+            context.fail("fixture merkle tree invalid");
+            return;
+        }
+    }
+
+    const auto extract = [](const merkle_blocks& merkles)
+    {
+        return [&merkles]()
+        {
+            hash_list hashes;
+            chain::block::indexes positions;
+
+            for (const auto& merkle: merkles)
+                bench::consume(merkle.extract_matches(hashes, positions));
+
+            bench::consume(hashes);
+        };
+    };
+
+    context.measure("single", single.size(), extract(single));
+    context.measure("sparse", sparse.size(), extract(sparse));
+    context.measure("dense", dense.size(), extract(dense));
+}
@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <thread>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include "../bench.hpp"
+
+using namespace bc;
+
+typedef std::function<void(const code&)> result_handler;
+
+static const size_t jobs = 10000;
+
+static size_t pool_size()
+{
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+static void job(size_t, result_handler handler)
+{
+    handler(error::success);
+}
+
+// Fan out trivial jobs and fan in their results with the synchronizer.
+template <template <typename> class Synchronizer>
+static void fan_out(dispatcher& dispatch, const std::vector<size_t>& items)
+{
+    std::promise<void> complete;
+    const auto handler = [&complete](const code&)
+    {
+        complete.set_value();
+    };
+
+    dispatch.parallel<Synchronizer>(items, "bench", handler, &job);
+    complete.get_future().wait();
+}
+
+BC_BENCHMARK(dispatcher__parallel, macro)
+{
+    threadpool pool(pool_size());
+    dispatcher dispatch(pool, "bench");
+    const std::vector<size_t> items(jobs);
+
+    context.measure("synchronizer", jobs, [&dispatch, &items]()
+    {
+        fan_out<synchronizer>(dispatch, items);
+    });
+
+    context.measure("atomic_synchronizer", jobs, [&dispatch, &items]()
+    {
+        fan_out<atomic_synchronizer>(dispatch, items);
+    });
+}
+
+// Hash the serialized transactions of the blocks across the threadpool.
+BC_BENCHMARK(parallel_for__bitcoin_hash, macro)
+{
+    threadpool pool(pool_size());
+    data_stack transactions;
+
+    for (const auto& block: context.fixtures().blocks)
+        for (const auto& tx: block.transactions())
+            transactions.push_back(tx.to_data());
+
+    hash_list hashes(transactions.size());
+    const auto count = transactions.size();
+
+    const auto hash = [&transactions, &hashes](size_t begin, size_t end)
+    {
+        for (auto index = begin; index < end; ++index)
+            hashes[index] = bitcoin_hash(transactions[index]);
+    };
+
+    context.measure("serial", count, [&hash, count]()
+    {
+        hash(0, count);
+    });
+
+    context.measure("threadpool", count, [&pool, &hash, &hashes, count]()
+    {
+        parallel_for(pool, count, 16, hash);
+        bench::consume(hashes);
+    });
+}
@@ -0,0 +1,93 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <bitcoin/bitcoin.hpp>
+#include "../bench.hpp"
+
+using namespace bc;
+
+typedef subscriber<size_t> size_subscriber;
+typedef resubscriber<size_t> size_resubscriber;
+
+static const size_t subscriptions = 10000;
+static const size_t relays = 100;
+
+static size_t pool_size()
+{
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+// Subscribe each time and notify once, as for one shot requests.
+BC_BENCHMARK(subscriber__subscribe_invoke, micro)
+{
+    threadpool pool(pool_size());
+    const auto instance = std::make_shared<size_subscriber>(pool, "bench");
+    instance->start();
+    size_t notified = 0;
+
+    context.measure(subscriptions, [&instance, &notified]()
+    {
+        for (size_t index = 0; index < subscriptions; ++index)
+            instance->subscribe([&notified](size_t value)
+            {
+                notified += value;
+            }, 0);
+
+        instance->invoke(1);
+        bench::consume(notified);
+    });
+
+    instance->stop();
+}
+
+// Retained subscribers notified by a burst of relays, as for block and
+// transaction announcements to many channels. Zero clears the subscribers.
+BC_BENCHMARK(resubscriber__relay, macro)
+{
+    threadpool pool(pool_size());
+    const auto instance = std::make_shared<size_resubscriber>(pool, "bench");
+    instance->start();
+    std::atomic<size_t> notified(0);
+
+    for (size_t index = 0; index < subscriptions; ++index)
+        instance->subscribe([&notified](size_t value)
+        {
+            ++notified;
+            return value != 0;
+        }, 0);
+
+    context.measure(relays * subscriptions, [&instance, &notified]()
+    {
+        notified = 0;
+
+        for (size_t relay = 0; relay < relays; ++relay)
+            instance->relay(1);
+
+        while (notified.load() < relays * subscriptions)
+            std::this_thread::yield();
+    });
+
+    instance->stop();
+    instance->invoke(0);
+}
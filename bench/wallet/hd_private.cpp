@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <bitcoin/bitcoin.hpp>
+#include "../bench.hpp"
+
+using namespace bc;
+using namespace bc::wallet;
+
+static const auto range = 256u;
+
+static hd_private make_key()
+{
+    return hd_private(to_chunk(base16_literal("000102030405060708090a0b0c0d0e0f")));
+}
+
+BC_BENCHMARK(hd_private__derive_private, micro)
+{
+    const auto key = make_key();
+
+    context.measure("normal", 1, [&key]()
+    {
+        bench::consume(key.derive_private(0));
+    });
+
+    context.measure("hardened", 1, [&key]()
+    {
+        bench::consume(key.derive_private(hd_first_hardened_key));
+    });
+}
+
+BC_BENCHMARK(hd_public__derive_public, micro)
+{
+    const auto key = make_key().to_public();
+
+    context.measure(1, [&key]()
+    {
+        bench::consume(key.derive_public(0));
+    });
+}
+
+// Derive a range of addresses, as for wallet discovery.
+BC_BENCHMARK(hd_public__derive_range, macro)
+{
+    const auto key = make_key().to_public();
+    threadpool pool(std::max(std::thread::hardware_concurrency(), 1u));
+
+    context.measure("serial", range, [&key]()
+    {
+        bench::consume(key.derive_range(0, range));
+    });
+
+    context.measure("threadpool", range, [&key, &pool]()
+    {
+        bench::consume(key.derive_range(0, range, pool));
+    });
+}
+
+BC_BENCHMARK(hd_private__derive_range, macro)
+{
+    const auto key = make_key();
+    threadpool pool(std::max(std::thread::hardware_concurrency(), 1u));
+
+    context.measure("serial", range, [&key]()
+    {
+        bench::consume(key.derive_range(0, range));
+    });
+
+    context.measure("threadpool", range, [&key, &pool]()
+    {
+        bench::consume(key.derive_range(0, range, pool));
+    });
+}
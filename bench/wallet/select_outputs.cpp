@@ -0,0 +1,154 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <bitcoin/bitcoin.hpp>
+#include "../bench.hpp"
+
+using namespace bc;
+using namespace bc::chain;
+using namespace bc::wallet;
+
+// Unspent set sizes of a small, a busy and an exchange scale wallet.
+static const struct
+{
+    const char* name;
+    size_t count;
+} sizes[] =
+{
+    { "10k", 10000 },
+    { "100k", 100000 },
+    { "1m", 1000000 }
+};
+
+static const uint64_t spend = 100000000;
+static const uint64_t cost_of_change = 1000;
+
+// Values are spread over five orders of magnitude, from a fixed seed.
+static output_info::list make_unspent(size_t count)
+{
+    std::mt19937_64 engine(42);
+    std::uniform_int_distribution<uint64_t> exponent(3, 7);
+    std::uniform_int_distribution<uint64_t> mantissa(1, 9);
+    output_info::list unspent;
+    unspent.reserve(count);
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        hash_digest hash = null_hash;
+        const auto bytes = to_little_endian(static_cast<uint32_t>(index));
+        std::copy(bytes.begin(), bytes.end(), hash.begin());
+
+        uint64_t value = mantissa(engine);
+        for (auto power = exponent(engine); power > 0; --power)
+            value *= 10;
+
+        unspent.push_back({ { hash, 0 }, value });
+    }
+
+    return unspent;
+}
+
+BC_BENCHMARK(unspent_index__construct, macro)
+{
+    for (const auto& size: sizes)
+    {
+        const auto unspent = make_unspent(size.count);
+
+        context.measure(size.name, size.count, [&unspent]()
+        {
+            const unspent_index index(unspent);
+            bench::consume(index.total());
+        });
+    }
+}
+
+// A spend and a receipt of one output, as the index is maintained.
+BC_BENCHMARK(unspent_index__remove_add, micro)
+{
+    for (const auto& size: sizes)
+    {
+        const auto unspent = make_unspent(size.count);
+        unspent_index index(unspent);
+        size_t next = 0;
+
+        context.measure(size.name, 1, [&]()
+        {
+            const auto& output = unspent[next++ % unspent.size()];
+            bench::consume(index.remove(output.point));
+            bench::consume(index.add(output));
+        });
+    }
+}
+
+BC_BENCHMARK(select_outputs__index, micro)
+{
+    typedef select_outputs::algorithm algorithm;
+    static const struct
+    {
+        const char* name;
+        algorithm option;
+    } algorithms[] =
+    {
+        { "greedy", algorithm::greedy },
+        { "largest_first", algorithm::largest_first },
+        { "branch_and_bound", algorithm::branch_and_bound },
+        { "knapsack", algorithm::knapsack }
+    };
+
+    for (const auto& size: sizes)
+    {
+        const unspent_index index(make_unspent(size.count));
+
+        for (const auto& selection: algorithms)
+        {
+            const auto option = selection.option;
+            const auto name = std::string(selection.name) + "/" + size.name;
+
+            context.measure(name, 1, [&index, option]()
+            {
+                points_info out;
+                select_outputs::select(out, index, spend, option,
+                    cost_of_change);
+                bench::consume(out);
+            });
+        }
+    }
+}
+
+// The list overload copies and orders the unspent set on each spend, so
+// this is the baseline of select_outputs__index/greedy.
+BC_BENCHMARK(select_outputs__list, macro)
+{
+    for (const auto& size: sizes)
+    {
+        const auto unspent = make_unspent(size.count);
+
+        context.measure(size.name, 1, [&unspent]()
+        {
+            points_info out;
+            select_outputs::select(out, unspent, spend);
+            bench::consume(out);
+        });
+    }
+}
@@ -66,6 +66,8 @@
 #include <bitcoin/bitcoin/log/file_collector.hpp>
 #include <bitcoin/bitcoin/log/file_collector_repository.hpp>
 #include <bitcoin/bitcoin/log/file_counter_formatter.hpp>
+#include <bitcoin/bitcoin/log/levels.hpp>
+#include <bitcoin/bitcoin/log/ring_queue.hpp>
 #include <bitcoin/bitcoin/log/severity.hpp>
 #include <bitcoin/bitcoin/log/sinks.hpp>
 #include <bitcoin/bitcoin/log/sources.hpp>
@@ -75,7 +77,10 @@
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/hash_number.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
+#include <bitcoin/bitcoin/math/murmur3.hpp>
 #include <bitcoin/bitcoin/math/script_number.hpp>
+#include <bitcoin/bitcoin/math/signature_cache.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
 #include <bitcoin/bitcoin/math/stealth.hpp>
 #include <bitcoin/bitcoin/math/uint256.hpp>
 #include <bitcoin/bitcoin/message/address.hpp>
@@ -83,7 +88,9 @@
 #include <bitcoin/bitcoin/message/alert_payload.hpp>
 #include <bitcoin/bitcoin/message/block_message.hpp>
 #include <bitcoin/bitcoin/message/block_transactions.hpp>
+#include <bitcoin/bitcoin/message/bloom_filter.hpp>
 #include <bitcoin/bitcoin/message/compact_block.hpp>
+#include <bitcoin/bitcoin/message/compact_block_reconstructor.hpp>
 #include <bitcoin/bitcoin/message/fee_filter.hpp>
 #include <bitcoin/bitcoin/message/filter_add.hpp>
 #include <bitcoin/bitcoin/message/filter_clear.hpp>
@@ -98,6 +105,7 @@
 #include <bitcoin/bitcoin/message/heading.hpp>
 #include <bitcoin/bitcoin/message/inventory.hpp>
 #include <bitcoin/bitcoin/message/inventory_vector.hpp>
+#include <bitcoin/bitcoin/message/lazy_block_message.hpp>
 #include <bitcoin/bitcoin/message/memory_pool.hpp>
 #include <bitcoin/bitcoin/message/merkle_block.hpp>
 #include <bitcoin/bitcoin/message/network_address.hpp>
@@ -144,6 +152,8 @@
 #include <bitcoin/bitcoin/utility/monitor.hpp>
 #include <bitcoin/bitcoin/utility/notifier.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
+#include <bitcoin/bitcoin/utility/pipeline.hpp>
 #include <bitcoin/bitcoin/utility/png.hpp>
 #include <bitcoin/bitcoin/utility/random.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
@@ -178,6 +188,8 @@
 #include <bitcoin/bitcoin/wallet/qrcode.hpp>
 #include <bitcoin/bitcoin/wallet/select_outputs.hpp>
 #include <bitcoin/bitcoin/wallet/stealth_address.hpp>
+#include <bitcoin/bitcoin/wallet/stealth_scanner.hpp>
+#include <bitcoin/bitcoin/wallet/unspent_index.hpp>
 #include <bitcoin/bitcoin/wallet/uri.hpp>
 #include <bitcoin/bitcoin/wallet/uri_reader.hpp>
 
@@ -33,6 +33,8 @@
 namespace libbitcoin {
 namespace chain {
 
+class header;
+
 class BC_API chain_state
 {
 public:
@@ -63,7 +65,16 @@ public:
         /// block - 0 [mainnet: high (unused)]
         size_t timestamp_self;
 
-        /// block - 2016 [or high (unused)]
+        /// block - 0 [required only for promotion]
+        size_t bits_self;
+
+        /// block - 0 [required only for promotion]
+        size_t version_self;
+
+        /// The retarget height of the period of block - 1.
+        /// block - 2016 [when block is a retarget height]
+        /// Otherwise it is the retarget height below block - 1, outside of the
+        /// timestamp range, an additional read required only for promotion.
         size_t timestamp_retarget;
     };
 
@@ -83,10 +94,21 @@ public:
         hash_digest hash;
 
         /// Values must be ordered by height with high (block - 1) last.
-        struct { bitss ordered; } bits;
+        /// Self is the value of the block, required only for promotion.
+        struct
+        {
+            bitss ordered;
+            uint32_t self;
+        } bits;
 
-        /// Values are unordered.
-        struct { versions unordered; } version;
+        /// Values are unordered for activation, but promotion treats them as
+        /// a ring ordered by height with high (block - 1) last, replacing the
+        /// lowest. Self is the value of the block, required only for promotion.
+        struct
+        {
+            versions unordered;
+            uint32_t self;
+        } version;
 
         /// Values must be ordered by height with high (block - 1) last.
         struct
@@ -103,6 +125,13 @@ public:
     /// Checkpoints must be ordered by height with greatest at back.
     chain_state(data&& values, const checkpoints& checkpoints);
 
+    /// Promote the state of a block to that of its child, given its header.
+    /// The windows of the parent slide by one block without requery. The
+    /// state is invalid if the parent version sample was reduced by get_map
+    /// and the child requires the full sample, in which case query instead.
+    /// The state is also invalid if the parent sample exceeds its capacity.
+    chain_state(const chain_state& parent, const header& header);
+
     /// Properties.
     size_t height() const;
     uint32_t enabled_forks() const;
@@ -138,7 +167,17 @@ protected:
         uint32_t minimum_version;
     };
 
+    struct tallies
+    {
+        // The number of sampled versions at or above each fork version.
+        size_t bip34;
+        size_t bip66;
+        size_t bip65;
+    };
+
+    static tallies tally(const data& values);
     static activations activation(const data& values);
+    static activations activation(const data& values, const tallies& counts);
     static uint32_t median_time_past(const data& values);
     static uint32_t work_required(const data& values);
 
@@ -148,11 +187,22 @@ private:
     static uint32_t work_required_testnet(const data& values);
     static bool is_retarget_or_nonmax(size_t height, uint32_t bits);
     static bool is_retarget_height(size_t height);
+    static void tally(tallies& counts, uint32_t version, bool add);
+
+    static data to_child(const chain_state& parent, const header& header);
+    static size_t to_child_head(const chain_state& parent);
+    static tallies to_child_tallies(const chain_state& parent);
+    static tallies to_child_sample(const chain_state& parent);
 
     // This is retained as an optimization for other constructions.
     // A similar height clone can be partially computed, reducing query cost.
     const data data_;
 
+    // The sample position of the lowest version, and sample version counts.
+    // These allow the version sample to slide as a ring on promotion.
+    const size_t version_head_;
+    const tallies tallies_;
+
     // These are computed on construct from sample and checkpoints.
     const activations active_;
     const uint32_t median_time_past_;
@@ -143,6 +143,13 @@ public:
     bool is_valid_time_stamp() const;
     bool is_valid_proof_of_work() const;
 
+    /// True if the hash meets the target of valid bits, compared in place.
+    static bool is_valid_proof_of_work(uint32_t bits, const hash_digest& hash);
+
+    /// True if all headers have valid proof of work, expanding each distinct
+    /// run of bits once. Headers are not required to be linked.
+    static bool is_valid_proof_of_work(const list& headers);
+
     code check() const;
     code accept(const chain_state& state) const;
 
@@ -38,6 +38,19 @@ bool is_base16(const char c);
  */
 BC_API std::string encode_base16(data_slice data);
 
+/**
+ * Write data as hex into a caller buffer of at least 2 * data.size()
+ * characters. The buffer is not null terminated.
+ */
+BC_API void encode_base16(char* out, data_slice data);
+
+/**
+ * Convert 2 * out_size hex characters into a caller buffer of out_size bytes.
+ * The input must be readable for 2 * out_size characters.
+ * @return false if the input is malformed, in which case out is undefined.
+ */
+BC_API bool decode_base16(uint8_t* out, size_t out_size, const char* in);
+
 /**
  * Convert a hex string into bytes.
  * @return false if the input is malformed.
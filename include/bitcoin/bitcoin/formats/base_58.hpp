@@ -36,6 +36,15 @@ BC_API bool is_base58(const std::string& text);
 template <size_t Size>
 bool decode_base58(byte_array<Size>& out, const std::string &in);
 
+/**
+ * Converts a base58 string to a number of bytes, the last four of which must
+ * be a valid bitcoin checksum of the others.
+ * @return false if the input is malformed, the wrong length, or the checksum
+ * does not verify.
+ */
+template <size_t Size>
+bool decode_base58_checked(byte_array<Size>& out, const std::string& in);
+
 /**
  * Converts a base58 string literal to a data array.
  * This would be better as a C++11 user-defined literal,
@@ -51,6 +60,12 @@ byte_array<Size * 733 / 1000> base58_literal(const char(&string)[Size]);
  */
 BC_API std::string encode_base58(data_slice unencoded);
 
+/**
+ * Encode data as base58 with an appended four byte bitcoin checksum.
+ * @return the base58 encoded string.
+ */
+BC_API std::string encode_base58_checked(data_slice unchecked);
+
 /**
  * Attempt to decode base58 data.
  * @return false if the input contains non-base58 characters.
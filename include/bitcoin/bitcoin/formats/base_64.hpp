@@ -20,6 +20,8 @@
 #ifndef LIBBITCOIN_BASE_64_HPP
 #define LIBBITCOIN_BASE_64_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
@@ -32,6 +34,21 @@ namespace libbitcoin {
  */
 BC_API std::string encode_base64(data_slice unencoded);
 
+/**
+ * Write data as base64 into a caller buffer of at least 4 * ceil(size / 3)
+ * characters. The buffer is not null terminated.
+ * @return the number of characters written.
+ */
+BC_API size_t encode_base64(char* out, data_slice unencoded);
+
+/**
+ * Decode in_size base64 characters into a caller buffer of at least
+ * 3 * (in_size / 4) bytes, and set out_size to the number of bytes written.
+ * @return false if the input is malformed, in which case out is undefined.
+ */
+BC_API bool decode_base64(uint8_t* out, size_t& out_size, const char* in,
+    size_t in_size);
+
 /**
  * Attempt to decode base64 data.
  * @return false if the input contains non-base64 characters.
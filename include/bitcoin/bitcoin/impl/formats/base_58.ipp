@@ -20,6 +20,7 @@
 #ifndef LIBBITCOIN_BASE_58_IPP
 #define LIBBITCOIN_BASE_58_IPP
 
+#include <bitcoin/bitcoin/math/checksum.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 
@@ -40,6 +41,18 @@ bool decode_base58(byte_array<Size>& out, const std::string &in)
     return true;
 }
 
+template <size_t Size>
+bool decode_base58_checked(byte_array<Size>& out, const std::string& in)
+{
+    byte_array<Size> result;
+    if (!decode_base58_private(result.data(), result.size(), in.data()) ||
+        !verify_checksum(result))
+        return false;
+
+    out = result;
+    return true;
+}
+
 // TODO: determine if the sizing function is always accurate.
 template <size_t Size>
 byte_array<Size * 733 / 1000> base58_literal(const char(&string)[Size])
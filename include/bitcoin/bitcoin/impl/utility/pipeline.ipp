@@ -0,0 +1,224 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_PIPELINE_IPP
+#define LIBBITCOIN_PIPELINE_IPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <utility>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+template <typename Item>
+pipeline<Item>::pipeline(threadpool& pool, size_t capacity)
+  : pool_(pool), capacity_(std::max(capacity, size_t(1))), sequence_(0),
+    in_flight_(0)
+{
+}
+
+template <typename Item>
+pipeline<Item>::~pipeline()
+{
+    join();
+}
+
+template <typename Item>
+void pipeline<Item>::concurrent(handler stage)
+{
+    add(std::move(stage), false);
+}
+
+template <typename Item>
+void pipeline<Item>::ordered(handler stage)
+{
+    add(std::move(stage), true);
+}
+
+template <typename Item>
+void pipeline<Item>::push(Item item)
+{
+    size_t sequence;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    {
+        boost::unique_lock<boost::mutex> lock(mutex_);
+        changed_.wait(lock, [this]()
+        {
+            return in_flight_ < capacity_;
+        });
+
+        ++in_flight_;
+        sequence = sequence_++;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+
+    post(std::make_shared<token>(token{ sequence, std::move(item), true }), 0);
+}
+
+template <typename Item>
+void pipeline<Item>::wait()
+{
+    join();
+    std::exception_ptr failure;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        std::swap(failure, failure_);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+
+    if (failure)
+        std::rethrow_exception(failure);
+}
+
+// private
+template <typename Item>
+void pipeline<Item>::add(handler handle, bool ordered)
+{
+    stages_.emplace_back(new stage{ std::move(handle), ordered, {}, 0, {} });
+}
+
+// private
+template <typename Item>
+void pipeline<Item>::join()
+{
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    changed_.wait(lock, [this]()
+    {
+        return in_flight_ == 0;
+    });
+}
+
+// private
+// A throwing stage fails the item, so that it still completes and releases
+// its place in each ordered stage.
+template <typename Item>
+bool pipeline<Item>::invoke(stage& stage, Item& item)
+{
+    try
+    {
+        return stage.handle(item);
+    }
+    catch (...)
+    {
+        // Critical Section
+        ///////////////////////////////////////////////////////////////////////
+        boost::lock_guard<boost::mutex> lock(mutex_);
+
+        if (!failure_)
+            failure_ = std::current_exception();
+
+        return false;
+        ///////////////////////////////////////////////////////////////////////
+    }
+}
+
+// private
+// Carry the job through the stages until complete or parked.
+template <typename Item>
+void pipeline<Item>::run(token_ptr job, size_t index)
+{
+    for (; index < stages_.size(); ++index)
+    {
+        auto& stage = *stages_[index];
+
+        if (!stage.ordered)
+        {
+            if (job->live)
+                job->live = invoke(stage, job->item);
+
+            continue;
+        }
+
+        // Critical Section
+        ///////////////////////////////////////////////////////////////////////
+        {
+            boost::lock_guard<boost::mutex> lock(stage.mutex);
+
+            // Park until the preceding item has passed this stage.
+            if (job->sequence != stage.next)
+            {
+                stage.pending.emplace(job->sequence, job);
+                return;
+            }
+        }
+        ///////////////////////////////////////////////////////////////////////
+
+        // No other job can match the sequence until next is advanced.
+        if (job->live)
+            job->live = invoke(stage, job->item);
+
+        token_ptr successor;
+
+        // Critical Section
+        ///////////////////////////////////////////////////////////////////////
+        {
+            boost::lock_guard<boost::mutex> lock(stage.mutex);
+            const auto it = stage.pending.find(++stage.next);
+
+            if (it != stage.pending.end())
+            {
+                successor = std::move(it->second);
+                stage.pending.erase(it);
+            }
+        }
+        ///////////////////////////////////////////////////////////////////////
+
+        // Resume the parked successor at this stage on another thread.
+        if (successor)
+            post(std::move(successor), index);
+    }
+
+    complete();
+}
+
+// private
+template <typename Item>
+void pipeline<Item>::post(token_ptr job, size_t index)
+{
+    pool_.service().post([this, job, index]()
+    {
+        run(job, index);
+    });
+}
+
+// private
+template <typename Item>
+void pipeline<Item>::complete()
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    // Notify under the lock, as the destructor may proceed once released.
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    --in_flight_;
+    changed_.notify_all();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+} // namespace libbitcoin
+
+#endif
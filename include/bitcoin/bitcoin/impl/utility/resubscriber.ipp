@@ -20,6 +20,8 @@
 #ifndef LIBBITCOIN_RESUBSCRIBER_IPP
 #define LIBBITCOIN_RESUBSCRIBER_IPP
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -35,7 +37,7 @@ namespace libbitcoin {
 template <typename... Args>
 resubscriber<Args...>::resubscriber(threadpool& pool,
     const std::string& class_name)
-  : stopped_(true), dispatch_(pool, class_name)
+  : top_(stopped), dispatch_(pool, class_name)
     /*, track<resubscriber<Args...>>(class_name)*/
 {
 }
@@ -43,72 +45,43 @@ resubscriber<Args...>::resubscriber(threadpool& pool,
 template <typename... Args>
 resubscriber<Args...>::~resubscriber()
 {
-    BITCOIN_ASSERT_MSG(subscriptions_.empty(), "resubscriber not cleared");
+    const auto remaining = to_subscription(top_.load());
+    BITCOIN_ASSERT_MSG(remaining == nullptr, "resubscriber not cleared");
+    clear(remaining);
 }
 
 template <typename... Args>
 void resubscriber<Args...>::start()
 {
-    // Critical Section
-    ///////////////////////////////////////////////////////////////////////////
-    subscribe_mutex_.lock_upgrade();
-
-    if (stopped_)
-    {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        subscribe_mutex_.unlock_upgrade_and_lock();
-        stopped_ = false;
-        subscribe_mutex_.unlock();
-        //---------------------------------------------------------------------
-        return;
-    }
-
-    subscribe_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
+    top_.fetch_and(~static_cast<uintptr_t>(stopped));
 }
 
 template <typename... Args>
 void resubscriber<Args...>::stop()
 {
-    // Critical Section
-    ///////////////////////////////////////////////////////////////////////////
-    subscribe_mutex_.lock_upgrade();
-
-    if (!stopped_)
-    {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        subscribe_mutex_.unlock_upgrade_and_lock();
-        stopped_ = true;
-        subscribe_mutex_.unlock();
-        //---------------------------------------------------------------------
-        return;
-    }
-
-    subscribe_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
+    top_.fetch_or(stopped);
 }
 
 template <typename... Args>
 void resubscriber<Args...>::subscribe(handler handler, Args... stopped_args)
 {
-    // Critical Section
-    ///////////////////////////////////////////////////////////////////////////
-    subscribe_mutex_.lock_upgrade();
+    const auto item = new subscription{ std::move(handler), nullptr };
+    auto top = top_.load(std::memory_order_acquire);
 
-    if (!stopped_)
+    // Push onto the stack unless stopped, retrying if the top changes.
+    do
     {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        subscribe_mutex_.unlock_upgrade_and_lock();
-        subscriptions_.emplace_back(handler);
-        subscribe_mutex_.unlock();
-        //---------------------------------------------------------------------
-        return;
-    }
-
-    subscribe_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
+        if ((top & stopped) != 0)
+        {
+            item->notify(stopped_args...);
+            delete item;
+            return;
+        }
 
-    handler(stopped_args...);
+        item->next = to_subscription(top);
+    } while (!top_.compare_exchange_weak(top,
+        reinterpret_cast<uintptr_t>(item), std::memory_order_release,
+        std::memory_order_acquire));
 }
 
 template <typename... Args>
@@ -125,6 +98,73 @@ void resubscriber<Args...>::relay(Args... args)
         this->shared_from_this(), args...);
 }
 
+// private
+template <typename... Args>
+typename resubscriber<Args...>::subscription*
+resubscriber<Args...>::to_subscription(uintptr_t top)
+{
+    return reinterpret_cast<subscription*>(top & ~static_cast<uintptr_t>(
+        stopped));
+}
+
+// private
+template <typename... Args>
+void resubscriber<Args...>::clear(subscription* item)
+{
+    while (item != nullptr)
+    {
+        const auto next = item->next;
+        delete item;
+        item = next;
+    }
+}
+
+// private
+// Resubscribe the retained subscriptions with one push, unless stopped.
+template <typename... Args>
+void resubscriber<Args...>::resubscribe(subscription* first,
+    subscription* last)
+{
+    if (first == nullptr)
+        return;
+
+    auto top = top_.load(std::memory_order_acquire);
+
+    do
+    {
+        if ((top & stopped) != 0)
+        {
+            last->next = nullptr;
+            clear(first);
+            return;
+        }
+
+        last->next = to_subscription(top);
+    } while (!top_.compare_exchange_weak(top,
+        reinterpret_cast<uintptr_t>(first), std::memory_order_release,
+        std::memory_order_acquire));
+}
+
+// private
+// Detach all subscriptions (retaining the stopped flag) in subscribe order.
+template <typename... Args>
+typename resubscriber<Args...>::subscription* resubscriber<Args...>::take()
+{
+    auto item = to_subscription(top_.fetch_and(stopped,
+        std::memory_order_acq_rel));
+
+    subscription* reversed = nullptr;
+    while (item != nullptr)
+    {
+        const auto next = item->next;
+        item->next = reversed;
+        reversed = item;
+        item = next;
+    }
+
+    return reversed;
+}
+
 // private
 template <typename... Args>
 void resubscriber<Args...>::do_invoke(Args... args)
@@ -133,43 +173,38 @@ void resubscriber<Args...>::do_invoke(Args... args)
     ///////////////////////////////////////////////////////////////////////////
     unique_lock lock(invoke_mutex_);
 
-    // Critical Section (protect stop)
-    ///////////////////////////////////////////////////////////////////////////
-    subscribe_mutex_.lock();
-
-    // Move subscribers from the member list to a temporary list.
-    list subscriptions;
-    std::swap(subscriptions, subscriptions_);
-
-    subscribe_mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
+    subscription* first = nullptr;
+    subscription* last = nullptr;
 
     // Subscriptions may be created while this loop is executing.
-    // Invoke subscribers from temporary list and resubscribe as indicated.
-    for (const auto& handler: subscriptions)
+    // Invoke subscribers from the detached list and retain as indicated.
+    // Retained subscriptions are linked in reverse, as the stack is ordered.
+    auto item = take();
+
+    try
     {
-        if (handler(args...))
+        while (item != nullptr)
         {
-            // Critical Section
-            ///////////////////////////////////////////////////////////////////
-            subscribe_mutex_.lock_upgrade();
+            std::unique_ptr<subscription> current(item);
+            item = item->next;
 
-            if (stopped_)
+            if (current->notify(args...))
             {
-                subscribe_mutex_.unlock_upgrade();
-                //-------------------------------------------------------------
-                continue;
+                current->next = first;
+                first = current.release();
+                last = last == nullptr ? first : last;
             }
-
-            subscribe_mutex_.unlock_upgrade_and_lock();
-            //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-            subscriptions_.emplace_back(handler);
-
-            subscribe_mutex_.unlock();
-            ///////////////////////////////////////////////////////////////////
         }
     }
+    catch (...)
+    {
+        // A throwing handler releases the subscriptions not yet notified.
+        clear(item);
+        resubscribe(first, last);
+        throw;
+    }
 
+    resubscribe(first, last);
     ///////////////////////////////////////////////////////////////////////////
 }
 
@@ -20,9 +20,12 @@
 #ifndef LIBBITCOIN_SUBSCRIBER_IPP
 #define LIBBITCOIN_SUBSCRIBER_IPP
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/dispatcher.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
@@ -34,7 +37,7 @@ namespace libbitcoin {
 template <typename... Args>
 subscriber<Args...>::subscriber(threadpool& pool,
     const std::string& class_name)
-  : stopped_(true), dispatch_(pool, class_name)
+  : top_(stopped), dispatch_(pool, class_name)
     /*, track<subscriber<Args...>>(class_name)*/
 {
 }
@@ -42,72 +45,43 @@ subscriber<Args...>::subscriber(threadpool& pool,
 template <typename... Args>
 subscriber<Args...>::~subscriber()
 {
-    BITCOIN_ASSERT_MSG(subscriptions_.empty(), "subscriber not cleared");
+    const auto remaining = to_subscription(top_.load());
+    BITCOIN_ASSERT_MSG(remaining == nullptr, "subscriber not cleared");
+    clear(remaining);
 }
 
 template <typename... Args>
 void subscriber<Args...>::start()
 {
-    // Critical Section
-    ///////////////////////////////////////////////////////////////////////////
-    subscribe_mutex_.lock_upgrade();
-
-    if (stopped_)
-    {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        subscribe_mutex_.unlock_upgrade_and_lock();
-        stopped_ = false;
-        subscribe_mutex_.unlock();
-        //---------------------------------------------------------------------
-        return;
-    }
-
-    subscribe_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
+    top_.fetch_and(~static_cast<uintptr_t>(stopped));
 }
 
 template <typename... Args>
 void subscriber<Args...>::stop()
 {
-    // Critical Section
-    ///////////////////////////////////////////////////////////////////////////
-    subscribe_mutex_.lock_upgrade();
-
-    if (!stopped_)
-    {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        subscribe_mutex_.unlock_upgrade_and_lock();
-        stopped_ = true;
-        subscribe_mutex_.unlock();
-        //---------------------------------------------------------------------
-        return;
-    }
-
-    subscribe_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
+    top_.fetch_or(stopped);
 }
 
 template <typename... Args>
 void subscriber<Args...>::subscribe(handler handler, Args... stopped_args)
 {
-    // Critical Section
-    ///////////////////////////////////////////////////////////////////////////
-    subscribe_mutex_.lock_upgrade();
+    const auto item = new subscription{ std::move(handler), nullptr };
+    auto top = top_.load(std::memory_order_acquire);
 
-    if (!stopped_)
+    // Push onto the stack unless stopped, retrying if the top changes.
+    do
     {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        subscribe_mutex_.unlock_upgrade_and_lock();
-        subscriptions_.emplace_back(handler);
-        subscribe_mutex_.unlock();
-        //---------------------------------------------------------------------
-        return;
-    }
-
-    subscribe_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    handler(stopped_args...);
+        if ((top & stopped) != 0)
+        {
+            item->notify(stopped_args...);
+            delete item;
+            return;
+        }
+
+        item->next = to_subscription(top);
+    } while (!top_.compare_exchange_weak(top,
+        reinterpret_cast<uintptr_t>(item), std::memory_order_release,
+        std::memory_order_acquire));
 }
 
 template <typename... Args>
@@ -126,27 +100,72 @@ void subscriber<Args...>::relay(Args... args)
 
 // private
 template <typename... Args>
-void subscriber<Args...>::do_invoke(Args... args)
+typename subscriber<Args...>::subscription*
+subscriber<Args...>::to_subscription(uintptr_t top)
 {
-    // Critical Section (prevent concurrent handler execution)
-    ///////////////////////////////////////////////////////////////////////////
-    unique_lock lock(invoke_mutex_);
+    return reinterpret_cast<subscription*>(top & ~static_cast<uintptr_t>(
+        stopped));
+}
 
-    // Critical Section (protect stop)
-    ///////////////////////////////////////////////////////////////////////////
-    subscribe_mutex_.lock();
+// private
+template <typename... Args>
+void subscriber<Args...>::clear(subscription* item)
+{
+    while (item != nullptr)
+    {
+        const auto next = item->next;
+        delete item;
+        item = next;
+    }
+}
+
+// private
+// Detach all subscriptions (retaining the stopped flag) in subscribe order.
+template <typename... Args>
+typename subscriber<Args...>::subscription* subscriber<Args...>::take()
+{
+    auto item = to_subscription(top_.fetch_and(stopped,
+        std::memory_order_acq_rel));
+
+    subscription* reversed = nullptr;
+    while (item != nullptr)
+    {
+        const auto next = item->next;
+        item->next = reversed;
+        reversed = item;
+        item = next;
+    }
 
-    // Move subscribers from the member list to a temporary list.
-    list subscriptions;
-    std::swap(subscriptions, subscriptions_);
+    return reversed;
+}
 
-    subscribe_mutex_.unlock();
+// private
+template <typename... Args>
+void subscriber<Args...>::do_invoke(Args... args)
+{
+    // Critical Section (prevent concurrent handler execution)
     ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(invoke_mutex_);
 
     // Subscriptions may be created while this loop is executing.
-    // Invoke subscribers from temporary list, without subscription renewal.
-    for (const auto& handler: subscriptions)
-        handler(args...);
+    // Invoke subscribers from the detached list, without subscription renewal.
+    auto item = take();
+
+    try
+    {
+        while (item != nullptr)
+        {
+            const std::unique_ptr<subscription> current(item);
+            item = item->next;
+            current->notify(args...);
+        }
+    }
+    catch (...)
+    {
+        // A throwing handler releases the subscriptions not yet notified.
+        clear(item);
+        throw;
+    }
 
     ///////////////////////////////////////////////////////////////////////////
 }
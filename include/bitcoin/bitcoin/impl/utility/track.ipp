@@ -36,6 +36,18 @@
 template <class Shared>
 std::atomic<size_t> track<Shared>::instances(0);
 
+template <class Shared>
+track<Shared>::track(const char* DEBUG_ONLY(class_name))
+#ifndef NDEBUG
+  : class_(class_name)
+#endif
+{
+#ifndef NDEBUG
+    const auto count = ++instances;
+    LOG_DEBUG(LOG_SYSTEM) << class_ << "(" << count << ")";
+#endif
+}
+
 template <class Shared>
 track<Shared>::track(const std::string& DEBUG_ONLY(class_name))
 #ifndef NDEBUG
@@ -43,7 +55,8 @@ track<Shared>::track(const std::string& DEBUG_ONLY(class_name))
 #endif
 {
 #ifndef NDEBUG
-    LOG_DEBUG(LOG_SYSTEM) << class_ << "(" << ++instances << ")";
+    const auto count = ++instances;
+    LOG_DEBUG(LOG_SYSTEM) << class_ << "(" << count << ")";
 #endif
 }
 
@@ -51,7 +64,9 @@ template <class Shared>
 track<Shared>::~track()
 {
 #ifndef NDEBUG
-    LOG_DEBUG(LOG_SYSTEM) << "~" << class_ << "(" << --instances << ")";
+    // The count is maintained even if the record is filtered.
+    const auto count = --instances;
+    LOG_DEBUG(LOG_SYSTEM) << "~" << class_ << "(" << count << ")";
 #endif
 }
 
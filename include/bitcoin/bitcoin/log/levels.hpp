@@ -0,0 +1,73 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_LOG_LEVELS_HPP
+#define LIBBITCOIN_LOG_LEVELS_HPP
+
+#include <atomic>
+#include <string>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/log/severity.hpp>
+
+namespace libbitcoin {
+namespace log {
+
+/// Runtime severity thresholds, checked by the LOG_* macros before a record
+/// is opened. Records below the threshold of their channel are not formatted.
+/// The channel table is fixed size, so reads require no lock.
+/// This class is thread safe.
+class BC_API levels
+{
+public:
+    /// The number of channels that may have their own level.
+    static const size_t capacity = 64;
+
+    /// Set the level of all channels without their own level.
+    static void set(severity level);
+
+    /// Set the level of the channel, false if the table is full.
+    static bool set(const std::string& channel, severity level);
+
+    /// Determine if records of the channel and severity are logged.
+    static bool enabled(const std::string& channel, severity level)
+    {
+        return enabled(channel.c_str(), level);
+    }
+
+    /// Determine if records of the channel and severity are logged.
+    /// This overload avoids a string copy for literal channel names.
+    static bool enabled(const char* channel, severity level)
+    {
+        // The floor is the lowest level of any channel, one load rejects.
+        const auto value = static_cast<int>(level);
+        return value >= floor_.load(std::memory_order_relaxed) &&
+            value >= threshold(channel);
+    }
+
+private:
+    static int threshold(const char* channel);
+    static void set_floor();
+
+    static std::atomic<int> floor_;
+};
+
+} // namespace log
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_LOG_RING_QUEUE_HPP
+#define LIBBITCOIN_LOG_RING_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/keywords/capacity.hpp>
+#include <boost/log/keywords/overflow_policy.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+
+namespace libbitcoin {
+namespace log {
+
+/// Handling of records logged while an asynchronous sink buffer is full.
+enum class overflow
+{
+    /// Block the logging thread until the writer frees space.
+    block,
+
+    /// Discard the record.
+    drop
+};
+
+/// Counts of records logged while an asynchronous sink buffer was full.
+struct overflows
+{
+    size_t blocked;
+    size_t dropped;
+};
+
+/// A bounded lock-free ring of log records, used as the queueing strategy of
+/// boost::log::sinks::asynchronous_sink. Producers and the writer thread
+/// exchange records without locking, a mutex is taken only to sleep when the
+/// ring is empty (writer) or full (blocking producers).
+/// Constructed by the sink from keywords::capacity and
+/// keywords::overflow_policy, defaulting to 8192 records and overflow::block.
+class BC_API ring_queue
+{
+public:
+    typedef boost::log::record_view record_view;
+    typedef std::function<void()> drained_handler;
+
+    /// Invoke the handler on the writer thread each time the ring drains.
+    /// This allows the backend to be flushed once per batch of records.
+    void set_drained_handler(drained_handler handler);
+
+    /// The overflow counts since construction.
+    overflows overflow_counts() const;
+
+    /// Release producers blocked on a full ring, dropping their records, and
+    /// drop rather than block from then on. Blocked producers are not
+    /// released by a flush, so call this before stopping the sink.
+    void close();
+
+protected:
+    template <typename Arguments>
+    explicit ring_queue(const Arguments& arguments)
+      : ring_queue(arguments[boost::log::keywords::capacity | size_t(8192)],
+            arguments[boost::log::keywords::overflow_policy | overflow::block])
+    {
+    }
+
+    ring_queue(size_t capacity, overflow policy);
+    ~ring_queue();
+
+    // Boost.Log queueing strategy interface.
+    void enqueue(const record_view& record);
+    bool try_enqueue(const record_view& record);
+    bool try_dequeue_ready(record_view& record);
+    bool try_dequeue(record_view& record);
+    bool dequeue_ready(record_view& record);
+    void interrupt_dequeue();
+
+private:
+    struct cell
+    {
+        std::atomic<size_t> sequence;
+        record_view record;
+    };
+
+    // These do not notify sleepers.
+    bool push(const record_view& record);
+    bool pop(record_view& record);
+    void notify_reader();
+    void notify_writers();
+
+    // The ring, sized to a power of two.
+    const size_t mask_;
+    const overflow policy_;
+    std::unique_ptr<cell[]> cells_;
+    std::atomic<size_t> head_;
+    std::atomic<size_t> tail_;
+
+    // Sleeping state, the flags avoid locking when nobody is asleep.
+    std::atomic<bool> reader_waiting_;
+    std::atomic<size_t> writers_waiting_;
+    bool interrupted_;
+    bool closed_;
+    boost::mutex mutex_;
+    boost::condition_variable readable_;
+    boost::condition_variable writable_;
+
+    // Writer thread state.
+    bool dirty_;
+    drained_handler drained_;
+
+    std::atomic<size_t> blocked_;
+    std::atomic<size_t> dropped_;
+};
+
+} // namespace log
+} // namespace libbitcoin
+
+#endif
@@ -34,6 +34,7 @@
 
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/log/attributes.hpp>
+#include <bitcoin/bitcoin/log/ring_queue.hpp>
 #include <bitcoin/bitcoin/log/severity.hpp>
 
 namespace libbitcoin {
@@ -55,6 +56,17 @@ struct rotable_file
     size_t maximum_files;
 };
 
+/// Asynchronous sink buffering. Records are formatted and written by one
+/// writer thread per sink, which flushes each time its buffer drains.
+struct asynchronous
+{
+    /// Records buffered per sink, rounded up to a power of two.
+    size_t capacity;
+
+    /// Handling of records logged while the buffer is full.
+    overflow policy;
+};
+
 /// Initializes default non-rotable libbitcoin logging sinks and formats.
 void initialize(log::file& debug_file, log::file& error_file,
     log::stream& output_stream, log::stream& error_stream);
@@ -63,6 +75,28 @@ void initialize(log::file& debug_file, log::file& error_file,
 void initialize(const rotable_file& debug_file, const rotable_file& error_file,
     log::stream& output_stream, log::stream& error_stream);
 
+/// Initializes asynchronous non-rotable libbitcoin logging sinks and formats.
+void initialize(log::file& debug_file, log::file& error_file,
+    log::stream& output_stream, log::stream& error_stream,
+    const asynchronous& buffer);
+
+/// Initializes asynchronous rotable libbitcoin logging sinks and formats.
+void initialize(const rotable_file& debug_file, const rotable_file& error_file,
+    log::stream& output_stream, log::stream& error_stream,
+    const asynchronous& buffer);
+
+/// Overflow counts summed over all initialized asynchronous sinks.
+overflows overflow_counts();
+
+/// Write and flush all buffered records, blocking until complete.
+/// Call before exit, as records buffered when a sink is destroyed are lost.
+void flush();
+
+/// Remove and stop all asynchronous sinks, writing their buffered records.
+/// Producers blocked on a full buffer are released first, dropping their
+/// records, so that shutdown does not wait on a stalled writer to free space.
+void stop();
+
 /// Log stream operator.
 formatter& operator<<(formatter& stream, severity level);
 
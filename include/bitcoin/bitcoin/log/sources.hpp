@@ -26,6 +26,7 @@
 #include <boost/log/sources/severity_channel_logger.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/log/attributes.hpp>
+#include <bitcoin/bitcoin/log/levels.hpp>
 #include <bitcoin/bitcoin/log/severity.hpp>
 
 namespace libbitcoin {
@@ -42,7 +43,25 @@ BOOST_LOG_INLINE_GLOBAL_LOGGER_INIT(source, severity_source)
     return logger;
 }
 
+// Records below this severity (as an integer) are compiled out. Release builds
+// omit debug records unless this is defined as zero.
+#ifndef BC_LOG_MINIMUM_SEVERITY
+    #ifdef NDEBUG
+        #define BC_LOG_MINIMUM_SEVERITY 1
+    #else
+        #define BC_LOG_MINIMUM_SEVERITY 0
+    #endif
+#endif
+
+#define BC_LOG_COMPILED(level) \
+    (static_cast<int>(bc::log::severity::level) >= BC_LOG_MINIMUM_SEVERITY)
+
+// The level checks precede construction of the record and its stream.
+// A loop (of at most one pass) rather than an if avoids a dangling else.
 #define BC_LOG_SEVERITY(id, level) \
+    for (auto bc_log_enabled = BC_LOG_COMPILED(level) && \
+        bc::log::levels::enabled(id, bc::log::severity::level); \
+        bc_log_enabled; bc_log_enabled = false) \
     BOOST_LOG_CHANNEL_SEV(bc::log::source::get(), id, bc::log::severity::level)
 
 #define LOG_DEBUG(module) BC_LOG_SEVERITY(module, debug)
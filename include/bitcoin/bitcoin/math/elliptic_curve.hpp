@@ -32,6 +32,8 @@ namespace libbitcoin {
 BC_CONSTEXPR size_t ec_secret_size = 32;
 typedef byte_array<ec_secret_size> ec_secret;
 
+typedef std::vector<ec_secret> secret_list;
+
 /// Compressed public key:
 BC_CONSTEXPR size_t ec_compressed_size = 33;
 typedef byte_array<ec_compressed_size> ec_compressed;
@@ -20,7 +20,9 @@
 #ifndef LIBBITCOIN_HASH_HPP
 #define LIBBITCOIN_HASH_HPP
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <boost/functional/hash_fwd.hpp>
@@ -164,6 +166,25 @@ BC_API long_hash sha512_hash(data_slice data);
  */
 BC_API long_hash hmac_sha512_hash(data_slice data, data_slice key);
 
+/**
+ * A hmac sha512 context which computes the inner and outer midstates of its
+ * key once, for repeated hashing under the same key (a bip32 chain code).
+ *
+ * hmac-sha512(data, key)
+ */
+class BC_API hmac_sha512_context
+{
+public:
+    hmac_sha512_context(data_slice key);
+    ~hmac_sha512_context();
+
+    long_hash hash(data_slice data) const;
+
+private:
+    // Opaque storage for the keyed hmac sha512 state.
+    std::array<uint64_t, 52> context_;
+};
+
 /**
  * Generate a pkcs5 pbkdf2 hmac sha512 hash. This hash function is used in
  * bip39 mnemonics.
@@ -173,6 +194,16 @@ BC_API long_hash hmac_sha512_hash(data_slice data, data_slice key);
 BC_API long_hash pkcs5_pbkdf2_hmac_sha512(data_slice passphrase,
     data_slice salt, size_t iterations);
 
+/**
+ * Generate pkcs5 pbkdf2 hmac sha512 hashes of many passphrases under one salt
+ * (bip39 seed recovery). Passphrases are hashed together in groups of lanes,
+ * which allows the compiler to vectorize the hashing across passphrases.
+ *
+ * pkcs5_pbkdf2_hmac_sha512(passphrase, salt, iterations) for each passphrase
+ */
+BC_API long_hash_list pkcs5_pbkdf2_hmac_sha512(const data_stack& passphrases,
+    data_slice salt, size_t iterations);
+
 /**
  * Generate a typical bitcoin hash. This is the most widely used
  * hash function in Bitcoin.
@@ -197,6 +228,41 @@ BC_API short_hash bitcoin_short_hash(data_slice data);
 BC_API data_chunk scrypt(data_slice data, data_slice salt, uint64_t N,
     uint32_t p, uint32_t r, size_t length);
 
+class threadpool;
+
+/**
+ * Reusable scrypt working memory for a fixed number of concurrent lanes.
+ * Each lane retains 128 * r * N bytes, so the lane count bounds both the
+ * parallelism over the scrypt p parameter and the memory held. Lanes are
+ * mixed on the threads of a caller's pool and on the calling thread.
+ * An arena is not thread safe.
+ */
+class BC_API scrypt_arena
+{
+public:
+    /// One lane, mixed on the calling thread.
+    scrypt_arena();
+
+    /// Up to lanes blocks mixed concurrently on the threads of the pool.
+    scrypt_arena(threadpool& pool, size_t lanes);
+
+    ~scrypt_arena();
+
+    /// The number of lanes mixed concurrently.
+    size_t lanes() const;
+
+    /// Generate a scrypt hash of specified length, as scrypt().
+    data_chunk hash(data_slice data, data_slice salt, uint64_t N,
+        uint32_t p, uint32_t r, size_t length);
+
+private:
+    void reserve(size_t words);
+    void mix(uint8_t* block, size_t lane, uint64_t N, uint32_t r);
+
+    threadpool* const pool_;
+    std::vector<std::vector<uint32_t>> memory_;
+};
+
 } // namespace libbitcoin
 
 // Extend std and boost namespaces with our hash wrappers.
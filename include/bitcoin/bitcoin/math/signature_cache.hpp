@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SIGNATURE_CACHE_HPP
+#define LIBBITCOIN_SIGNATURE_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+
+/**
+ * A thread safe, bounded cache of successful signature verifications, with
+ * an optional cache of parsed public keys. Entries are keyed by a salted
+ * digest of (sighash, signature, point), so keys cannot be precomputed by a
+ * peer. When full a random entry is evicted to make room for a new one.
+ */
+class BC_API signature_cache
+{
+public:
+    static const size_t default_signatures;
+    static const size_t default_points;
+
+    /// The process-wide cache consulted by script validation.
+    static signature_cache& instance();
+
+    /// Construct a cache of the given capacities (zero disables the cache).
+    signature_cache(size_t signatures=default_signatures,
+        size_t points=default_points);
+
+    /// Verify the signature, consulting and populating the caches.
+    bool verify(data_slice point, const hash_digest& hash,
+        const ec_signature& signature);
+
+    /// The verification is cached as successful.
+    bool contains(data_slice point, const hash_digest& hash,
+        const ec_signature& signature) const;
+
+    /// Cache the verification as successful.
+    void store(data_slice point, const hash_digest& hash,
+        const ec_signature& signature);
+
+    /// Empty both caches, retaining counters.
+    void clear();
+
+    size_t size() const;
+    uint64_t hits() const;
+    uint64_t misses() const;
+    uint64_t point_hits() const;
+    uint64_t point_misses() const;
+
+private:
+    // The opaque parsed form of a public key (secp256k1_pubkey).
+    typedef byte_array<64> parsed_point;
+
+    typedef std::unordered_set<hash_digest> signature_set;
+    typedef std::unordered_map<hash_digest, parsed_point> point_map;
+
+    hash_digest signature_key(data_slice point, const hash_digest& hash,
+        const ec_signature& signature) const;
+    hash_digest point_key(data_slice point) const;
+
+    void insert(const hash_digest& key);
+    bool parse(parsed_point& out, data_slice point);
+
+    const size_t signature_capacity_;
+    const size_t point_capacity_;
+    const hash_digest salt_;
+
+    // Keys are duplicated in order to select a random entry to evict.
+    signature_set signatures_;
+    hash_list signature_keys_;
+    point_map points_;
+    hash_list point_keys_;
+
+    std::atomic<uint64_t> hits_;
+    std::atomic<uint64_t> misses_;
+    std::atomic<uint64_t> point_hits_;
+    std::atomic<uint64_t> point_misses_;
+    mutable shared_mutex signature_mutex_;
+    mutable shared_mutex point_mutex_;
+};
+
+} // namespace libbitcoin
+
+#endif
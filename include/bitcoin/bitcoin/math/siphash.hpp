@@ -0,0 +1,57 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SIPHASH_HPP
+#define LIBBITCOIN_SIPHASH_HPP
+
+#include <cstdint>
+#include <utility>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+/// The two 64 bit words of a siphash key (k0, k1).
+typedef std::pair<uint64_t, uint64_t> siphash_key;
+
+/**
+ * Generate a siphash key from the first 16 bytes of a hash, with each word
+ * read as little endian. This is the key derivation used by bip152.
+ */
+BC_API siphash_key to_siphash_key(const half_hash& hash);
+
+/**
+ * Generate a SipHash-2-4 hash.
+ *
+ * siphash(key, message)
+ */
+BC_API uint64_t siphash(const siphash_key& key, data_slice message);
+
+/**
+ * Generate a SipHash-2-4 hash of a 32 byte message. This is equivalent to
+ * the general form, unrolled for the fixed message size of a hash digest.
+ *
+ * siphash(key, hash)
+ */
+BC_API uint64_t siphash(const siphash_key& key, const hash_digest& hash);
+
+} // namespace libbitcoin
+
+#endif
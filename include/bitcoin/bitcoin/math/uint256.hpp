@@ -27,17 +27,17 @@ public:
     }
 };
 
-/** Template base class for unsigned big integers. */
+/** Template base class for unsigned big integers, in 64 bit limbs. */
 template <unsigned int BITS>
 class BC_API base_uint
 {
 protected:
     enum 
     { 
-        WIDTH = BITS / 32
+        WIDTH = BITS / 64
     };
 
-    uint32_t pn[WIDTH];
+    uint64_t pn[WIDTH];
 
 public:
 
@@ -63,9 +63,8 @@ public:
 
     base_uint(uint64_t b)
     {
-        pn[0] = (unsigned int)b;
-        pn[1] = (unsigned int)(b >> 32);
-        for (int i = 2; i < WIDTH; i++)
+        pn[0] = b;
+        for (int i = 1; i < WIDTH; i++)
             pn[i] = 0;
     }
 
@@ -101,9 +100,8 @@ public:
 
     base_uint& operator=(uint64_t b)
     {
-        pn[0] = (unsigned int)b;
-        pn[1] = (unsigned int)(b >> 32);
-        for (int i = 2; i < WIDTH; i++)
+        pn[0] = b;
+        for (int i = 1; i < WIDTH; i++)
             pn[i] = 0;
 
         return *this;
@@ -135,15 +133,13 @@ public:
 
     base_uint& operator^=(uint64_t b)
     {
-        pn[0] ^= (unsigned int)b;
-        pn[1] ^= (unsigned int)(b >> 32);
+        pn[0] ^= b;
         return *this;
     }
 
     base_uint& operator|=(uint64_t b)
     {
-        pn[0] |= (unsigned int)b;
-        pn[1] |= (unsigned int)(b >> 32);
+        pn[0] |= b;
         return *this;
     }
 
@@ -152,12 +148,14 @@ public:
 
     base_uint& operator+=(const base_uint& b)
     {
+        // Carries are detected by wraparound, which compiles to add-carry.
         uint64_t carry = 0;
         for (int i = 0; i < WIDTH; i++)
         {
-            uint64_t n = carry + pn[i] + b.pn[i];
-            pn[i] = n & 0xffffffff;
-            carry = n >> 32;
+            const uint64_t n = pn[i] + carry;
+            carry = n < carry ? 1 : 0;
+            pn[i] = n + b.pn[i];
+            carry += pn[i] < n ? 1 : 0;
         }
 
         return *this;
@@ -165,7 +163,15 @@ public:
 
     base_uint& operator-=(const base_uint& b)
     {
-        *this += -b;
+        uint64_t borrow = 0;
+        for (int i = 0; i < WIDTH; i++)
+        {
+            const uint64_t n = pn[i] - borrow;
+            borrow = n > pn[i] ? 1 : 0;
+            pn[i] = n - b.pn[i];
+            borrow += pn[i] > n ? 1 : 0;
+        }
+
         return *this;
     }
 
@@ -181,7 +187,7 @@ public:
     {
         base_uint b;
         b = b64;
-        *this += -b;
+        *this -= b;
         return *this;
     }
 
@@ -211,7 +217,7 @@ public:
     {
         // prefix operator
         int i = 0;
-        while (--pn[i] == (uint32_t)-1 && i < WIDTH - 1)
+        while (--pn[i] == (uint64_t)-1 && i < WIDTH - 1)
             i++;
 
         return *this;
@@ -226,8 +232,28 @@ public:
         return ret;
     }
 
-    int CompareTo(const base_uint& b) const;
-    bool EqualTo(uint64_t b) const;
+    int CompareTo(const base_uint& b) const
+    {
+        for (int i = WIDTH - 1; i >= 0; i--)
+        {
+            if (pn[i] < b.pn[i])
+                return -1;
+
+            if (pn[i] > b.pn[i])
+                return 1;
+        }
+
+        return 0;
+    }
+
+    bool EqualTo(uint64_t b) const
+    {
+        for (int i = WIDTH - 1; i >= 1; i--)
+            if (pn[i] != 0)
+                return false;
+
+        return pn[0] == b;
+    }
 
     friend inline const base_uint operator+(const base_uint& a, const base_uint& b) { return base_uint(a) += b; }
     friend inline const base_uint operator-(const base_uint& a, const base_uint& b) { return base_uint(a) -= b; }
@@ -282,8 +308,7 @@ public:
 
     uint64_t GetLow64() const
     {
-        BITCOIN_ASSERT(WIDTH >= 2);
-        return pn[0] | (uint64_t)pn[1] << 32;
+        return pn[0];
     }
 };
 
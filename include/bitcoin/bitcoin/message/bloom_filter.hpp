@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_BLOOM_FILTER_HPP
+#define LIBBITCOIN_MESSAGE_BLOOM_FILTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/message/filter_add.hpp>
+#include <bitcoin/bitcoin/message/filter_load.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+/// A bip37 bloom filter, as loaded by a peer via filter_load and extended via
+/// filter_add. Matching transactions update the filter according to flags.
+class BC_API bloom_filter
+{
+public:
+    typedef std::vector<bloom_filter> list;
+
+    /// Transaction match flags, in the order of the matched transactions.
+    typedef std::vector<bool> matches;
+
+    enum update : uint8_t
+    {
+        /// Never update the filter with outpoints.
+        none = 0,
+
+        /// Add the outpoint of every output with a matching data element.
+        all = 1,
+
+        /// Add outpoints only for matching pay-to-key and multisig outputs.
+        pubkey_only = 2
+    };
+
+    /// Bip37 limits on filter size (bytes) and hash function count.
+    static const size_t max_filter_size;
+    static const uint32_t max_hash_functions;
+
+    /// Match each transaction against every filter. The filterable elements
+    /// of each transaction are extracted once and shared across filters.
+    /// The result contains one set of match flags for each filter.
+    static std::vector<matches> match(list& filters,
+        const chain::transaction::list& transactions);
+
+    bloom_filter();
+    bloom_filter(const filter_load& load);
+    bloom_filter(const data_chunk& filter, uint32_t hash_functions,
+        uint32_t tweak, uint8_t flags);
+    bloom_filter(data_chunk&& filter, uint32_t hash_functions,
+        uint32_t tweak, uint8_t flags);
+
+    const data_chunk& filter() const;
+    uint32_t hash_functions() const;
+    uint32_t tweak() const;
+    uint8_t flags() const;
+
+    /// The filter is within bip37 size and hash function limits.
+    bool is_valid() const;
+
+    /// Add an element to the filter.
+    void insert(data_slice element);
+
+    /// Add the element of a filter_add message to the filter.
+    void add(const filter_add& message);
+
+    /// The element may have been inserted (false positives are possible).
+    bool contains(data_slice element) const;
+
+    /// The transaction matches the filter, per bip37. Outpoints of matching
+    /// outputs are inserted into the filter as dictated by the update flags.
+    bool is_relevant(const chain::transaction& tx);
+
+private:
+    struct elements;
+
+    static void to_elements(elements& out, const chain::transaction& tx);
+    bool is_relevant(const elements& tx);
+
+    data_chunk filter_;
+    uint32_t hash_functions_;
+    uint32_t tweak_;
+    uint8_t flags_;
+};
+
+} // namespace message
+} // namespace libbitcoin
+
+#endif
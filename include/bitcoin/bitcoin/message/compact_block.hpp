@@ -23,6 +23,8 @@
 #include <istream>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
 #include <bitcoin/bitcoin/message/prefilled_transaction.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
@@ -47,6 +49,10 @@ public:
     static compact_block factory_from_data(uint32_t version,
         reader& source);
 
+    /// Compute the bip152 short id of a transaction hash under the key.
+    static short_id to_short_id(const siphash_key& key,
+        const hash_digest& hash);
+
     compact_block();
     compact_block(const chain::header& header, uint64_t nonce,
         const short_id_list& short_ids,
@@ -75,6 +81,9 @@ public:
     void set_transactions(const prefilled_transaction::list& value);
     void set_transactions(prefilled_transaction::list&& value);
 
+    /// The bip152 siphash key, sha256(header || nonce), truncated.
+    siphash_key short_id_key() const;
+
     bool from_data(uint32_t version, const data_chunk& data);
     bool from_data(uint32_t version, std::istream& stream);
     bool from_data(uint32_t version, reader& source);
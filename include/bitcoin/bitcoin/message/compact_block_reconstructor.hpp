@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_COMPACT_BLOCK_RECONSTRUCTOR_HPP
+#define LIBBITCOIN_MESSAGE_COMPACT_BLOCK_RECONSTRUCTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
+#include <bitcoin/bitcoin/message/block_message.hpp>
+#include <bitcoin/bitcoin/message/block_transactions.hpp>
+#include <bitcoin/bitcoin/message/compact_block.hpp>
+#include <bitcoin/bitcoin/message/get_block_transactions.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+/// Reconstructs a block from a bip152 compact block, a set of transactions
+/// already known to the caller and a block_transactions reply for the rest.
+/// Message indexes are differentially encoded, as on the wire.
+/// This class is not thread safe.
+class BC_API compact_block_reconstructor
+{
+public:
+    compact_block_reconstructor(const compact_block& block);
+
+    /// False if the prefilled indexes are invalid or the short ids collide,
+    /// in which case the full block should be requested instead.
+    bool is_valid() const;
+
+    /// True if every transaction of the block has been resolved.
+    bool is_complete() const;
+
+    /// Resolve short ids against known transactions (e.g. the memory pool),
+    /// returning the number of transactions newly resolved. A short id that
+    /// matches distinct transactions is left unresolved.
+    size_t match(const chain::transaction::list& known);
+
+    /// The request for all unresolved transactions.
+    get_block_transactions missing() const;
+
+    /// Resolve all remaining transactions from the reply, in order.
+    /// False, with no change, unless the reply has exactly that many.
+    bool fill(const block_transactions& reply);
+
+    /// Populate the block, false if incomplete or the merkle root mismatches.
+    bool to_block(block_message& out) const;
+
+private:
+    enum class slot_state : uint8_t
+    {
+        empty,
+        prefilled,
+        matched,
+        ambiguous
+    };
+
+    static uint64_t to_integer(const compact_block::short_id& id);
+
+    size_t resolved() const;
+    bool populate(const compact_block& block);
+    bool insert(uint64_t short_id, uint32_t slot);
+    bool find(uint64_t short_id, uint32_t& slot) const;
+
+    bool valid_;
+    chain::header header_;
+    siphash_key key_;
+    std::vector<chain::transaction> transactions_;
+    std::vector<slot_state> states_;
+
+    // Flat open-addressed table of short id to transaction slot.
+    std::vector<uint64_t> keys_;
+    std::vector<uint32_t> slots_;
+    size_t mask_;
+};
+
+} // namespace message
+} // namespace libbitcoin
+
+#endif
@@ -20,6 +20,7 @@
 #ifndef LIBBITCOIN_MESSAGE_HEADERS_HPP
 #define LIBBITCOIN_MESSAGE_HEADERS_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <istream>
@@ -63,6 +64,11 @@ public:
     void to_inventory(inventory_vector::list& out,
         inventory::type_id type) const;
 
+    /// Check proof of work, timestamp and linkage of the sequence of headers
+    /// in a single pass, returning the index of the first failure, or the
+    /// number of elements if all are valid.
+    size_t check_chain() const;
+
     bool from_data(uint32_t version, const data_chunk& data);
     bool from_data(uint32_t version, std::istream& stream);
     bool from_data(uint32_t version, reader& source);
@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_LAZY_BLOCK_MESSAGE_HPP
+#define LIBBITCOIN_MESSAGE_LAZY_BLOCK_MESSAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/message/block_message.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+/// A block message that retains its payload and defers transaction parsing.
+/// The header is parsed eagerly and transaction boundaries are indexed in a
+/// single scan, so that header, proof of work and existence checks can be
+/// performed before any transaction is materialized.
+class BC_API lazy_block_message
+{
+public:
+    typedef std::shared_ptr<lazy_block_message> ptr;
+    typedef std::shared_ptr<const lazy_block_message> const_ptr;
+
+    static lazy_block_message factory_from_data(uint32_t version,
+        const data_chunk& data);
+    static lazy_block_message factory_from_data(uint32_t version,
+        data_chunk&& data);
+
+    lazy_block_message();
+    lazy_block_message(const lazy_block_message& other);
+    lazy_block_message(lazy_block_message&& other);
+
+    bool from_data(uint32_t version, const data_chunk& data);
+    bool from_data(uint32_t version, data_chunk&& data);
+    data_chunk to_data(uint32_t version) const;
+    bool is_valid() const;
+    void reset();
+    uint64_t serialized_size(uint32_t version) const;
+
+    const chain::header& header() const;
+    hash_digest hash() const;
+
+    /// The number of transactions, known without parsing any of them.
+    size_t transaction_count() const;
+
+    /// Parse the transaction at the given position, invalid if out of range.
+    chain::transaction transaction_at(size_t index) const;
+
+    /// Parse all transactions into a fully-materialized block message.
+    block_message to_block_message() const;
+
+    // This class is move assignable but not copy assignable.
+    lazy_block_message& operator=(lazy_block_message&& other);
+    void operator=(const lazy_block_message&) = delete;
+
+    static const std::string command;
+    static const uint32_t version_minimum;
+    static const uint32_t version_maximum;
+
+private:
+    bool index_transactions();
+
+    data_chunk payload_;
+    chain::header header_;
+
+    // The payload offset of each transaction, followed by the payload end.
+    std::vector<size_t> offsets_;
+};
+
+} // namespace message
+} // namespace libbitcoin
+
+#endif
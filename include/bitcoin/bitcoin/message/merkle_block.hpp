@@ -23,7 +23,9 @@
 #include <istream>
 #include <memory>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/chain/block.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
@@ -50,6 +52,12 @@ public:
         const hash_list& hashes, const data_chunk& flags);
     merkle_block(chain::header&& header, uint32_t total_transactions,
         hash_list&& hashes, data_chunk&& flags);
+
+    /// Construct the bip37 partial merkle tree of the block, retaining the
+    /// transactions flagged in matches (one flag per block transaction).
+    /// The result is invalid if the number of matches differs.
+    merkle_block(const chain::block& block, const std::vector<bool>& matches);
+
     merkle_block(const merkle_block& other);
     merkle_block(merkle_block&& other);
 
@@ -71,6 +79,14 @@ public:
     void set_flags(const data_chunk& value);
     void set_flags(data_chunk&& value);
 
+    /// Validate the partial merkle tree against the header merkle root and
+    /// extract the matched transaction hashes with their block positions.
+    bool extract_matches(hash_list& out_hashes,
+        chain::block::indexes& out_positions) const;
+
+    /// The partial merkle tree is well formed and commits to the header.
+    bool is_valid_merkle_root() const;
+
     bool from_data(uint32_t version, const data_chunk& data);
     bool from_data(uint32_t version, std::istream& stream);
     bool from_data(uint32_t version, reader& source);
@@ -96,9 +112,6 @@ private:
     chain::header header_;
     uint32_t total_transactions_;
     hash_list hashes_;
-
-    // TODO: provide utility to compute this from the list of hashes based on
-    // the assumption that the hash list represents that of a complete block.
     data_chunk flags_;
 };
 
@@ -27,7 +27,9 @@
 #include <bitcoin/bitcoin/message/alert_payload.hpp>
 #include <bitcoin/bitcoin/message/block_message.hpp>
 #include <bitcoin/bitcoin/message/block_transactions.hpp>
+#include <bitcoin/bitcoin/message/bloom_filter.hpp>
 #include <bitcoin/bitcoin/message/compact_block.hpp>
+#include <bitcoin/bitcoin/message/compact_block_reconstructor.hpp>
 #include <bitcoin/bitcoin/message/fee_filter.hpp>
 #include <bitcoin/bitcoin/message/filter_add.hpp>
 #include <bitcoin/bitcoin/message/filter_clear.hpp>
@@ -41,6 +43,7 @@
 #include <bitcoin/bitcoin/message/heading.hpp>
 #include <bitcoin/bitcoin/message/inventory.hpp>
 #include <bitcoin/bitcoin/message/inventory_vector.hpp>
+#include <bitcoin/bitcoin/message/lazy_block_message.hpp>
 #include <bitcoin/bitcoin/message/memory_pool.hpp>
 #include <bitcoin/bitcoin/message/merkle_block.hpp>
 #include <bitcoin/bitcoin/message/network_address.hpp>
@@ -22,6 +22,7 @@
 
 #include <functional>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <bitcoin/bitcoin/define.hpp>
@@ -47,6 +48,11 @@ namespace libbitcoin {
 #define BIND_ELEMENT(args, element, call) \
     std::bind(args..., element, call)
 
+// The synchronizer is selectable, defaulting to the locking implementation.
+#define SYNCHRONIZE(handler, count, name, mode) \
+    Synchronizer<typename std::decay<Handler>::type>( \
+        FORWARD_HANDLER(handler), count, name, mode)
+
 /// This  class is thread safe.
 /// If the ios service is stopped jobs will not be dispatched.
 class BC_API dispatcher
@@ -136,53 +142,57 @@ public:
     }
 
     /// Executes multiple identical jobs concurrently until one completes.
-    template <typename Count, typename Handler, typename... Args>
+    template <template <typename> class Synchronizer=synchronizer,
+        typename Count, typename Handler, typename... Args>
     void race(Count count, const std::string& name, Handler&& handler,
         Args... args)
     {
         // The first fail will also terminate race and return the code.
         static const size_t clearance_count = 1;
-        const auto call = synchronize(FORWARD_HANDLER(handler),
-            clearance_count, name, false);
+        const auto call = SYNCHRONIZE(handler, clearance_count, name,
+            synchronizer_terminate::on_error);
 
         for (Count iteration = 0; iteration < count; ++iteration)
             concurrent(BIND_RACE(args, call));
     }
 
     /// Executes the job against each member of a collection concurrently.
-    template <typename Element, typename Handler, typename... Args>
+    template <template <typename> class Synchronizer=synchronizer,
+        typename Element, typename Handler, typename... Args>
     void parallel(const std::vector<Element>& collection,
         const std::string& name, Handler&& handler, Args... args)
     {
         // Failures are suppressed, success always returned to handler.
-        const auto call = synchronize(FORWARD_HANDLER(handler),
-            collection.size(), name, true);
+        const auto call = SYNCHRONIZE(handler, collection.size(), name,
+            synchronizer_terminate::on_count);
 
         for (const auto& element: collection)
             concurrent(BIND_ELEMENT(args, element, call));
     }
 
     /// Disperses the job against each member of a collection without order.
-    template <typename Element, typename Handler, typename... Args>
+    template <template <typename> class Synchronizer=synchronizer,
+        typename Element, typename Handler, typename... Args>
     void disperse(const std::vector<Element>& collection,
         const std::string& name, Handler&& handler, Args... args)
     {
         // Failures are suppressed, success always returned to handler.
-        const auto call = synchronize(FORWARD_HANDLER(handler),
-            collection.size(), name, true);
+        const auto call = SYNCHRONIZE(handler, collection.size(), name,
+            synchronizer_terminate::on_count);
 
         for (const auto& element: collection)
             unordered(BIND_ELEMENT(args, element, call));
     }
 
     /// Disperses the job against each member of a collection with order.
-    template <typename Element, typename Handler, typename... Args>
+    template <template <typename> class Synchronizer=synchronizer,
+        typename Element, typename Handler, typename... Args>
     void serialize(const std::vector<Element>& collection,
         const std::string& name, Handler&& handler, Args... args)
     {
         // Failures are suppressed, success always returned to handler.
-        const auto call = synchronize(FORWARD_HANDLER(handler),
-            collection.size(), name, true);
+        const auto call = SYNCHRONIZE(handler, collection.size(), name,
+            synchronizer_terminate::on_count);
 
         for (const auto& element: collection)
             ordered(BIND_ELEMENT(args, element, call));
@@ -200,6 +210,7 @@ private:
 #undef BIND_ARGS
 #undef BIND_RACE
 #undef BIND_ELEMENT
+#undef SYNCHRONIZE
 
 } // namespace libbitcoin
 
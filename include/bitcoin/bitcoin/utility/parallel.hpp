@@ -0,0 +1,188 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_PARALLEL_HPP
+#define LIBBITCOIN_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+/**
+ * Invoke handler(begin, end) over contiguous chunks of [0, count), each of at
+ * most grain elements, blocking until all chunks are complete. Chunks are
+ * claimed dynamically by the calling thread and by up to one task per pool
+ * thread, so uneven chunk costs are balanced. The caller waits only for tasks
+ * that have started, so this may be called from a thread of the pool, and
+ * completes on the calling thread alone if the pool is busy or stopped.
+ * A zero grain is treated as one. If the handler throws, no further chunks
+ * are started and the first exception is rethrown to the caller once all
+ * started tasks have stopped.
+ */
+template <typename Handler>
+void parallel_for(threadpool& pool, size_t count, size_t grain,
+    Handler handler)
+{
+    grain = std::max(grain, size_t(1));
+    const auto chunks = (count + grain - 1) / grain;
+    const auto helpers = chunks < 2 ? 0 : std::min(pool.size(), chunks - 1);
+
+    if (helpers == 0)
+    {
+        for (size_t begin = 0; begin < count; begin += grain)
+            handler(begin, std::min(begin + grain, count));
+
+        return;
+    }
+
+    // Tasks may run after return, so they share ownership of this state.
+    struct state
+    {
+        std::atomic<size_t> next;
+        size_t active;
+        std::exception_ptr failure;
+        boost::mutex mutex;
+        boost::condition_variable completed;
+    };
+
+    const auto shared = std::make_shared<state>();
+    shared->next = 0;
+    shared->active = 0;
+    const auto target = &handler;
+
+    // The handler is invoked only for a claimed chunk, so a task that starts
+    // once all chunks are claimed never dereferences it.
+    const auto run = [shared, target, chunks, grain, count]()
+        -> std::exception_ptr
+    {
+        try
+        {
+            for (auto chunk = shared->next++; chunk < chunks;
+                chunk = shared->next++)
+            {
+                const auto begin = chunk * grain;
+                (*target)(begin, std::min(begin + grain, count));
+            }
+        }
+        catch (...)
+        {
+            // Unclaimed chunks are abandoned by all tasks.
+            shared->next = chunks;
+            return std::current_exception();
+        }
+
+        return std::exception_ptr();
+    };
+
+    for (size_t task = 0; task < helpers; ++task)
+    {
+        pool.service().post([shared, run, chunks]()
+        {
+            // Critical Section
+            ///////////////////////////////////////////////////////////////////
+            {
+                boost::lock_guard<boost::mutex> lock(shared->mutex);
+
+                if (shared->next >= chunks)
+                    return;
+
+                ++shared->active;
+            }
+            ///////////////////////////////////////////////////////////////////
+
+            const auto error = run();
+
+            // Critical Section
+            ///////////////////////////////////////////////////////////////////
+            boost::lock_guard<boost::mutex> lock(shared->mutex);
+
+            if (error && !shared->failure)
+                shared->failure = error;
+
+            if (--shared->active == 0)
+                shared->completed.notify_one();
+            ///////////////////////////////////////////////////////////////////
+        });
+    }
+
+    auto failure = run();
+
+    // Once the caller has run out of chunks no further task can start.
+    boost::unique_lock<boost::mutex> lock(shared->mutex);
+    shared->completed.wait(lock, [&shared]()
+    {
+        return shared->active == 0;
+    });
+
+    if (!failure)
+        failure = shared->failure;
+
+    if (failure)
+        std::rethrow_exception(failure);
+}
+
+/**
+ * Invoke handler(begin, end) over contiguous parts of [0, count), one part
+ * per pool thread, blocking until all parts are complete.
+ */
+template <typename Handler>
+void parallel_for(threadpool& pool, size_t count, Handler handler)
+{
+    const auto parts = std::max(std::min(pool.size(), count), size_t(1));
+    parallel_for(pool, count, (count + parts - 1) / parts, handler);
+}
+
+/**
+ * Map each chunk of [0, count) to a partial result with map(begin, end) and
+ * combine the partials with reduce(left, right), starting from identity.
+ * Partials are combined in chunk order, so the result is deterministic for
+ * an associative reduction, even if it is not commutative. Value may not be
+ * bool, as partials are written concurrently to a vector.
+ */
+template <typename Value, typename Map, typename Reduce>
+Value parallel_reduce(threadpool& pool, size_t count, size_t grain,
+    Value identity, Map map, Reduce reduce)
+{
+    grain = std::max(grain, size_t(1));
+    std::vector<Value> partials((count + grain - 1) / grain, identity);
+
+    const auto chunk = [&](size_t begin, size_t end)
+    {
+        partials[begin / grain] = map(begin, end);
+    };
+
+    parallel_for(pool, count, grain, chunk);
+
+    for (auto& partial: partials)
+        identity = reduce(std::move(identity), std::move(partial));
+
+    return identity;
+}
+
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_PIPELINE_HPP
+#define LIBBITCOIN_PIPELINE_HPP
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+/// A bounded multi-stage pipeline over a threadpool, such as
+/// parse -> hash -> check -> connect. Each pushed item passes through the
+/// stages in the order they were added. Concurrent stages may process items
+/// in parallel, ordered stages process one item at a time in push order.
+/// Push blocks while capacity items are in flight, providing back-pressure.
+/// An item whose stage throws is skipped in all subsequent stages, and the
+/// first such exception is rethrown by wait.
+/// This class is thread safe, but stages must be added before the first push.
+template <typename Item>
+class pipeline
+{
+public:
+    /// Return false to skip the item in all subsequent stages.
+    typedef std::function<bool(Item&)> handler;
+
+    /// Construct an instance. A zero capacity is treated as one.
+    pipeline(threadpool& pool, size_t capacity);
+
+    /// Block until all pushed items are complete, discarding any exception.
+    ~pipeline();
+
+    /// This class is not copyable.
+    pipeline(const pipeline&) = delete;
+    void operator=(const pipeline&) = delete;
+
+    /// Append a stage that processes items concurrently.
+    void concurrent(handler stage);
+
+    /// Append a stage that processes one item at a time in push order.
+    void ordered(handler stage);
+
+    /// Submit an item, blocking while the pipeline is at capacity.
+    void push(Item item);
+
+    /// Block until all pushed items are complete, then rethrow (and clear)
+    /// the first exception thrown by a stage since the last wait, if any.
+    void wait();
+
+private:
+    struct token
+    {
+        const size_t sequence;
+        Item item;
+        bool live;
+    };
+
+    typedef std::shared_ptr<token> token_ptr;
+
+    struct stage
+    {
+        const handler handle;
+        const bool ordered;
+
+        // Ordered stage state, out of sequence jobs are parked here.
+        boost::mutex mutex;
+        size_t next;
+        std::map<size_t, token_ptr> pending;
+    };
+
+    void add(handler handle, bool ordered);
+    void join();
+    bool invoke(stage& stage, Item& item);
+    void run(token_ptr job, size_t index);
+    void post(token_ptr job, size_t index);
+    void complete();
+
+    threadpool& pool_;
+    const size_t capacity_;
+    std::vector<std::unique_ptr<stage>> stages_;
+
+    // These are protected by mutex.
+    size_t sequence_;
+    size_t in_flight_;
+    std::exception_ptr failure_;
+    boost::mutex mutex_;
+    boost::condition_variable changed_;
+};
+
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/utility/pipeline.ipp>
+
+#endif
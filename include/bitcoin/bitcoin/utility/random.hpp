@@ -45,6 +45,14 @@ BC_API uint64_t pseudo_random(uint64_t begin, uint64_t end);
  */
 BC_API void pseudo_random_fill(data_chunk& chunk);
 
+/**
+ * Fill a buffer from the cryptographically secure random source of the
+ * operating system, for secrets that must not be predictable.
+ * @param[in]  chunk  The buffer to fill with randomness.
+ * @throws std::exception if the source is unavailable.
+ */
+BC_API void secure_random_fill(data_chunk& chunk);
+
 /**
  * Convert a time duration to a value in the range [max/ratio, max].
  * @param[in]  maximum  The maximum value to return.
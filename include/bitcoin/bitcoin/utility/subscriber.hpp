@@ -20,10 +20,11 @@
 #ifndef  LIBBITCOIN_SUBSCRIBER_HPP
 #define  LIBBITCOIN_SUBSCRIBER_HPP
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
-#include <vector>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/dispatcher.hpp>
 #include <bitcoin/bitcoin/utility/enable_shared_from_base.hpp>
@@ -61,15 +62,24 @@ public:
     void relay(Args... args);
 
 private:
-    typedef std::vector<handler> list;
+    // Subscriptions are an intrusive stack, most recent at the top.
+    struct subscription
+    {
+        handler notify;
+        subscription* next;
+    };
 
+    // The low bit of the (aligned) stack top is the stopped flag.
+    enum : uintptr_t { stopped = 1 };
+
+    static subscription* to_subscription(uintptr_t top);
+    static void clear(subscription* item);
+    subscription* take();
     void do_invoke(Args... args);
 
-    bool stopped_;
-    list subscriptions_;
+    std::atomic<uintptr_t> top_;
     dispatcher dispatch_;
     mutable upgrade_mutex invoke_mutex_;
-    mutable upgrade_mutex subscribe_mutex_;
 };
 
 } // namespace libbitcoin
@@ -20,6 +20,7 @@
 #ifndef LIBBITCOIN_SYNCHRONIZER_HPP
 #define LIBBITCOIN_SYNCHRONIZER_HPP
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
 #include <stdexcept>
@@ -42,7 +43,11 @@ enum class synchronizer_terminate
 
     /// Terminate on count only.
     /// Return success once count is reached (always).
-    on_count
+    on_count,
+
+    /// Terminate on count only.
+    /// Return first error once count is reached, otherwise success.
+    on_count_first_error
 };
 
 template <typename Handler>
@@ -54,9 +59,10 @@ public:
       : handler_(handler),
         name_(name),
         clearance_count_(clearance_count),
+        terminate_(mode),
         counter_(std::make_shared<size_t>(0)),
-        mutex_(std::make_shared<upgrade_mutex>()),
-        terminate_(mode)
+        first_error_(std::make_shared<code>(error::success)),
+        mutex_(std::make_shared<upgrade_mutex>())
     {
     }
 
@@ -72,6 +78,7 @@ public:
                 return !ec;
 
             case synchronizer_terminate::on_count:
+            case synchronizer_terminate::on_count_first_error:
                 return false;
 
             default:
@@ -93,6 +100,9 @@ public:
             case synchronizer_terminate::on_count:
                 return error::success;
 
+            case synchronizer_terminate::on_count_first_error:
+                return *first_error_;
+
             default:
                 throw std::invalid_argument("mode");
         }
@@ -122,11 +132,16 @@ public:
         //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
         mutex_->unlock_upgrade_and_lock();
         (*counter_) = count;
+
+        if (ec && !(*first_error_))
+            (*first_error_) = ec;
+
+        const auto outcome = cleared ? result(ec) : error::success;
         mutex_->unlock();
         ///////////////////////////////////////////////////////////////////////
 
         if (cleared)
-            handler_(result(ec), std::forward<Args>(args)...);
+            handler_(outcome, std::forward<Args>(args)...);
     }
 
 private:
@@ -137,9 +152,128 @@ private:
 
     // We use pointer to reference the same value/mutex across instance copies.
     std::shared_ptr<size_t> counter_;
+    std::shared_ptr<code> first_error_;
     std::shared_ptr<upgrade_mutex> mutex_;
 };
 
+/// A synchronizer with the same interface and termination modes as
+/// synchronizer, using a single allocation and no mutex. Each completion is
+/// one atomic decrement of the remaining count, and a terminating code clears
+/// the count with one exchange. This class is thread safe.
+template <typename Handler>
+class atomic_synchronizer
+{
+public:
+    atomic_synchronizer(Handler handler, size_t clearance_count,
+        const std::string& name, synchronizer_terminate mode)
+      : state_(std::make_shared<state>(handler, clearance_count, name, mode))
+    {
+    }
+
+    template <typename... Args>
+    void operator()(const code& ec, Args&&... args)
+    {
+        auto& state = *state_;
+        const auto retain = state.terminate ==
+            synchronizer_terminate::on_count_first_error;
+
+        // Only the first error is retained, the flag serializes its write.
+        // The write is published to the clearing call by the decrement below.
+        if (ec && retain &&
+            !state.failed.exchange(true, std::memory_order_relaxed))
+            state.first_error = ec;
+
+        if (complete(state.terminate, ec))
+        {
+            // Another handler cleared this and shortcircuited the count.
+            if (state.remaining.exchange(0, std::memory_order_acq_rel) == 0)
+                return;
+
+            state.handler(result(state, ec), std::forward<Args>(args)...);
+            return;
+        }
+
+        auto remaining = state.remaining.load(std::memory_order_relaxed);
+
+        // Decrement unless cleared, fetch_sub could underflow a cleared count.
+        do
+        {
+            if (remaining == 0)
+                return;
+
+        } while (!state.remaining.compare_exchange_weak(remaining,
+            remaining - 1, std::memory_order_acq_rel,
+            std::memory_order_relaxed));
+
+        if (remaining == 1)
+            state.handler(result(state, ec), std::forward<Args>(args)...);
+    }
+
+private:
+    // The handler and counters share the one allocation across copies.
+    struct state
+    {
+        state(Handler handler, size_t clearance_count,
+            const std::string& name, synchronizer_terminate mode)
+          : handler(handler), name(name), terminate(mode),
+            remaining(clearance_count), failed(false)
+        {
+        }
+
+        Handler handler;
+        const std::string name;
+        const synchronizer_terminate terminate;
+        std::atomic<size_t> remaining;
+        std::atomic<bool> failed;
+        code first_error;
+    };
+
+    // Determine if the code is cause for termination.
+    static bool complete(synchronizer_terminate mode, const code& ec)
+    {
+        switch (mode)
+        {
+            case synchronizer_terminate::on_error:
+                return !!ec;
+
+            case synchronizer_terminate::on_success:
+                return !ec;
+
+            case synchronizer_terminate::on_count:
+            case synchronizer_terminate::on_count_first_error:
+                return false;
+
+            default:
+                throw std::invalid_argument("mode");
+        }
+    }
+
+    // Assuming we are terminating, generate the proper result code.
+    static code result(const state& state, const code& ec)
+    {
+        switch (state.terminate)
+        {
+            case synchronizer_terminate::on_error:
+                return ec ? ec : error::success;
+
+            case synchronizer_terminate::on_success:
+                return !ec ? ec : error::operation_failed;
+
+            case synchronizer_terminate::on_count:
+                return error::success;
+
+            case synchronizer_terminate::on_count_first_error:
+                return state.failed.load(std::memory_order_relaxed) ?
+                    state.first_error : error::success;
+
+            default:
+                throw std::invalid_argument("mode");
+        }
+    }
+
+    std::shared_ptr<state> state_;
+};
+
 template <typename Handler>
 synchronizer<Handler> synchronize(Handler handler, size_t clearance_count,
     const std::string& name, synchronizer_terminate mode=
@@ -148,6 +282,14 @@ synchronizer<Handler> synchronize(Handler handler, size_t clearance_count,
     return synchronizer<Handler>(handler, clearance_count, name, mode);
 }
 
+template <typename Handler>
+atomic_synchronizer<Handler> synchronize_atomic(Handler handler,
+    size_t clearance_count, const std::string& name,
+    synchronizer_terminate mode=synchronizer_terminate::on_error)
+{
+    return atomic_synchronizer<Handler>(handler, clearance_count, name, mode);
+}
+
 } // namespace libbitcoin
 
 #endif
@@ -20,7 +20,10 @@
 #ifndef LIBBITCOIN_THREAD_HPP
 #define LIBBITCOIN_THREAD_HPP
 
+#include <cstddef>
 #include <memory>
+#include <string>
+#include <vector>
 #include <boost/thread.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 
@@ -53,8 +56,25 @@ typedef boost::upgrade_mutex upgrade_mutex;
 typedef boost::unique_lock<shared_mutex> unique_lock;
 typedef boost::shared_lock<shared_mutex> shared_lock;
 
+/// Logical processor indexes, an empty set implies no constraint.
+typedef std::vector<size_t> processor_set;
+
 BC_API void set_thread_priority(thread_priority priority);
 
+/// Restrict the current thread to the processors, false if not applied.
+/// An empty set succeeds without change.
+BC_API bool set_thread_affinity(const processor_set& processors);
+
+/// Name the current thread for debuggers and profilers. Names may be
+/// truncated to the platform limit (15 characters on linux).
+BC_API void set_thread_name(const std::string& name);
+
+/// Parse a processor list such as "0-3,8,10-11", empty if invalid.
+BC_API processor_set parse_processors(const std::string& list);
+
+/// The processors of the NUMA node, empty if unknown or not supported.
+BC_API processor_set numa_processors(size_t node);
+
 } // namespace libbitcoin
 
 #endif
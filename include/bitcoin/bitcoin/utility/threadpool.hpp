@@ -23,6 +23,7 @@
 #include <cstddef>
 #include <memory>
 #include <functional>
+#include <string>
 #include <thread>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/utility/asio.hpp>
@@ -30,6 +31,21 @@
 
 namespace libbitcoin {
 
+/// Naming and processor placement of the threads of a threadpool.
+/// For NUMA placement set processors from numa_processors(node), so that
+/// memory first touched by the pool threads is allocated on that node.
+struct BC_API thread_placement
+{
+    /// Threads are named "<name>-<index>", unnamed if empty.
+    std::string name;
+
+    /// Threads are restricted to these processors, unrestricted if empty.
+    processor_set processors;
+
+    /// Pin each thread to a single processor of the set, round robin.
+    bool pin;
+};
+
 /**
  * This class and the asio service it exposes are thread safe.
  * A collection of threads which can be passed operations through io_service.
@@ -46,6 +62,15 @@ public:
      threadpool(size_t number_threads=0, 
         thread_priority priority=thread_priority::normal);
 
+    /**
+     * Threadpool constructor, spawns the specified number of placed threads.
+     * @param[in]   number_threads  Number of threads to spawn.
+     * @param[in]   priority        Priority of threads to spawn.
+     * @param[in]   placement       Naming and processors of threads.
+     */
+    threadpool(size_t number_threads, thread_priority priority,
+        const thread_placement& placement);
+
     ~threadpool();
 
     threadpool(const threadpool&) = delete;
@@ -69,6 +94,16 @@ public:
     void spawn(size_t number_threads=1, 
         thread_priority priority=thread_priority::normal);
 
+    /**
+     * Add the specified number of placed threads to this threadpool.
+     * Placement failures are not fatal, the thread runs unconstrained.
+     * @param[in]   number_threads  Number of threads to add.
+     * @param[in]   priority        Priority of threads to add.
+     * @param[in]   placement       Naming and processors of threads to add.
+     */
+    void spawn(size_t number_threads, thread_priority priority,
+        const thread_placement& placement);
+
     /**
      * Abandon outstanding operations without dispatching handlers.
      * Terminate threads once work is complete.
@@ -108,7 +143,8 @@ public:
     const asio::service& service() const;
 
 private:
-    void spawn_once(thread_priority priority=thread_priority::normal);
+    void spawn_once(thread_priority priority,
+        const thread_placement& placement);
 
     // This is thread safe.
     asio::service service_;
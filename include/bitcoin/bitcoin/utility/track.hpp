@@ -30,18 +30,24 @@
 #define CONSTRUCT_TRACK(class_name) \
     track<class_name>(#class_name)
 
+/// Instance tracking for debug builds. In release builds this is an empty
+/// base with inline no-op construction and destruction, so it has no cost.
 template <class Shared>
 class track
 {
 public:
+    /// The number of live instances, maintained in debug builds only.
     static std::atomic<size_t> instances;
 
 protected:
+    track(const char* class_name);
     track(const std::string& class_name);
     ~track();
 
 private:
+#ifndef NDEBUG
     const std::string class_;
+#endif
 };
 
 #include <bitcoin/bitcoin/impl/utility/track.ipp>
@@ -20,12 +20,15 @@
 #ifndef LIBBITCOIN_ENCRYPTED_KEYS_HPP
 #define LIBBITCOIN_ENCRYPTED_KEYS_HPP
 
+#include <cstddef>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/crypto.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/wallet/payment_address.hpp>
 
 namespace libbitcoin {
@@ -68,6 +71,7 @@ typedef byte_array<encrypted_token_decoded_size> encrypted_token;
 static BC_CONSTEXPR size_t ek_private_encoded_size = 58;
 static BC_CONSTEXPR size_t ek_private_decoded_size = 43;
 typedef byte_array<ek_private_decoded_size> encrypted_private;
+typedef std::vector<encrypted_private> encrypted_private_list;
 
 /**
  * DEPRECATED
@@ -192,6 +196,56 @@ BC_API bool decrypt(ec_compressed& out_point, uint8_t& out_version,
     bool& out_compressed, const encrypted_public& key,
     const std::string& passphrase);
 
+/**
+ * Encrypt a batch of ec secrets under a single passphrase.
+ * The passphrase is normalized once and scrypt memory is reused across keys.
+ * @param[out] out_private  The new encrypted private keys, in secret order.
+ * @param[in]  secrets      The ec secrets to encrypt.
+ * @param[in]  passphrase   A passphrase for use in the encryption.
+ * @param[in]  version      The coin address version byte.
+ * @param[in]  compressed   Set true to associate ec public key compression.
+ * @return false if any secret could not be converted to a public key.
+ */
+BC_API bool encrypt(encrypted_private_list& out_private,
+    const secret_list& secrets, const std::string& passphrase,
+    uint8_t version, bool compressed=true);
+
+/**
+ * Encrypt a batch of ec secrets as above, mixing each scrypt on the pool.
+ * Each lane holds 16MB. The calling thread also mixes lanes.
+ * @param[in]  pool   The threadpool on which to mix scrypt lanes.
+ * @param[in]  lanes  The number of scrypt lanes to mix concurrently.
+ */
+BC_API bool encrypt(encrypted_private_list& out_private,
+    const secret_list& secrets, const std::string& passphrase,
+    uint8_t version, bool compressed, threadpool& pool, size_t lanes);
+
+/**
+ * Decrypt a batch of encrypted private keys under a single passphrase.
+ * The passphrase is normalized once, scrypt memory is reused across keys and
+ * the passfactor is computed once per owner salt of ec multiplied keys.
+ * @param[out] out_secrets     The decrypted ec secrets, in key order.
+ * @param[out] out_versions    The coin address versions, in key order.
+ * @param[out] out_compressed  The compression of the ec public keys.
+ * @param[in]  keys            The encrypted private keys.
+ * @param[in]  passphrase      The passphrase from the encryption or token.
+ * @return false if any key checksum or the passphrase is not valid.
+ */
+BC_API bool decrypt(secret_list& out_secrets, data_chunk& out_versions,
+    std::vector<bool>& out_compressed, const encrypted_private_list& keys,
+    const std::string& passphrase);
+
+/**
+ * Decrypt a batch of encrypted private keys as above, mixing each scrypt on
+ * the pool. Each lane holds 16MB. This must not be called from a thread of
+ * the pool.
+ * @param[in]  pool   The threadpool on which to mix scrypt lanes.
+ * @param[in]  lanes  The number of scrypt lanes to mix concurrently.
+ */
+BC_API bool decrypt(secret_list& out_secrets, data_chunk& out_versions,
+    std::vector<bool>& out_compressed, const encrypted_private_list& keys,
+    const std::string& passphrase, threadpool& pool, size_t lanes);
+
 #endif // WITH_ICU
 
 } // namespace wallet
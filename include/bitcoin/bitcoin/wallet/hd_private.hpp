@@ -20,11 +20,14 @@
 #ifndef LIBBITCOIN_WALLET_HD_PRIVATE_KEY_HPP
 #define LIBBITCOIN_WALLET_HD_PRIVATE_KEY_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/wallet/ec_private.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
 #include <bitcoin/bitcoin/wallet/hd_public.hpp>
@@ -37,6 +40,8 @@ class BC_API hd_private
   : public hd_public
 {
 public:
+    typedef std::vector<hd_private> list;
+
     static const uint64_t mainnet;
     static const uint64_t testnet;
 
@@ -86,6 +91,14 @@ public:
     hd_private derive_private(uint32_t index) const;
     hd_public derive_public(uint32_t index) const;
 
+    /// Derive the children [first, first + count), in order. Children that
+    /// cannot be derived are invalid.
+    list derive_range(uint32_t first, uint32_t count) const;
+
+    /// As above, with the range divided across the threads of the pool.
+    /// This blocks until complete, deriving on the calling thread as well.
+    list derive_range(uint32_t first, uint32_t count, threadpool& pool) const;
+
 private:
     /// Factories.
     static hd_private from_seed(data_slice seed, uint64_t prefixes);
@@ -101,6 +114,11 @@ private:
     hd_private(const ec_secret& secret, const hd_chain_code& chain_code,
         const hd_lineage& lineage);
 
+    hd_key_payload to_payload() const;
+
+    void derive_part(list& out, uint32_t first, size_t begin,
+        size_t end) const;
+
     /// Members.
     /// This should be const, apart from the need to implement assignment.
     ec_secret secret_;
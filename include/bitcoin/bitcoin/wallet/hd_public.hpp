@@ -20,11 +20,14 @@
 #ifndef LIBBITCOIN_WALLET_HD_PUBLIC_KEY_HPP
 #define LIBBITCOIN_WALLET_HD_PUBLIC_KEY_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
 
 namespace libbitcoin {
@@ -41,6 +44,10 @@ typedef byte_array<hd_chain_code_size> hd_chain_code;
 static BC_CONSTEXPR size_t hd_key_size = 82;
 typedef byte_array<hd_key_size> hd_key;
 
+/// A decoded hd key without its four byte checksum.
+static BC_CONSTEXPR size_t hd_key_payload_size = hd_key_size - 4;
+typedef byte_array<hd_key_payload_size> hd_key_payload;
+
 /// Key derivation information used in the serialization format.
 struct BC_API hd_lineage
 {
@@ -59,6 +66,8 @@ class hd_private;
 class BC_API hd_public
 {
 public:
+    typedef std::vector<hd_public> list;
+
     static const uint32_t mainnet;
     static const uint32_t testnet;
 
@@ -100,6 +109,14 @@ public:
     hd_key to_hd_key() const;
     hd_public derive_public(uint32_t index) const;
 
+    /// Derive the children [first, first + count), in order. Children that
+    /// cannot be derived (including hardened children) are invalid.
+    list derive_range(uint32_t first, uint32_t count) const;
+
+    /// As above, with the range divided across the threads of the pool.
+    /// This blocks until complete, deriving on the calling thread as well.
+    list derive_range(uint32_t first, uint32_t count, threadpool& pool) const;
+
 protected:
     /// Factories.
     static hd_public from_secret(const ec_secret& secret,
@@ -123,6 +140,11 @@ private:
 
     hd_public(const ec_compressed& point,
         const hd_chain_code& chain_code, const hd_lineage& lineage);
+
+    hd_key_payload to_payload() const;
+
+    void derive_part(list& out, uint32_t first, size_t begin,
+        size_t end) const;
 };
 
 } // namespace wallet
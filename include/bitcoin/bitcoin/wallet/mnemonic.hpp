@@ -71,6 +71,19 @@ BC_API bool validate_mnemonic(const word_list& mnemonic,
 BC_API bool validate_mnemonic(const word_list& mnemonic,
     const dictionary_list& lexicons=language::all);
 
+/**
+ * Detect the language of a mnemonic and decode the entropy it encodes,
+ * resolving each word against all of the dictionaries in a single pass.
+ * @param[out] out_entropy  The entropy from which the mnemonic was created.
+ * @param[out] out_lexicon  The first dictionary in which the mnemonic is valid.
+ * @param[in]  mnemonic     The mnemonic to decode.
+ * @param[in]  lexicons     The candidate dictionaries, in order of preference.
+ * @return false if the mnemonic is not valid in any of the dictionaries.
+ */
+BC_API bool decode_entropy(data_chunk& out_entropy,
+    const dictionary*& out_lexicon, const word_list& mnemonic,
+    const dictionary_list& lexicons=language::all);
+
 /**
  * Convert a mnemonic with no passphrase to a wallet-generation seed.
  */
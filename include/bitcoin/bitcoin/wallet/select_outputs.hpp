@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/chain/output_point.hpp>
+#include <bitcoin/bitcoin/wallet/unspent_index.hpp>
 
 namespace libbitcoin {
 namespace wallet {
@@ -31,7 +32,20 @@ struct BC_API select_outputs
 {
     enum class algorithm
     {
-        greedy
+        /// The smallest single output that covers the value, otherwise the
+        /// largest outputs of lesser value.
+        greedy,
+
+        /// The largest outputs, fewest inputs.
+        largest_first,
+
+        /// An exact match, or one with excess not exceeding the cost of
+        /// change, found by depth first search, otherwise nothing.
+        branch_and_bound,
+
+        /// The smaller of the least excess random subset of lesser outputs
+        /// and the smallest single output that covers the value.
+        knapsack
     };
 
     /// Select optimal outpoints for a spend from unspent outputs list.
@@ -39,6 +53,24 @@ struct BC_API select_outputs
     static void select(chain::points_info& out,
         chain::output_info::list unspent, uint64_t minimum_value,
         algorithm option=algorithm::greedy);
+
+    /// Select optimal outpoints for a spend from an unspent outputs index.
+    /// Return includes the amount of change remaining from the spend, which
+    /// for branch and bound does not exceed the cost of change.
+    static void select(chain::points_info& out, const unspent_index& unspent,
+        uint64_t minimum_value, algorithm option=algorithm::greedy,
+        uint64_t cost_of_change=0);
+
+private:
+    static void greedy(chain::points_info& out, const unspent_index& unspent,
+        uint64_t minimum_value);
+    static void largest_first(chain::points_info& out,
+        const unspent_index& unspent, uint64_t minimum_value);
+    static void branch_and_bound(chain::points_info& out,
+        const unspent_index& unspent, uint64_t minimum_value,
+        uint64_t cost_of_change);
+    static void knapsack(chain::points_info& out,
+        const unspent_index& unspent, uint64_t minimum_value);
 };
 
 } // namespace wallet
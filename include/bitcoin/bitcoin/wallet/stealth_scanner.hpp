@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_WALLET_STEALTH_SCANNER_HPP
+#define LIBBITCOIN_WALLET_STEALTH_SCANNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+#include <bitcoin/bitcoin/wallet/stealth_address.hpp>
+
+namespace libbitcoin {
+namespace wallet {
+
+/// Scans transactions for stealth payments to a set of watched addresses.
+/// Stealth outputs are prefiltered against a bit trie of the address filters,
+/// so a shared secret is only computed for an address whose filter matches.
+/// Payments are recognized as pay-key-hash outputs of the same transaction.
+/// Watching addresses is thread safe with respect to scanning.
+class BC_API stealth_scanner
+{
+public:
+    /// A payment to a watched address.
+    struct match
+    {
+        /// The position of the address in the order in which it was watched.
+        size_t address;
+
+        ec_compressed stealth_public_key;
+        ec_compressed ephemeral_public_key;
+        hash_digest transaction_hash;
+        uint32_t output_index;
+    };
+
+    typedef std::function<void(const match&)> match_handler;
+
+    stealth_scanner();
+
+    /// Watch an address for payments to its first spend key.
+    /// False if the scan secret is not that of the scan key, if there is no
+    /// spend key, or if the filter exceeds the 32 bit stealth prefix.
+    bool watch(const stealth_address& address, const ec_secret& scan_secret);
+
+    /// The number of watched addresses.
+    size_t size() const;
+
+    /// Invoke the handler for each payment, in transaction order.
+    /// The handler is invoked once the scan is complete and without the lock,
+    /// so it may watch an address, which applies to subsequent scans.
+    void scan(const chain::transaction::list& transactions,
+        match_handler handler) const;
+
+    /// Invoke the handler for each payment, in transaction order, computing
+    /// shared secrets on the pool and the calling thread.
+    void scan(const chain::transaction::list& transactions, threadpool& pool,
+        match_handler handler) const;
+
+private:
+    struct entry
+    {
+        ec_secret scan_secret;
+        ec_compressed spend_key;
+    };
+
+    // A child index of zero is empty, as the root is never a child.
+    struct node
+    {
+        uint32_t children[2];
+        std::vector<uint32_t> entries;
+    };
+
+    struct candidate
+    {
+        size_t transaction;
+        size_t entry;
+        ec_compressed ephemeral_public_key;
+    };
+
+    typedef std::vector<match> matches;
+    typedef std::vector<candidate> candidates;
+    typedef std::function<void(size_t, size_t)> range_handler;
+    typedef std::function<void(size_t, const range_handler&)> partitioner;
+
+    void find(std::vector<uint32_t>& out_entries, uint32_t prefix) const;
+    void scan(const chain::transaction::list& transactions,
+        const partitioner& range, match_handler handler) const;
+    void collect(matches& out, const chain::transaction::list& transactions,
+        const partitioner& range) const;
+
+    std::vector<entry> entries_;
+    std::vector<node> nodes_;
+    mutable shared_mutex mutex_;
+};
+
+} // namespace wallet
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_WALLET_UNSPENT_INDEX_HPP
+#define LIBBITCOIN_WALLET_UNSPENT_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <bitcoin/bitcoin/chain/output_point.hpp>
+#include <bitcoin/bitcoin/chain/point.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+
+namespace libbitcoin {
+namespace wallet {
+
+/// A value ordered index of unspent outputs for output selection.
+/// The index is maintained incrementally as outputs are received and spent,
+/// so that selection does not copy or sort the unspent set on each spend.
+/// This class is not thread safe.
+class BC_API unspent_index
+{
+public:
+    typedef std::multimap<uint64_t, chain::output_point> values;
+    typedef values::const_iterator iterator;
+    typedef values::const_reverse_iterator reverse_iterator;
+
+    unspent_index();
+    unspent_index(const chain::output_info::list& unspent);
+
+    /// Moves retain the point iterators, as map nodes are not relocated.
+    unspent_index(unspent_index&& other);
+    unspent_index& operator=(unspent_index&& other);
+
+    /// The point index refers into the value index, so copies are disallowed.
+    unspent_index(const unspent_index&) = delete;
+    void operator=(const unspent_index&) = delete;
+
+    /// Add an unspent output, false if the point is already indexed.
+    bool add(const chain::output_info& unspent);
+
+    /// Remove a spent output, false if the point is not indexed.
+    bool remove(const chain::point& spent);
+
+    void clear();
+    bool empty() const;
+    size_t size() const;
+
+    /// The sum of indexed values, saturating at max_uint64.
+    uint64_t total() const;
+
+    /// The indexed outputs in ascending order of value.
+    const values& by_value() const;
+
+private:
+    typedef std::unordered_map<chain::point, iterator> points;
+
+    values values_;
+    points points_;
+    uint64_t total_;
+};
+
+} // namespace wallet
+} // namespace libbitcoin
+
+#endif
@@ -24,6 +24,7 @@
 #include <cstdint>
 #include <bitcoin/bitcoin/unicode/unicode.hpp>
 #include <bitcoin/bitcoin/chain/chain_state.hpp>
+#include <bitcoin/bitcoin/chain/header.hpp>
 #include <bitcoin/bitcoin/chain/script/opcode.hpp>
 #include <bitcoin/bitcoin/chain/script/script.hpp>
 #include <bitcoin/bitcoin/config/checkpoint.hpp>
@@ -49,6 +50,21 @@ inline size_t version_sample_size(bool testnet)
     return testnet ? testnet_sample : mainnet_sample;
 }
 
+inline size_t version_sample_capacity(bool enabled, bool testnet)
+{
+    return enabled ? version_sample_size(testnet) : 1;
+}
+
+inline size_t bits_capacity(bool testnet)
+{
+    return testnet ? retargeting_interval : 1;
+}
+
+inline size_t retarget_height(size_t height)
+{
+    return height - (height % retargeting_interval);
+}
+
 inline bool is_active(size_t count, bool testnet)
 {
     return count >= (testnet ? testnet_active : mainnet_active);
@@ -77,24 +93,62 @@ inline uint32_t bits_high(const chain_state::data& values)
     return values.bits.ordered.back();
 }
 
+// Copy the ordered values, sliding in the value and dropping from the front.
+inline std::vector<uint32_t> slide(const std::vector<uint32_t>& values,
+    uint32_t value, size_t capacity)
+{
+    const auto drop = values.size() < capacity ? 0 : 1;
+    std::vector<uint32_t> out;
+    out.reserve(values.size() - drop + 1);
+    out.insert(out.end(), values.begin() + drop, values.end());
+    out.push_back(value);
+    return out;
+}
+
 // Statics.
 //-----------------------------------------------------------------------------
 // non-public
 
-chain_state::activations chain_state::activation(const data& values)
+// Add (or remove) a version to (or from) the counts.
+void chain_state::tally(tallies& counts, uint32_t version, bool add)
 {
-    const auto testnet = values.testnet;
-    const auto& history = values.version.unordered;
+    const auto step = [add](size_t& count)
+    {
+        count = add ? count + 1 : count - 1;
+    };
+
+    if (version >= bip65_version)
+        step(counts.bip65);
+
+    if (version >= bip66_version)
+        step(counts.bip66);
+
+    if (version >= bip34_version)
+        step(counts.bip34);
+}
+
+chain_state::tallies chain_state::tally(const data& values)
+{
+    // Compute version summaries in a single pass.
+    tallies counts{ 0, 0, 0 };
+    for (const auto version: values.version.unordered)
+        tally(counts, version, true);
+
+    return counts;
+}
 
-    // Declare version predicates.
-    const auto ge_4 = [](uint32_t version) { return version >= bip65_version; };
-    const auto ge_3 = [](uint32_t version) { return version >= bip66_version; };
-    const auto ge_2 = [](uint32_t version) { return version >= bip34_version; };
+chain_state::activations chain_state::activation(const data& values)
+{
+    return activation(values, tally(values));
+}
 
-    // Compute version summaries.
-    const auto count_4 = std::count_if(history.begin(), history.end(), ge_4);
-    const auto count_3 = std::count_if(history.begin(), history.end(), ge_3);
-    const auto count_2 = std::count_if(history.begin(), history.end(), ge_2);
+chain_state::activations chain_state::activation(const data& values,
+    const tallies& counts)
+{
+    const auto testnet = values.testnet;
+    const auto count_4 = counts.bip65;
+    const auto count_3 = counts.bip66;
+    const auto count_2 = counts.bip34;
 
     // Initialize activation results with genesis values.
     activations result{ rule_fork::no_rules, first_version };
@@ -135,15 +189,17 @@ chain_state::activations chain_state::activation(const data& values)
 
 uint32_t chain_state::median_time_past(const data& values)
 {
-    // Create a copy for the in-place sort.
+    // Create a copy for the in-place selection.
     auto times = values.timestamp.ordered;
 
-    // Sort the times by value to obtain the median.
-    std::sort(times.begin(), times.end());
+    if (times.empty())
+        return 0;
 
     // Consensus defines median time using modulo 2 element selection.
     // This differs from arithmetic median which averages two middle values.
-    return times.empty() ? 0 : times[times.size() / 2];
+    const auto median = times.begin() + times.size() / 2;
+    std::nth_element(times.begin(), median, times.end());
+    return *median;
 }
 
 uint32_t chain_state::work_required(const data& values)
@@ -237,6 +293,100 @@ bool chain_state::is_retarget_height(size_t height)
     return (height % retargeting_interval) == 0;
 }
 
+// Promotion.
+//-----------------------------------------------------------------------------
+// non-public
+
+// The parent values slide into the child windows, replacing the lowest.
+chain_state::data chain_state::to_child(const chain_state& parent,
+    const header& header)
+{
+    const auto& from = parent.data_;
+    const auto height = from.height + 1;
+    const auto testnet = from.testnet;
+    const auto capacity = version_sample_capacity(from.enabled, testnet);
+    const auto& sample = from.version.unordered;
+
+    // A sample reduced by get_map can only be promoted while still reduced.
+    // An oversized sample would place the ring head beyond the lowest value.
+    const auto complete = sample.size() == std::min(from.height, capacity);
+    const auto reduced = !from.enabled ||
+        !is_active(std::min(height - 1, capacity - 1), testnet);
+    const auto bounded = sample.size() <= capacity;
+
+    data child;
+    child.testnet = testnet;
+    child.enabled = from.enabled;
+    child.height = from.height == 0 || !bounded ||
+        (!complete && !reduced) ? 0 : height;
+    child.hash = header.hash();
+
+    child.bits.self = header.bits();
+    child.bits.ordered = slide(from.bits.ordered, from.bits.self,
+        bits_capacity(testnet));
+
+    // The version sample is a ring, so the lowest is replaced in place.
+    child.version.self = header.version();
+    child.version.unordered = sample;
+
+    if (sample.size() < capacity)
+        child.version.unordered.push_back(from.version.self);
+    else if (bounded)
+        child.version.unordered[parent.version_head_] = from.version.self;
+
+    child.timestamp.self = header.timestamp();
+    child.timestamp.retarget = is_retarget_height(from.height) ?
+        from.timestamp.self : from.timestamp.retarget;
+    child.timestamp.ordered = slide(from.timestamp.ordered,
+        from.timestamp.self, median_time_past_interval);
+
+    return child;
+}
+
+size_t chain_state::to_child_head(const chain_state& parent)
+{
+    const auto& from = parent.data_;
+    const auto capacity = version_sample_capacity(from.enabled, from.testnet);
+
+    if (from.version.unordered.size() < capacity)
+        return parent.version_head_;
+
+    return (parent.version_head_ + 1) % capacity;
+}
+
+// The counts of the full sample, sliding the parent version in.
+chain_state::tallies chain_state::to_child_tallies(const chain_state& parent)
+{
+    const auto& from = parent.data_;
+    const auto capacity = version_sample_capacity(from.enabled, from.testnet);
+    auto counts = parent.tallies_;
+
+    if (from.version.unordered.size() == capacity)
+    {
+        const auto lowest = from.version.unordered[parent.version_head_];
+        tally(counts, lowest, false);
+    }
+
+    tally(counts, from.version.self, true);
+    return counts;
+}
+
+// The counts of the sample as it would be reduced by get_map.
+chain_state::tallies chain_state::to_child_sample(const chain_state& parent)
+{
+    const auto& from = parent.data_;
+    const auto height = from.height + 1;
+    const auto testnet = from.testnet;
+    const auto capacity = version_sample_capacity(from.enabled, testnet);
+
+    if (from.enabled && is_active(std::min(height - 1, capacity - 1), testnet))
+        return to_child_tallies(parent);
+
+    tallies counts{ 0, 0, 0 };
+    tally(counts, from.version.self, true);
+    return counts;
+}
+
 // Publics.
 //-----------------------------------------------------------------------------
 
@@ -266,12 +416,15 @@ chain_state::map chain_state::get_map(size_t height, bool enabled,
     // Timestamp.
     //-------------------------------------------------------------------------
     // The height range of the median time past, and retarget/self blocks.
-    // Height must be a positive multiple of interval, so underflow safe.
+    // The retarget height rounds high down to the interval, so it cannot
+    // underflow. It is mapped at every height so that promotion can reach
+    // the next retarget height without another store read.
     map.timestamp.high = height - 1;
     map.timestamp.low = floor_subtract(map.timestamp.high, min_time_past);
     map.timestamp_self = height;
-    map.timestamp_retarget = is_retarget_height(height) ?
-        height - retargeting_interval : map.timestamp.high;
+    map.bits_self = height;
+    map.version_self = height;
+    map.timestamp_retarget = retarget_height(map.timestamp.high);
 
     // Version.
     //-------------------------------------------------------------------------
@@ -286,13 +439,26 @@ chain_state::map chain_state::get_map(size_t height, bool enabled,
     return map;
 }
 
-// Constructor.
+// Constructors.
 chain_state::chain_state(data&& values, const checkpoints& checkpoints)
   : data_(std::move(values)),
-    checkpoints_(checkpoints),
-    active_(activation(data_)),
+    version_head_(0),
+    tallies_(tally(data_)),
+    active_(activation(data_, tallies_)),
+    median_time_past_(median_time_past(data_)),
+    work_required_(work_required(data_)),
+    checkpoints_(checkpoints)
+{
+}
+
+chain_state::chain_state(const chain_state& parent, const header& header)
+  : data_(to_child(parent, header)),
+    version_head_(to_child_head(parent)),
+    tallies_(to_child_tallies(parent)),
+    active_(activation(data_, to_child_sample(parent))),
+    median_time_past_(median_time_past(data_)),
     work_required_(work_required(data_)),
-    median_time_past_(median_time_past(data_))
+    checkpoints_(parent.checkpoints_)
 {
 }
 
@@ -19,15 +19,17 @@
  */
 #include <bitcoin/bitcoin/chain/header.hpp>
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <chrono>
 #include <utility>
 #include <bitcoin/bitcoin/chain/chain_state.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/error.hpp>
-#include <bitcoin/bitcoin/math/hash_number.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 
@@ -36,6 +38,75 @@ namespace chain {
 
 const size_t header::validation::orphan_height = 0;
 
+// A 256 bit proof of work target as 64 bit words, least significant first.
+typedef std::array<uint64_t, 4> target;
+
+// The expansion of max_work_bits (0x1d00ffff), 0xffff << 208.
+static const target maximum_target{ { 0, 0, 0, 0x00000000ffff0000 } };
+
+// Expand compact bits to a target, false if negative or overflowed.
+// This is equivalent to hash_number::set_compact, without the conversion.
+static bool to_target(target& out, uint32_t bits)
+{
+    const auto size = bits >> 24;
+    const uint64_t mantissa = bits & 0x007fffff;
+    out.fill(0);
+
+    if (mantissa == 0)
+        return true;
+
+    if ((bits & 0x00800000) != 0 || size > 34 ||
+        (mantissa > 0xff && size > 33) || (mantissa > 0xffff && size > 32))
+        return false;
+
+    if (size <= 3)
+    {
+        out[0] = mantissa >> (8 * (3 - size));
+        return true;
+    }
+
+    const auto shift = 8 * (size - 3);
+    const auto word = shift / 64;
+    const auto offset = shift % 64;
+    out[word] = mantissa << offset;
+
+    if (offset != 0 && word + 1 < out.size())
+        out[word + 1] = mantissa >> (64 - offset);
+
+    return true;
+}
+
+// Compare words from the most significant, exiting at the first difference.
+static bool is_above(const target& left, const target& right)
+{
+    for (auto word = left.size(); word > 0; --word)
+        if (left[word - 1] != right[word - 1])
+            return left[word - 1] > right[word - 1];
+
+    return false;
+}
+
+// The hash is a little endian 256 bit value, compared in place.
+static bool is_at_or_below(const hash_digest& hash, const target& limit)
+{
+    for (auto word = limit.size(); word > 0; --word)
+    {
+        const auto begin = hash.begin() + (word - 1) * sizeof(uint64_t);
+        const auto value = from_little_endian_unsafe<uint64_t>(begin);
+
+        if (value != limit[word - 1])
+            return value < limit[word - 1];
+    }
+
+    return true;
+}
+
+// The target of valid bits, false if invalid or exceeding the maximum.
+static bool to_work_target(target& out, uint32_t bits)
+{
+    return to_target(out, bits) && !is_above(out, maximum_target);
+}
+
 // Constructors.
 //-----------------------------------------------------------------------------
 
@@ -404,17 +475,38 @@ bool header::is_valid_time_stamp() const
 
 bool header::is_valid_proof_of_work() const
 {
-    // TODO: This should be statically-initialized (optimization).
-    hash_number maximum;
-    if (!maximum.set_compact(max_work_bits))
-        return false;
+    return is_valid_proof_of_work(bits_, hash());
+}
 
-    hash_number target;
-    if (!target.set_compact(bits_) || target > maximum)
-        return false;
+// static
+bool header::is_valid_proof_of_work(uint32_t bits, const hash_digest& hash)
+{
+    target limit;
+    return to_work_target(limit, bits) && is_at_or_below(hash, limit);
+}
+
+// static
+bool header::is_valid_proof_of_work(const list& headers)
+{
+    // Headers of a retarget period share bits, so expand each run once.
+    // The initial bits are negative, so invalid without expansion.
+    target limit;
+    auto valid = false;
+    auto bits = max_uint32;
+
+    for (const auto& header: headers)
+    {
+        if (header.bits_ != bits)
+        {
+            bits = header.bits_;
+            valid = to_work_target(limit, bits);
+        }
+
+        if (!valid || !is_at_or_below(header.hash(), limit))
+            return false;
+    }
 
-    hash_number value(hash());
-    return value <= target;
+    return true;
 }
 
 // Validation.
@@ -464,7 +464,8 @@ operation::stack operation::to_pay_multisig_pattern(uint8_t signatures,
     const auto op_m = static_cast<opcode>(m + zero);
     const auto op_n = static_cast<opcode>(points.size() + zero);
 
-    operation::stack ops(points.size() + 3);
+    operation::stack ops;
+    ops.reserve(points.size() + 3);
     ops.push_back({ op_m, {} });
 
     for (const auto point: points)
@@ -34,6 +34,7 @@
 #include <bitcoin/bitcoin/formats/base_16.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/signature_cache.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
@@ -551,8 +552,8 @@ bool script::check_signature(const ec_signature& signature,
     const auto sighash = script::generate_signature_hash(tx, input_index,
         script_code, sighash_type);
 
-    // Validate the EC signature.
-    return verify_signature(public_key, sighash, signature);
+    // Validate the EC signature, skipping ECDSA if previously validated.
+    return signature_cache::instance().verify(public_key, sighash, signature);
 }
 
 // static
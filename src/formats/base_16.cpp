@@ -20,37 +20,262 @@
 #include <bitcoin/bitcoin/formats/base_16.hpp>
 
 #include <algorithm>
-#include <iomanip>
-#include <sstream>
-#include <boost/algorithm/string.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include "simd.hpp"
 
 namespace libbitcoin {
 
-std::string encode_base16(data_slice data)
+static const char base16_digits[] = "0123456789abcdef";
+
+// The base16 value of each ascii character, or -1 if not a base16 character.
+static const int8_t base16_values[128] =
 {
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0');
-    for (int val: data)
-        ss << std::setw(2) << val;
-    return ss.str();
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+static int from_hex(const char c)
+{
+    const auto byte = static_cast<uint8_t>(c);
+    return byte < sizeof(base16_values) ? base16_values[byte] : -1;
 }
 
 bool is_base16(const char c)
 {
-    return
-        ('0' <= c && c <= '9') ||
-        ('A' <= c && c <= 'F') ||
-        ('a' <= c && c <= 'f');
+    return from_hex(c) >= 0;
+}
+
+static void encode(char* out, const uint8_t* begin, const uint8_t* end)
+{
+    for (auto it = begin; it != end; ++it)
+    {
+        *out++ = base16_digits[*it >> 4];
+        *out++ = base16_digits[*it & 0x0f];
+    }
+}
+
+#ifdef BC_X86_SIMD
+
+// Each kernel converts whole blocks and returns the number of bytes done.
+
+BC_TARGET("ssse3")
+static size_t encode_ssse3(char* out, const uint8_t* in, size_t size)
+{
+    const auto digits = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(base16_digits));
+    const auto nibble = _mm_set1_epi8(0x0f);
+    size_t done = 0;
+
+    for (; size - done >= 16; done += 16, out += 32)
+    {
+        const auto bytes = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(in + done));
+        const auto high = _mm_shuffle_epi8(digits,
+            _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble));
+        const auto low = _mm_shuffle_epi8(digits,
+            _mm_and_si128(bytes, nibble));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+            _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16),
+            _mm_unpackhi_epi8(high, low));
+    }
+
+    return done;
+}
+
+BC_TARGET("avx2")
+static size_t encode_avx2(char* out, const uint8_t* in, size_t size)
+{
+    const auto digits = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(base16_digits)));
+    const auto nibble = _mm256_set1_epi8(0x0f);
+    size_t done = 0;
+
+    for (; size - done >= 32; done += 32, out += 64)
+    {
+        const auto bytes = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(in + done));
+        const auto high = _mm256_shuffle_epi8(digits,
+            _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble));
+        const auto low = _mm256_shuffle_epi8(digits,
+            _mm256_and_si256(bytes, nibble));
+
+        // Unpacking is per 128 bit lane, so restore the byte order.
+        const auto first = _mm256_unpacklo_epi8(high, low);
+        const auto second = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+            _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32),
+            _mm256_permute2x128_si256(first, second, 0x31));
+    }
+
+    return done;
+}
+
+// Map 16 characters to their nibble values, flagging invalid characters.
+BC_TARGET("ssse3")
+static __m128i decode_nibbles(__m128i chars, __m128i& invalid)
+{
+    const auto digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const auto letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)),
+        _mm_set1_epi8('a'));
+    const auto is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit,
+        _mm_set1_epi8(9)), digit);
+    const auto is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter,
+        _mm_set1_epi8(5)), letter);
+    invalid = _mm_or_si128(invalid, _mm_andnot_si128(
+        _mm_or_si128(is_digit, is_letter), _mm_set1_epi8(-1)));
+    return _mm_or_si128(_mm_and_si128(is_digit, digit),
+        _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+BC_TARGET("ssse3")
+static size_t decode_ssse3(uint8_t* out, size_t out_size, const char* in,
+    bool& valid)
+{
+    // Each byte is (high nibble * 16) + low nibble.
+    const auto weights = _mm_set1_epi16(0x0110);
+    auto invalid = _mm_setzero_si128();
+    size_t done = 0;
+
+    for (; out_size - done >= 16; done += 16, in += 32)
+    {
+        const auto first = decode_nibbles(_mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(in)), invalid);
+        const auto second = decode_nibbles(_mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(in + 16)), invalid);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + done),
+            _mm_packus_epi16(_mm_maddubs_epi16(first, weights),
+                _mm_maddubs_epi16(second, weights)));
+    }
+
+    valid = _mm_movemask_epi8(invalid) == 0;
+    return done;
 }
 
-static unsigned from_hex(const char c)
+BC_TARGET("avx2")
+static __m256i decode_nibbles(__m256i chars, __m256i& invalid)
 {
-    if ('A' <= c && c <= 'F')
-        return 10 + c - 'A';
-    if ('a' <= c && c <= 'f')
-        return 10 + c - 'a';
-    return c - '0';
+    const auto digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    const auto letter = _mm256_sub_epi8(_mm256_or_si256(chars,
+        _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const auto is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit,
+        _mm256_set1_epi8(9)), digit);
+    const auto is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter,
+        _mm256_set1_epi8(5)), letter);
+    invalid = _mm256_or_si256(invalid, _mm256_andnot_si256(
+        _mm256_or_si256(is_digit, is_letter), _mm256_set1_epi8(-1)));
+    return _mm256_or_si256(_mm256_and_si256(is_digit, digit),
+        _mm256_and_si256(is_letter, _mm256_add_epi8(letter,
+            _mm256_set1_epi8(10))));
+}
+
+BC_TARGET("avx2")
+static size_t decode_avx2(uint8_t* out, size_t out_size, const char* in,
+    bool& valid)
+{
+    const auto weights = _mm256_set1_epi16(0x0110);
+    auto invalid = _mm256_setzero_si256();
+    size_t done = 0;
+
+    for (; out_size - done >= 32; done += 32, in += 64)
+    {
+        const auto first = decode_nibbles(_mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(in)), invalid);
+        const auto second = decode_nibbles(_mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(in + 32)), invalid);
+
+        // Packing is per 128 bit lane, so restore the quadword order.
+        const auto packed = _mm256_packus_epi16(
+            _mm256_maddubs_epi16(first, weights),
+            _mm256_maddubs_epi16(second, weights));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + done),
+            _mm256_permute4x64_epi64(packed, 0xd8));
+    }
+
+    valid = _mm256_movemask_epi8(invalid) == 0;
+    return done;
+}
+
+#endif
+
+static size_t encode_vector(char* out, const uint8_t* in, size_t size)
+{
+    size_t done = 0;
+
+#ifdef BC_X86_SIMD
+    if (have_avx2())
+        done = encode_avx2(out, in, size);
+
+    if (have_ssse3())
+        done += encode_ssse3(out + 2 * done, in + done, size - done);
+#endif
+
+    return done;
+}
+
+static size_t decode_vector(uint8_t* out, size_t out_size, const char* in,
+    bool& valid)
+{
+    size_t done = 0;
+    valid = true;
+
+#ifdef BC_X86_SIMD
+    if (have_avx2())
+        done = decode_avx2(out, out_size, in, valid);
+
+    if (valid && have_ssse3())
+        done += decode_ssse3(out + done, out_size - done, in + 2 * done,
+            valid);
+#endif
+
+    return done;
+}
+
+void encode_base16(char* out, data_slice data)
+{
+    const auto done = encode_vector(out, data.data(), data.size());
+    encode(out + 2 * done, data.begin() + done, data.end());
+}
+
+std::string encode_base16(data_slice data)
+{
+    std::string encoded(2 * data.size(), '0');
+    encode_base16(&encoded[0], data);
+    return encoded;
+}
+
+bool decode_base16(uint8_t* out, size_t out_size, const char* in)
+{
+    bool valid;
+    const auto done = decode_vector(out, out_size, in, valid);
+    if (!valid)
+        return false;
+
+    // Accumulate invalid characters to avoid a branch per character.
+    int invalid = 0;
+    in += 2 * done;
+
+    for (size_t index = done; index < out_size; ++index, in += 2)
+    {
+        const auto high = from_hex(in[0]);
+        const auto low = from_hex(in[1]);
+        invalid |= high | low;
+        out[index] = static_cast<uint8_t>((unsigned(high) << 4) |
+            (unsigned(low) & 0x0f));
+    }
+
+    return invalid >= 0;
 }
 
 bool decode_base16(data_chunk& out, const std::string& in)
@@ -60,18 +285,21 @@ bool decode_base16(data_chunk& out, const std::string& in)
         return false;
 
     data_chunk result(in.size() / 2);
-    if (!decode_base16_private(result.data(), result.size(), in.data()))
+    if (!decode_base16(result.data(), result.size(), in.data()))
         return false;
 
-    out = result;
+    out = std::move(result);
     return true;
 }
 
 // Bitcoin hash format (these are all reversed):
 std::string encode_hash(hash_digest hash)
 {
+    // The hash is a copy, so reverse it in place for the vector encoder.
     std::reverse(hash.begin(), hash.end());
-    return encode_base16(hash);
+    std::string encoded(2 * hash_size, '0');
+    encode_base16(&encoded[0], hash);
+    return encoded;
 }
 
 bool decode_hash(hash_digest& out, const std::string& in)
@@ -80,7 +308,7 @@ bool decode_hash(hash_digest& out, const std::string& in)
         return false;
 
     hash_digest result;
-    if (!decode_base16_private(result.data(), result.size(), in.data()))
+    if (!decode_base16(result.data(), result.size(), in.data()))
         return false;
 
     // Reverse:
@@ -91,8 +319,8 @@ bool decode_hash(hash_digest& out, const std::string& in)
 hash_digest hash_literal(const char (&string)[2 * hash_size + 1])
 {
     hash_digest out;
-    DEBUG_ONLY(const auto success =) decode_base16_private(out.data(),
-        out.size(), string);
+    DEBUG_ONLY(const auto success =) decode_base16(out.data(), out.size(),
+        string);
     BITCOIN_ASSERT(success);
     std::reverse(out.begin(), out.end());
     return out;
@@ -101,16 +329,7 @@ hash_digest hash_literal(const char (&string)[2 * hash_size + 1])
 // For support of template implementation only, do not call directly.
 bool decode_base16_private(uint8_t* out, size_t out_size, const char* in)
 {
-    if (!std::all_of(in, in + 2 * out_size, is_base16))
-        return false;
-
-    for (size_t i = 0; i < out_size; ++i)
-    {
-        out[i] = (from_hex(in[0]) << 4) + from_hex(in[1]);
-        in += 2;
-    }
-
-    return true;
+    return decode_base16(out, out_size, in);
 }
 
 } // namespace libbitcoin
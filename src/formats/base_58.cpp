@@ -19,18 +19,55 @@
  */
 #include <bitcoin/bitcoin/formats/base_58.hpp>
 
-#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin/math/checksum.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
 
 namespace libbitcoin {
 
 const std::string base58_chars =
     "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
 
+// The base58 value of each ascii character, or -1 if not a base58 character.
+static const int8_t base58_values[128] =
+{
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1,  0,  1,  2,  3,  4,  5,  6,  7,  8, -1, -1, -1, -1, -1, -1,
+    -1,  9, 10, 11, 12, 13, 14, 15, 16, -1, 17, 18, 19, 20, 21, -1,
+    22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, -1, -1, -1, -1, -1,
+    -1, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, -1, 44, 45, 46,
+    47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, -1, -1, -1, -1, -1
+};
+
+// Numbers are held in 32 bit limbs of five base58 digits (58^5 < 2^30) for
+// encoding and of four bytes for decoding, least significant limb first.
+// All limb products fit 64 bits, which avoids a dependency on 128 bit types.
+static constexpr size_t limb_digits = 5;
+static constexpr size_t limb_bytes = sizeof(uint32_t);
+static constexpr uint32_t limb_base = 58u * 58u * 58u * 58u * 58u;
+
+// Limbs of this count are on the stack, covering all fixed size encodings
+// including 25 byte payment addresses and 82 byte extended keys.
+static constexpr size_t stack_limbs = 64;
+
+static int base58_value(const char ch)
+{
+    const auto byte = static_cast<uint8_t>(ch);
+    return byte < sizeof(base58_values) ? base58_values[byte] : -1;
+}
+
 bool is_base58(const char ch)
 {
-    // This works because the base58 characters happen to be in sorted order
-    return std::binary_search(base58_chars.begin(), base58_chars.end(), ch);
+    return base58_value(ch) >= 0;
 }
 
 bool is_base58(const std::string& text)
@@ -43,154 +80,245 @@ bool is_base58(const std::string& text)
     return std::all_of(text.begin(), text.end(), test);
 }
 
-template <typename Data>
-auto search_first_nonzero(const Data& data) -> decltype(data.cbegin())
-{
-    auto first_nonzero = data.cbegin();
-    while (first_nonzero != data.end() && *first_nonzero == 0)
-        ++first_nonzero;
+// encode
+// ----------------------------------------------------------------------------
 
-    return first_nonzero;
+// log(256) / log(58) digits per byte, rounded up, in five digit limbs.
+static size_t encode_limbs(size_t size)
+{
+    return (size * 138 / 100 + 1) / limb_digits + 1;
 }
 
-size_t count_leading_zeros(data_slice unencoded)
+static std::string encode(const uint8_t* data, size_t size)
 {
-    // Skip and count leading '1's.
-    size_t leading_zeros = 0;
-    for (const uint8_t byte: unencoded)
+    const auto end = data + size;
+    const auto first_nonzero = std::find_if(data, end, [](uint8_t byte)
     {
-        if (byte != 0)
-            break;
+        return byte != 0;
+    });
 
-        ++leading_zeros;
-    }
+    const size_t leading_zeros = std::distance(data, first_nonzero);
+    const size_t capacity = encode_limbs(size - leading_zeros);
 
-    return leading_zeros;
-}
+    uint32_t stack[stack_limbs];
+    std::vector<uint32_t> heap;
+    if (capacity > stack_limbs)
+        heap.resize(capacity);
 
-void pack_value(data_chunk& indexes, size_t carry)
-{
-    // Apply "b58 = b58 * 256 + ch".
-    for (auto it = indexes.rbegin(); it != indexes.rend(); ++it)
-    {
-        carry += 256 * (*it);
-        *it = carry % 58;
-        carry /= 58;
-    }
+    const auto limbs = heap.empty() ? stack : heap.data();
+    size_t used = 0;
 
-    BITCOIN_ASSERT(carry == 0);
-}
+    // Consume a partial word first so that the remainder is whole words.
+    auto width = (size - leading_zeros) % limb_bytes;
 
-std::string encode_base58(data_slice unencoded)
-{
-    size_t leading_zeros = count_leading_zeros(unencoded);
+    for (auto it = first_nonzero; it != end; width = limb_bytes)
+    {
+        uint64_t carry = 0;
+        const auto count = width == 0 ? limb_bytes : width;
 
-    // size = log(256) / log(58), rounded up.
-    const size_t number_nonzero = unencoded.size() - leading_zeros;
-    const size_t indexes_size = number_nonzero * 138 / 100 + 1;
+        for (size_t byte = 0; byte < count; ++byte)
+            carry = (carry << 8) | *it++;
 
-    // Allocate enough space in big-endian base58 representation.
-    data_chunk indexes(indexes_size);
+        // Apply "b58 = b58 * 256^count + word".
+        const auto shift = 8 * count;
+        for (size_t limb = 0; limb < used; ++limb)
+        {
+            carry += static_cast<uint64_t>(limbs[limb]) << shift;
+            limbs[limb] = static_cast<uint32_t>(carry % limb_base);
+            carry /= limb_base;
+        }
 
-    // Process the bytes.
-    for (auto it = unencoded.begin() + leading_zeros;
-        it != unencoded.end(); ++it)
-    {
-        pack_value(indexes, *it);
+        for (; carry != 0; carry /= limb_base)
+            limbs[used++] = static_cast<uint32_t>(carry % limb_base);
+
+        BITCOIN_ASSERT(used <= capacity);
     }
 
-    // Skip leading zeroes in base58 result.
-    auto first_nonzero = search_first_nonzero(indexes);
+    // The most significant limb is not zero padded.
+    size_t digits = 0;
+    if (used != 0)
+        for (auto top = limbs[used - 1]; top != 0; top /= 58)
+            ++digits;
+
+    if (used > 1)
+        digits += limb_digits * (used - 1);
 
-    // Translate the result into a string.
-    std::string encoded;
-    const size_t estimated_size = leading_zeros + 
-        (indexes.end() - first_nonzero);
-    encoded.reserve(estimated_size);
-    encoded.assign(leading_zeros, '1');
+    // Leading zero bytes are each encoded as a leading '1'.
+    std::string encoded(leading_zeros + digits, base58_chars[0]);
+    auto out = encoded.rbegin();
 
-    // Set actual main bytes.
-    for (auto it = first_nonzero; it != indexes.end(); ++it)
+    for (size_t limb = 0; limb < used; ++limb)
     {
-        const size_t index = *it;
-        encoded += base58_chars[index];
+        auto value = limbs[limb];
+        const auto top = limb + 1 == used;
+
+        for (size_t digit = 0; digit < limb_digits && (!top || value != 0);
+            ++digit, value /= 58)
+            *out++ = base58_chars[value % 58];
     }
 
     return encoded;
 }
 
-size_t count_leading_zeros(const std::string& encoded)
+std::string encode_base58(data_slice unencoded)
 {
-    // Skip and count leading '1's.
-    size_t leading_zeros = 0;
-    for (const uint8_t digit: encoded)
-    {
-        if (digit != base58_chars[0])
-            break;
+    return encode(unencoded.data(), unencoded.size());
+}
+
+std::string encode_base58_checked(data_slice unchecked)
+{
+    const auto checksum = to_little_endian(bitcoin_checksum(unchecked));
+    const auto size = unchecked.size() + checksum_size;
 
-        ++leading_zeros;
+    // Fixed size payloads are checksummed without a heap copy.
+    static constexpr size_t stack_bytes = 128;
+    if (size <= stack_bytes)
+    {
+        uint8_t buffer[stack_bytes];
+        std::copy(unchecked.begin(), unchecked.end(), buffer);
+        std::copy(checksum.begin(), checksum.end(), buffer + unchecked.size());
+        return encode(buffer, size);
     }
 
-    return leading_zeros;
+    const auto checked = build_chunk({ unchecked, checksum });
+    return encode(checked.data(), checked.size());
+}
+
+// decode
+// ----------------------------------------------------------------------------
+
+// log(58) / log(256) bytes per digit, rounded up, in four byte limbs.
+static size_t decode_limbs(size_t size)
+{
+    return (size * 733 / 1000 + 1) / limb_bytes + 1;
 }
 
-void unpack_char(data_chunk& data, size_t carry)
+// Decode the text into limbs, returning the number of limbs used and setting
+// the number of leading zeros, or returning false if a character is invalid.
+static bool decode(uint32_t* limbs, size_t& out_used, size_t& out_zeros,
+    const char* text, size_t size)
 {
-    for (auto it = data.rbegin(); it != data.rend(); it++)
+    const auto end = text + size;
+    const auto first_nonzero = std::find_if(text, end, [](char ch)
+    {
+        return ch != base58_chars[0];
+    });
+
+    size_t used = 0;
+
+    // Consume a partial limb first so that the remainder is whole limbs.
+    auto width = (size - std::distance(text, first_nonzero)) % limb_digits;
+
+    for (auto it = first_nonzero; it != end; width = limb_digits)
     {
-        carry += 58 * (*it);
-        *it = carry % 256;
-        carry /= 256;
+        uint32_t value = 0;
+        uint32_t factor = 1;
+        const auto count = width == 0 ? limb_digits : width;
+
+        for (size_t digit = 0; digit < count; ++digit, factor *= 58)
+        {
+            const auto carry = base58_value(*it++);
+            if (carry < 0)
+                return false;
+
+            value = value * 58 + carry;
+        }
+
+        // Apply "b256 = b256 * 58^count + value".
+        uint64_t carry = value;
+        for (size_t limb = 0; limb < used; ++limb)
+        {
+            carry += static_cast<uint64_t>(limbs[limb]) * factor;
+            limbs[limb] = static_cast<uint32_t>(carry);
+            carry >>= 32;
+        }
+
+        if (carry != 0)
+            limbs[used++] = static_cast<uint32_t>(carry);
     }
 
-    BITCOIN_ASSERT(carry == 0);
+    out_used = used;
+    out_zeros = std::distance(text, first_nonzero);
+    return true;
 }
 
-bool decode_base58(data_chunk& out, const std::string& in)
+static size_t decoded_size(const uint32_t* limbs, size_t used, size_t zeros)
 {
-    // Trim spaces and newlines around the string.
-    const auto leading_zeros = count_leading_zeros(in);
+    if (used == 0)
+        return zeros;
+
+    size_t bytes = 0;
+    for (auto top = limbs[used - 1]; top != 0; top >>= 8)
+        ++bytes;
 
-    // log(58) / log(256), rounded up.
-    const size_t data_size = in.size() * 733 / 1000 + 1;
+    return zeros + bytes + limb_bytes * (used - 1);
+}
 
-    // Allocate enough space in big-endian base256 representation.
-    data_chunk data(data_size);
+static void to_bytes(uint8_t* out, size_t size, const uint32_t* limbs,
+    size_t used, size_t zeros)
+{
+    // Leading zero bytes are encoded as leading '1' characters.
+    std::fill(out, out + zeros, 0x00);
+    auto it = out + size;
 
-    // Process the characters.
-    for (auto it = in.begin() + leading_zeros; it != in.end(); ++it)
+    for (size_t limb = 0; limb < used; ++limb)
     {
-        const auto carry = base58_chars.find(*it);
-        if (carry == std::string::npos)
-            return false;
+        auto value = limbs[limb];
+        const auto top = limb + 1 == used;
 
-        unpack_char(data, carry);
+        for (size_t byte = 0; byte < limb_bytes && (!top || value != 0);
+            ++byte, value >>= 8)
+            *--it = static_cast<uint8_t>(value);
     }
 
-    // Skip leading zeroes in data.
-    auto first_nonzero = search_first_nonzero(data);
+    BITCOIN_ASSERT(it == out + zeros);
+}
+
+bool decode_base58(data_chunk& out, const std::string& in)
+{
+    const auto capacity = decode_limbs(in.size());
+
+    uint32_t stack[stack_limbs];
+    std::vector<uint32_t> heap;
+    if (capacity > stack_limbs)
+        heap.resize(capacity);
+
+    const auto limbs = heap.empty() ? stack : heap.data();
 
-    // Copy result into output vector.
-    data_chunk decoded;
-    const size_t estimated_size = leading_zeros + (data.end() - first_nonzero);
-    decoded.reserve(estimated_size);
-    decoded.assign(leading_zeros, 0x00);
-    decoded.insert(decoded.end(), first_nonzero, data.cend());
+    size_t used;
+    size_t zeros;
+    if (!decode(limbs, used, zeros, in.data(), in.size()))
+        return false;
 
-    out = decoded;
+    out.resize(decoded_size(limbs, used, zeros));
+    to_bytes(out.data(), out.size(), limbs, used, zeros);
     return true;
 }
 
 // For support of template implementation only, do not call directly.
 bool decode_base58_private(uint8_t* out, size_t out_size, const char* in)
 {
-    data_chunk buffer;
-    if (!decode_base58(buffer, in) || buffer.size() != out_size)
+    // Each byte encodes to at most log(256) / log(58) characters.
+    const auto size = std::strlen(in);
+    if (size > out_size * 138 / 100 + 1)
         return false;
 
-    for (size_t i = 0; i < out_size; ++i)
-        out[i] = buffer[i];
+    uint32_t stack[stack_limbs];
+    std::vector<uint32_t> heap;
+    const auto capacity = decode_limbs(size);
+    if (capacity > stack_limbs)
+        heap.resize(capacity);
+
+    const auto limbs = heap.empty() ? stack : heap.data();
+
+    size_t used;
+    size_t zeros;
+    if (!decode(limbs, used, zeros, in, size) ||
+        decoded_size(limbs, used, zeros) != out_size)
+        return false;
 
+    // Fixed size results are written directly to the caller's array.
+    to_bytes(out, out_size, limbs, used, zeros);
     return true;
 }
 
@@ -19,9 +19,12 @@
  */
 #include <bitcoin/bitcoin/formats/base_64.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include "simd.hpp"
 
 // This implementation derived from public domain:
 // en.wikibooks.org/wiki/Algorithm_Implementation/Miscellaneous/Base64
@@ -33,25 +36,288 @@ const static char pad = '=';
 const static char table[] = 
     "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-std::string encode_base64(data_slice unencoded)
+// The base64 value of each ascii character, or -1 if not a base64 character.
+const static int8_t values[128] =
 {
-    std::string encoded;
-    const auto size = unencoded.size();
-    encoded.reserve(((size / 3) + (size % 3 > 0)) * 4);
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+    -1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+    -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1
+};
+
+static int32_t from_base64(const char c)
+{
+    const auto byte = static_cast<uint8_t>(c);
+    return byte < sizeof(values) ? values[byte] : -1;
+}
+
+#ifdef BC_X86_SIMD
+
+// The kernels follow Wojciech Mula and Daniel Lemire, "Faster Base64 Encoding
+// and Decoding Using AVX2 Instructions" (2018). Each converts whole blocks and
+// returns the number of bytes done.
+
+// Spread each 3 bytes over 4 bytes of 6 bits each (per 128 bit lane).
+BC_TARGET("ssse3")
+static __m128i encode_indexes(__m128i bytes)
+{
+    const auto spread = _mm_shuffle_epi8(bytes, _mm_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    const auto high = _mm_mulhi_epu16(_mm_and_si128(spread,
+        _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    const auto low = _mm_mullo_epi16(_mm_and_si128(spread,
+        _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(high, low);
+}
+
+// Map each 6 bit value to its character by adding a per range offset.
+BC_TARGET("ssse3")
+static __m128i encode_characters(__m128i indexes)
+{
+    const auto offsets = _mm_setr_epi8('A', 'a' - 26, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '+' - 62, '/' - 63, 0, 0);
+    const auto range = _mm_sub_epi8(_mm_subs_epu8(indexes, _mm_set1_epi8(51)),
+        _mm_cmpgt_epi8(indexes, _mm_set1_epi8(25)));
+    return _mm_add_epi8(indexes, _mm_shuffle_epi8(offsets, range));
+}
+
+BC_TARGET("ssse3")
+static size_t encode_ssse3(char* out, const uint8_t* in, size_t size)
+{
+    size_t done = 0;
+
+    // Each load reads 16 bytes but converts only the first 12.
+    for (; size - done >= 16; done += 12, out += 16)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+            encode_characters(encode_indexes(_mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(in + done)))));
+
+    return done;
+}
+
+BC_TARGET("avx2")
+static __m256i encode_indexes(__m256i bytes)
+{
+    const auto spread = _mm256_shuffle_epi8(bytes, _mm256_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    const auto high = _mm256_mulhi_epu16(_mm256_and_si256(spread,
+        _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+    const auto low = _mm256_mullo_epi16(_mm256_and_si256(spread,
+        _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+    return _mm256_or_si256(high, low);
+}
+
+BC_TARGET("avx2")
+static __m256i encode_characters(__m256i indexes)
+{
+    const auto offsets = _mm256_broadcastsi128_si256(_mm_setr_epi8('A',
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 0, 0));
+    const auto range = _mm256_sub_epi8(_mm256_subs_epu8(indexes,
+        _mm256_set1_epi8(51)), _mm256_cmpgt_epi8(indexes,
+            _mm256_set1_epi8(25)));
+    return _mm256_add_epi8(indexes, _mm256_shuffle_epi8(offsets, range));
+}
+
+BC_TARGET("avx2")
+static size_t encode_avx2(char* out, const uint8_t* in, size_t size)
+{
+    size_t done = 0;
+
+    // Each lane converts 12 bytes, and the upper load ends 28 bytes in.
+    for (; size - done >= 28; done += 24, out += 32)
+    {
+        const auto bytes = _mm256_inserti128_si256(_mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done + 12)),
+            1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+            encode_characters(encode_indexes(bytes)));
+    }
+
+    return done;
+}
+
+// Map 16 characters to their 6 bit values, flagging invalid characters.
+BC_TARGET("ssse3")
+static __m128i decode_values(__m128i chars, __m128i& invalid)
+{
+    const auto mask = _mm_set1_epi8(0x2f);
+    const auto low_bits = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const auto high_bits = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08,
+        0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const auto offsets = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+        0, 0, 0, 0, 0, 0, 0, 0);
+
+    // A character is valid if its nibble classes do not intersect.
+    const auto high = _mm_and_si128(_mm_srli_epi32(chars, 4), mask);
+    const auto classes = _mm_and_si128(_mm_shuffle_epi8(low_bits,
+        _mm_and_si128(chars, mask)), _mm_shuffle_epi8(high_bits, high));
+    invalid = _mm_or_si128(invalid, classes);
+
+    // The '/' character shares its high nibble with '+'.
+    const auto slash = _mm_cmpeq_epi8(chars, mask);
+    return _mm_add_epi8(chars, _mm_shuffle_epi8(offsets,
+        _mm_add_epi8(slash, high)));
+}
+
+// Pack each 4 values of 6 bits into 3 bytes (per 128 bit lane).
+BC_TARGET("ssse3")
+static __m128i decode_bytes(__m128i values)
+{
+    const auto pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    const auto words = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(words, _mm_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+BC_TARGET("ssse3")
+static size_t decode_ssse3(uint8_t* out, const char* in, size_t size,
+    bool& valid)
+{
+    auto invalid = _mm_setzero_si128();
+    size_t done = 0;
+
+    for (; size - done >= 16; done += 16, out += 12)
+    {
+        const auto bytes = decode_bytes(decode_values(_mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(in + done)), invalid));
+
+        // Store only the 12 converted bytes.
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out), bytes);
+        const auto last = _mm_cvtsi128_si32(_mm_srli_si128(bytes, 8));
+        std::memcpy(out + 8, &last, sizeof(last));
+    }
+
+    valid = _mm_movemask_epi8(_mm_cmpeq_epi8(invalid,
+        _mm_setzero_si128())) == 0xffff;
+    return done;
+}
+
+BC_TARGET("avx2")
+static __m256i decode_values(__m256i chars, __m256i& invalid)
+{
+    const auto mask = _mm256_set1_epi8(0x2f);
+    const auto low_bits = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x15,
+        0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a,
+        0x1b, 0x1b, 0x1b, 0x1a));
+    const auto high_bits = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x10,
+        0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x10, 0x10));
+    const auto offsets = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 16, 19,
+        4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+
+    const auto high = _mm256_and_si256(_mm256_srli_epi32(chars, 4), mask);
+    const auto classes = _mm256_and_si256(_mm256_shuffle_epi8(low_bits,
+        _mm256_and_si256(chars, mask)), _mm256_shuffle_epi8(high_bits, high));
+    invalid = _mm256_or_si256(invalid, classes);
+
+    const auto slash = _mm256_cmpeq_epi8(chars, mask);
+    return _mm256_add_epi8(chars, _mm256_shuffle_epi8(offsets,
+        _mm256_add_epi8(slash, high)));
+}
+
+BC_TARGET("avx2")
+static __m256i decode_bytes(__m256i values)
+{
+    const auto pairs = _mm256_maddubs_epi16(values,
+        _mm256_set1_epi32(0x01400140));
+    const auto words = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+    const auto lanes = _mm256_shuffle_epi8(words, _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+    // Join the 12 bytes of each lane.
+    return _mm256_permutevar8x32_epi32(lanes,
+        _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+}
 
+BC_TARGET("avx2")
+static size_t decode_avx2(uint8_t* out, const char* in, size_t size,
+    bool& valid)
+{
+    auto invalid = _mm256_setzero_si256();
+    size_t done = 0;
+
+    for (; size - done >= 32; done += 32, out += 24)
+    {
+        const auto bytes = decode_bytes(decode_values(_mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(in + done)), invalid));
+
+        // Store only the 24 converted bytes.
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+            _mm256_castsi256_si128(bytes));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 16),
+            _mm256_extracti128_si256(bytes, 1));
+    }
+
+    valid = _mm256_testz_si256(invalid, invalid) != 0;
+    return done;
+}
+
+#endif
+
+static size_t encode_vector(char* out, const uint8_t* in, size_t size)
+{
+    size_t done = 0;
+
+#ifdef BC_X86_SIMD
+    if (have_avx2())
+        done = encode_avx2(out, in, size);
+
+    if (have_ssse3())
+        done += encode_ssse3(out + (done / 3) * 4, in + done, size - done);
+#endif
+
+    return done;
+}
+
+// The input size is a multiple of 4 and excludes any padded quantum.
+static size_t decode_vector(uint8_t* out, const char* in, size_t size,
+    bool& valid)
+{
+    size_t done = 0;
+    valid = true;
+
+#ifdef BC_X86_SIMD
+    if (have_avx2())
+        done = decode_avx2(out, in, size, valid);
+
+    if (valid && have_ssse3())
+        done += decode_ssse3(out + (done / 4) * 3, in + done, size - done,
+            valid);
+#endif
+
+    return done;
+}
+
+size_t encode_base64(char* out, data_slice unencoded)
+{
+    const auto start = out;
+    const auto done = encode_vector(out, unencoded.data(), unencoded.size());
+    const auto size = unencoded.size() - done;
+    auto cursor = unencoded.begin() + done;
+    out += (done / 3) * 4;
     uint32_t value;
-    auto cursor = unencoded.begin();
+
     for (size_t position = 0; position < size / 3; position++)
     {
         // Convert to big endian.
         value = (*cursor++) << 16;
-
         value += (*cursor++) << 8;
         value += (*cursor++);
-        encoded.append(1, table[(value & 0x00FC0000) >> 18]);
-        encoded.append(1, table[(value & 0x0003F000) >> 12]);
-        encoded.append(1, table[(value & 0x00000FC0) >> 6]);
-        encoded.append(1, table[(value & 0x0000003F) >> 0]);
+
+        *out++ = table[(value & 0x00FC0000) >> 18];
+        *out++ = table[(value & 0x0003F000) >> 12];
+        *out++ = table[(value & 0x00000FC0) >> 6];
+        *out++ = table[(value & 0x0000003F) >> 0];
     }
 
     switch (size % 3)
@@ -60,93 +326,119 @@ std::string encode_base64(data_slice unencoded)
             // Convert to big endian.
             value = (*cursor++) << 16;
 
-            encoded.append(1, table[(value & 0x00FC0000) >> 18]);
-            encoded.append(1, table[(value & 0x0003F000) >> 12]);
-            encoded.append(2, pad);
+            *out++ = table[(value & 0x00FC0000) >> 18];
+            *out++ = table[(value & 0x0003F000) >> 12];
+            *out++ = pad;
+            *out++ = pad;
             break;
         case 2:
             // Convert to big endian.
             value = (*cursor++) << 16;
-
             value += (*cursor++) << 8;
-            encoded.append(1, table[(value & 0x00FC0000) >> 18]);
-            encoded.append(1, table[(value & 0x0003F000) >> 12]);
-            encoded.append(1, table[(value & 0x00000FC0) >> 6]);
-            encoded.append(1, pad);
+
+            *out++ = table[(value & 0x00FC0000) >> 18];
+            *out++ = table[(value & 0x0003F000) >> 12];
+            *out++ = table[(value & 0x00000FC0) >> 6];
+            *out++ = pad;
             break;
     }
 
+    return out - start;
+}
+
+std::string encode_base64(data_slice unencoded)
+{
+    const auto size = unencoded.size();
+    std::string encoded(((size / 3) + (size % 3 > 0)) * 4, pad);
+    encode_base64(&encoded[0], unencoded);
     return encoded;
 }
 
-bool decode_base64(data_chunk& out, const std::string& in)
+bool decode_base64(uint8_t* out, size_t& out_size, const char* in,
+    size_t in_size)
 {
     const static uint32_t mask = 0x000000FF;
 
-    const auto length = in.length();
-    if ((length % 4) != 0)
+    if ((in_size % 4) != 0)
         return false;
 
     size_t padding = 0;
-    if (length > 0)
+    if (in_size > 0)
     {
-        if (in[length - 1] == pad)
+        if (in[in_size - 1] == pad)
             padding++;
-        if (in[length - 2] == pad)
+        if (in[in_size - 2] == pad)
             padding++;
     }
 
-    data_chunk decoded;
-    decoded.reserve(((length / 4) * 3) - padding);
+    // Pad characters may only terminate the final quantum.
+    if (padding == 1 && in[in_size - 2] == pad)
+        return false;
+
+    const auto unpadded = in_size - (padding == 0 ? 0 : 4);
+
+    bool valid;
+    const auto done = decode_vector(out, in, unpadded, valid);
+    if (!valid)
+        return false;
+
+    auto decode = out + (done / 4) * 3;
+    auto cursor = in + done;
+    const auto end = in + unpadded;
+
+    // Invalid characters are accumulated to avoid a branch per character.
+    int32_t invalid = 0;
+
+    while (cursor != end)
+    {
+        const auto first = from_base64(*cursor++);
+        const auto second = from_base64(*cursor++);
+        const auto third = from_base64(*cursor++);
+        const auto fourth = from_base64(*cursor++);
+        invalid |= first | second | third | fourth;
+
+        const auto value =
+            (uint32_t(first) << 18) | (uint32_t(second) << 12) |
+            (uint32_t(third) << 6) | uint32_t(fourth);
 
-    uint32_t value = 0;
-    for (auto cursor = in.begin(); cursor < in.end();)
+        *decode++ = (value >> 16) & mask;
+        *decode++ = (value >> 8) & mask;
+        *decode++ = (value >> 0) & mask;
+    }
+
+    // Handle 1 or 2 pad characters.
+    if (padding != 0)
     {
-        for (size_t position = 0; position < 4; position++)
-        {
-            value <<= 6;
-            if (*cursor >= 0x41 && *cursor <= 0x5A)
-                value |= *cursor - 0x41;
-            else if (*cursor >= 0x61 && *cursor <= 0x7A)
-                value |= *cursor - 0x47;
-            else if (*cursor >= 0x30 && *cursor <= 0x39)
-                value |= *cursor + 0x04;
-            else if (*cursor == 0x2B)
-                value |= 0x3E;
-            else if (*cursor == 0x2F)
-                value |= 0x3F;
-            else if (*cursor == pad)
-            {
-                // Handle 1 or 2 pad characters.
-                switch (in.end() - cursor)
-                {
-                    case 1:
-                        decoded.push_back((value >> 16) & mask);
-                        decoded.push_back((value >> 8) & mask);
-                        out = decoded;
-                        return true;
-                    case 2:
-                        decoded.push_back((value >> 10) & mask);
-                        out = decoded;
-                        return true;
-                    default:
-                        return false;
-                }
-            }
-            else
-                return false;
-
-            cursor++;
-        }
-
-        decoded.push_back((value >> 16) & mask);
-        decoded.push_back((value >> 8) & mask);
-        decoded.push_back((value >> 0) & mask);
+        const auto first = from_base64(*cursor++);
+        const auto second = from_base64(*cursor++);
+        const auto third = padding == 1 ? from_base64(*cursor) : 0;
+        invalid |= first | second | third;
+
+        const auto value = (uint32_t(first) << 18) |
+            (uint32_t(second) << 12) | (uint32_t(third) << 6);
+
+        *decode++ = (value >> 16) & mask;
+        if (padding == 1)
+            *decode++ = (value >> 8) & mask;
     }
 
-    out = decoded;
+    if (invalid < 0)
+        return false;
+
+    out_size = decode - out;
     return true;
 }
 
-} // namespace libbitcoin
+bool decode_base64(data_chunk& out, const std::string& in)
+{
+    size_t size;
+    data_chunk decoded((in.size() / 4) * 3);
+    if (!decode_base64(decoded.data(), size, in.data(), in.size()))
+        return false;
 
+    decoded.resize(size);
+    out = std::move(decoded);
+    return true;
+}
+
+} // namespace libbitcoin
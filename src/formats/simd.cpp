@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "simd.hpp"
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace libbitcoin {
+
+#ifdef BC_X86_SIMD
+
+#ifdef _MSC_VER
+
+static bool detect_ssse3()
+{
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+}
+
+static bool detect_avx2()
+{
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // The operating system must also save the ymm registers (osxsave, xcr0).
+    __cpuid(info, 1);
+    const auto osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+}
+
+#else
+
+// These also confirm operating system support for the ymm registers.
+static bool detect_ssse3()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3") != 0;
+}
+
+static bool detect_avx2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+}
+
+#endif
+
+// Detection is idempotent, so a racing first call is benign.
+bool have_ssse3()
+{
+    static const auto supported = detect_ssse3();
+    return supported;
+}
+
+bool have_avx2()
+{
+    static const auto supported = detect_avx2();
+    return supported;
+}
+
+#else
+
+bool have_ssse3()
+{
+    return false;
+}
+
+bool have_avx2()
+{
+    return false;
+}
+
+#endif
+
+} // namespace libbitcoin
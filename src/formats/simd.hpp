@@ -0,0 +1,53 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_FORMATS_SIMD_HPP
+#define LIBBITCOIN_FORMATS_SIMD_HPP
+
+// The x86 codec kernels are compiled per function for their instruction set
+// and selected at runtime, so the build flags and the supported platforms do
+// not change. Other platforms and older compilers use the table loops only.
+#if defined(_M_X64) || defined(_M_IX86)
+    #define BC_X86_SIMD
+    #define BC_TARGET(isa)
+#elif (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || \
+    (__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+    #define BC_X86_SIMD
+    #define BC_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#ifdef BC_X86_SIMD
+    #include <immintrin.h>
+#endif
+
+namespace libbitcoin {
+
+/**
+ * True if the processor and operating system support SSSE3.
+ */
+bool have_ssse3();
+
+/**
+ * True if the processor and operating system support AVX2.
+ */
+bool have_avx2();
+
+} // namespace libbitcoin
+
+#endif
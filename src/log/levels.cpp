@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/log/levels.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <bitcoin/bitcoin/log/severity.hpp>
+
+namespace libbitcoin {
+namespace log {
+
+// Channel names are immutable once published by the count, and levels are
+// atomic, so readers never lock. Writers are serialized by the mutex.
+struct channel_level
+{
+    std::string channel;
+    std::atomic<int> level;
+};
+
+static channel_level channels[levels::capacity];
+static std::atomic<size_t> count(0);
+static std::atomic<int> fallback(static_cast<int>(severity::debug));
+static boost::mutex mutex;
+
+std::atomic<int> levels::floor_(static_cast<int>(severity::debug));
+
+void levels::set(severity level)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    boost::lock_guard<boost::mutex> lock(mutex);
+    fallback.store(static_cast<int>(level), std::memory_order_relaxed);
+    set_floor();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+bool levels::set(const std::string& channel, severity level)
+{
+    const auto value = static_cast<int>(level);
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    boost::lock_guard<boost::mutex> lock(mutex);
+    const auto size = count.load(std::memory_order_relaxed);
+    const auto end = channels + size;
+    const auto match = [&](const channel_level& item)
+    {
+        return item.channel == channel;
+    };
+
+    const auto it = std::find_if(channels, end, match);
+
+    if (it != end)
+    {
+        it->level.store(value, std::memory_order_relaxed);
+    }
+    else if (size < capacity)
+    {
+        channels[size].channel = channel;
+        channels[size].level.store(value, std::memory_order_relaxed);
+        count.store(size + 1, std::memory_order_release);
+    }
+    else
+    {
+        return false;
+    }
+
+    set_floor();
+    return true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// private
+int levels::threshold(const char* channel)
+{
+    const auto size = count.load(std::memory_order_acquire);
+
+    for (size_t index = 0; index < size; ++index)
+        if (channels[index].channel == channel)
+            return channels[index].level.load(std::memory_order_relaxed);
+
+    return fallback.load(std::memory_order_relaxed);
+}
+
+// private
+// Called under the mutex.
+void levels::set_floor()
+{
+    auto lowest = fallback.load(std::memory_order_relaxed);
+    const auto size = count.load(std::memory_order_relaxed);
+
+    for (size_t index = 0; index < size; ++index)
+        lowest = std::min(lowest,
+            channels[index].level.load(std::memory_order_relaxed));
+
+    floor_.store(lowest, std::memory_order_relaxed);
+}
+
+} // namespace log
+} // namespace libbitcoin
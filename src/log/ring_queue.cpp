@@ -0,0 +1,329 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/log/ring_queue.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <boost/thread/locks.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+
+namespace libbitcoin {
+namespace log {
+
+// The capacity is rounded up to a power of two, of at least two cells.
+static size_t to_mask(size_t capacity)
+{
+    size_t size = 2;
+    while (size < capacity)
+        size <<= 1;
+
+    return size - 1;
+}
+
+ring_queue::ring_queue(size_t capacity, overflow policy)
+  : mask_(to_mask(capacity)),
+    policy_(policy),
+    cells_(new cell[mask_ + 1]),
+    head_(0),
+    tail_(0),
+    reader_waiting_(false),
+    writers_waiting_(0),
+    interrupted_(false),
+    closed_(false),
+    dirty_(false),
+    blocked_(0),
+    dropped_(0)
+{
+    for (size_t index = 0; index <= mask_; ++index)
+        cells_[index].sequence.store(index, std::memory_order_relaxed);
+}
+
+ring_queue::~ring_queue()
+{
+}
+
+void ring_queue::set_drained_handler(drained_handler handler)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    drained_ = std::move(handler);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+overflows ring_queue::overflow_counts() const
+{
+    return
+    {
+        blocked_.load(std::memory_order_relaxed),
+        dropped_.load(std::memory_order_relaxed)
+    };
+}
+
+void ring_queue::enqueue(const record_view& record)
+{
+    if (try_enqueue(record))
+        return;
+
+    if (policy_ == overflow::drop)
+    {
+        ++dropped_;
+        return;
+    }
+
+    ++blocked_;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    ++writers_waiting_;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Interruption of the reader (sink stop or flush) is not a release, as a
+    // flushing reader goes on to drain the ring. Only close releases.
+    auto pushed = false;
+    while (!(pushed = push(record)) && !closed_)
+        writable_.wait(lock);
+
+    --writers_waiting_;
+
+    // The mutex is held, so notify the reader directly.
+    if (pushed && reader_waiting_.load(std::memory_order_relaxed))
+        readable_.notify_one();
+    ///////////////////////////////////////////////////////////////////////////
+
+    if (!pushed)
+        ++dropped_;
+}
+
+bool ring_queue::try_enqueue(const record_view& record)
+{
+    if (!push(record))
+        return false;
+
+    notify_reader();
+    return true;
+}
+
+bool ring_queue::try_dequeue_ready(record_view& record)
+{
+    if (try_dequeue(record))
+    {
+        dirty_ = true;
+        return true;
+    }
+
+    // The ring has drained, flush what has been written since the last.
+    if (dirty_)
+    {
+        dirty_ = false;
+        drained_handler handler;
+
+        // Critical Section
+        ///////////////////////////////////////////////////////////////////////
+        {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            handler = drained_;
+        }
+        ///////////////////////////////////////////////////////////////////////
+
+        if (handler)
+            handler();
+    }
+
+    return false;
+}
+
+bool ring_queue::try_dequeue(record_view& record)
+{
+    if (!pop(record))
+        return false;
+
+    notify_writers();
+    return true;
+}
+
+bool ring_queue::dequeue_ready(record_view& record)
+{
+    while (true)
+    {
+        if (try_dequeue(record))
+        {
+            dirty_ = true;
+            return true;
+        }
+
+        // Critical Section
+        ///////////////////////////////////////////////////////////////////////
+        boost::unique_lock<boost::mutex> lock(mutex_);
+
+        if (interrupted_)
+        {
+            interrupted_ = false;
+            return false;
+        }
+
+        reader_waiting_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // Recheck after publishing the flag, a producer may have just pushed.
+        const auto ready = pop(record);
+
+        if (!ready)
+            readable_.wait(lock);
+
+        reader_waiting_.store(false, std::memory_order_relaxed);
+
+        // The mutex is held, so notify blocked producers directly.
+        if (ready && writers_waiting_.load(std::memory_order_relaxed) != 0)
+            writable_.notify_all();
+        ///////////////////////////////////////////////////////////////////////
+
+        if (ready)
+        {
+            dirty_ = true;
+            return true;
+        }
+    }
+}
+
+void ring_queue::interrupt_dequeue()
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    interrupted_ = true;
+    readable_.notify_one();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void ring_queue::close()
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    closed_ = true;
+    writable_.notify_all();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// private
+// Bounded multiple producer queue (after Dmitry Vyukov), false if full.
+bool ring_queue::push(const record_view& record)
+{
+    auto position = tail_.load(std::memory_order_relaxed);
+    cell* slot;
+
+    while (true)
+    {
+        slot = &cells_[position & mask_];
+        const auto sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<ptrdiff_t>(sequence - position);
+
+        if (difference == 0)
+        {
+            if (tail_.compare_exchange_weak(position, position + 1,
+                std::memory_order_relaxed))
+                break;
+        }
+        else if (difference < 0)
+        {
+            return false;
+        }
+        else
+        {
+            position = tail_.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->record = record;
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+// private
+// The cell is released for reuse one lap ahead, false if empty.
+bool ring_queue::pop(record_view& record)
+{
+    auto position = head_.load(std::memory_order_relaxed);
+    cell* slot;
+
+    while (true)
+    {
+        slot = &cells_[position & mask_];
+        const auto sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<ptrdiff_t>(sequence -
+            (position + 1));
+
+        if (difference == 0)
+        {
+            if (head_.compare_exchange_weak(position, position + 1,
+                std::memory_order_relaxed))
+                break;
+        }
+        else if (difference < 0)
+        {
+            return false;
+        }
+        else
+        {
+            position = head_.load(std::memory_order_relaxed);
+        }
+    }
+
+    record.swap(slot->record);
+    slot->record = record_view();
+    slot->sequence.store(position + mask_ + 1, std::memory_order_release);
+    return true;
+}
+
+// private
+void ring_queue::notify_reader()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (!reader_waiting_.load(std::memory_order_relaxed))
+        return;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    readable_.notify_one();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// private
+void ring_queue::notify_writers()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (writers_waiting_.load(std::memory_order_relaxed) == 0)
+        return;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    writable_.notify_all();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+} // namespace log
+} // namespace libbitcoin
@@ -19,8 +19,10 @@
  */
 #include <bitcoin/bitcoin/log/sinks.hpp>
 
+#include <functional>
 #include <map>
 #include <string>
+#include <vector>
 #include <boost/log/attributes.hpp>
 #include <boost/log/common.hpp>
 #include <boost/log/core.hpp>
@@ -28,8 +30,11 @@
 #include <boost/log/sinks.hpp>
 #include <boost/log/support/date_time.hpp>
 #include <boost/smart_ptr/make_shared.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
 #include <bitcoin/bitcoin/log/attributes.hpp>
 #include <bitcoin/bitcoin/log/file_collector_repository.hpp>
+#include <bitcoin/bitcoin/log/ring_queue.hpp>
 #include <bitcoin/bitcoin/log/severity.hpp>
 #include <bitcoin/bitcoin/unicode/ofstream.hpp>
 
@@ -57,6 +62,34 @@ using namespace boost::posix_time;
 
 typedef synchronous_sink<text_file_backend> text_file_sink;
 typedef synchronous_sink<text_ostream_backend> text_stream_sink;
+typedef asynchronous_sink<text_file_backend, ring_queue>
+    asynchronous_text_file_sink;
+typedef asynchronous_sink<text_ostream_backend, ring_queue>
+    asynchronous_text_stream_sink;
+
+// An asynchronous sink, retained for overflow counts and teardown.
+struct retained_sink
+{
+    boost::shared_ptr<ring_queue> queue;
+    boost::shared_ptr<sink> base;
+    std::function<void()> stop;
+};
+
+// Release blocked producers if the sinks are never stopped, so that no
+// producer can block the writer threads from joining at static destruction.
+struct retained_sinks
+  : public std::vector<retained_sink>
+{
+    ~retained_sinks()
+    {
+        for (const auto& retained: *this)
+            retained.queue->close();
+    }
+};
+
+static retained_sinks queues;
+static overflows stopped_counts{ 0, 0 };
+static boost::mutex queues_mutex;
 
 const auto error_filter =
     (attributes::severity == severity::warning) ||
@@ -91,12 +124,10 @@ static boost::shared_ptr<collector> file_collector(
         rotation.maximum_files);
 }
 
-static boost::shared_ptr<text_file_sink> add_text_file_sink(
-    const rotable_file& rotation)
+static boost::shared_ptr<text_file_backend> make_text_file_backend(
+    const rotable_file& rotation, bool auto_flush)
 {
-    // Construct a log sink.
-    const auto sink = boost::make_shared<text_file_sink>();
-    const auto backend = sink->locked_backend();
+    const auto backend = boost::make_shared<text_file_backend>();
 
     // Add a file stream for the sink to write to.
     backend->set_file_name_pattern(rotation.original_log);
@@ -108,31 +139,28 @@ static boost::shared_ptr<text_file_sink> add_text_file_sink(
         backend->set_file_collector(file_collector(rotation));
     }
 
-    // Flush the sink after each logical line.
-    backend->auto_flush(true);
-
-    // Add the formatter to the sink.
-    sink->set_formatter(LINE_FORMATTER);
-
-    // Register the sink with the logging core.
-    boost::log::core::get()->add_sink(sink);
-    return sink;
+    // Flush the sink after each logical line, or as a buffer drains.
+    backend->auto_flush(auto_flush);
+    return backend;
 }
 
 template<typename Stream>
-static boost::shared_ptr<text_stream_sink> add_text_stream_sink(
-    boost::shared_ptr<Stream>& stream)
+static boost::shared_ptr<text_ostream_backend> make_text_stream_backend(
+    boost::shared_ptr<Stream>& stream, bool auto_flush)
 {
-    // Construct a log sink.
-    const auto sink = boost::make_shared<text_stream_sink>();
-    const auto backend = sink->locked_backend();
+    const auto backend = boost::make_shared<text_ostream_backend>();
 
     // Add a stream for the sink to write to.
     backend->add_stream(stream);
 
-    // Flush the sink after each logical line.
-    backend->auto_flush(true);
+    // Flush the sink after each logical line, or as a buffer drains.
+    backend->auto_flush(auto_flush);
+    return backend;
+}
 
+template<typename Sink>
+static boost::shared_ptr<Sink> add_sink(const boost::shared_ptr<Sink>& sink)
+{
     // Add the formatter to the sink.
     sink->set_formatter(LINE_FORMATTER);
 
@@ -141,6 +169,63 @@ static boost::shared_ptr<text_stream_sink> add_text_stream_sink(
     return sink;
 }
 
+template<typename Sink, typename Backend>
+static boost::shared_ptr<Sink> add_asynchronous_sink(
+    const boost::shared_ptr<Backend>& backend, const asynchronous& buffer)
+{
+    // Construct a log sink, which starts its writer thread.
+    const auto sink = boost::make_shared<Sink>(backend,
+        boost::log::keywords::capacity = buffer.capacity,
+        boost::log::keywords::overflow_policy = buffer.policy);
+
+    // Flush the backend once per batch, on the writer thread.
+    const auto raw = sink.get();
+    sink->set_drained_handler([raw]()
+    {
+        raw->locked_backend()->flush();
+    });
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    boost::lock_guard<boost::mutex> lock(queues_mutex);
+    queues.push_back({ sink, sink, [raw]() { raw->stop(); } });
+    ///////////////////////////////////////////////////////////////////////////
+
+    return add_sink(sink);
+}
+
+static boost::shared_ptr<text_file_sink> add_text_file_sink(
+    const rotable_file& rotation)
+{
+    const auto backend = make_text_file_backend(rotation, true);
+    return add_sink(boost::make_shared<text_file_sink>(backend));
+}
+
+template<typename Stream>
+static boost::shared_ptr<text_stream_sink> add_text_stream_sink(
+    boost::shared_ptr<Stream>& stream)
+{
+    const auto backend = make_text_stream_backend(stream, true);
+    return add_sink(boost::make_shared<text_stream_sink>(backend));
+}
+
+static boost::shared_ptr<asynchronous_text_file_sink> add_text_file_sink(
+    const rotable_file& rotation, const asynchronous& buffer)
+{
+    const auto backend = make_text_file_backend(rotation, false);
+    return add_asynchronous_sink<asynchronous_text_file_sink>(backend,
+        buffer);
+}
+
+template<typename Stream>
+static boost::shared_ptr<asynchronous_text_stream_sink> add_text_stream_sink(
+    boost::shared_ptr<Stream>& stream, const asynchronous& buffer)
+{
+    const auto backend = make_text_stream_backend(stream, false);
+    return add_asynchronous_sink<asynchronous_text_stream_sink>(backend,
+        buffer);
+}
+
 void initialize(log::file& debug_file, log::file& error_file,
     log::stream& output_stream, log::stream& error_stream)
 {
@@ -159,5 +244,89 @@ void initialize(const rotable_file& debug_file, const rotable_file& error_file,
     add_text_stream_sink(error_stream)->set_filter(error_filter);
 }
 
+void initialize(log::file& debug_file, log::file& error_file,
+    log::stream& output_stream, log::stream& error_stream,
+    const asynchronous& buffer)
+{
+    add_text_stream_sink(debug_file, buffer);
+    add_text_stream_sink(error_file, buffer)->set_filter(error_filter);
+    add_text_stream_sink(output_stream, buffer)->set_filter(info_filter);
+    add_text_stream_sink(error_stream, buffer)->set_filter(error_filter);
+}
+
+void initialize(const rotable_file& debug_file, const rotable_file& error_file,
+    log::stream& output_stream, log::stream& error_stream,
+    const asynchronous& buffer)
+{
+    add_text_file_sink(debug_file, buffer);
+    add_text_file_sink(error_file, buffer)->set_filter(error_filter);
+    add_text_stream_sink(output_stream, buffer)->set_filter(info_filter);
+    add_text_stream_sink(error_stream, buffer)->set_filter(error_filter);
+}
+
+overflows overflow_counts()
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    boost::lock_guard<boost::mutex> lock(queues_mutex);
+    auto counts = stopped_counts;
+
+    for (const auto& retained: queues)
+    {
+        const auto sink = retained.queue->overflow_counts();
+        counts.blocked += sink.blocked;
+        counts.dropped += sink.dropped;
+    }
+
+    return counts;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void flush()
+{
+    boost::log::core::get()->flush();
+}
+
+void stop()
+{
+    std::vector<retained_sink> stopping;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    {
+        boost::lock_guard<boost::mutex> lock(queues_mutex);
+        stopping.swap(queues);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+
+    const auto core = boost::log::core::get();
+
+    // A flush does not release producers blocked on a full ring, and the
+    // writer may never free space, so release them before flushing.
+    for (const auto& retained: stopping)
+    {
+        core->remove_sink(retained.base);
+        retained.queue->close();
+    }
+
+    for (const auto& retained: stopping)
+    {
+        retained.base->flush();
+        retained.stop();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    boost::lock_guard<boost::mutex> lock(queues_mutex);
+
+    for (const auto& retained: stopping)
+    {
+        const auto sink = retained.queue->overflow_counts();
+        stopped_counts.blocked += sink.blocked;
+        stopped_counts.dropped += sink.dropped;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+}
+
 } // namespace log
 } // namespace libbitcoin
@@ -35,12 +35,11 @@
 #include <bitcoin/bitcoin/compat.h>
 #include "pbkdf2_sha256.h"
 
-static void blkcpy(uint8_t*, uint8_t*, size_t);
-static void blkxor(uint8_t*, uint8_t*, size_t);
-static void salsa20_8(uint8_t[64]);
-static void blockmix_salsa8(uint8_t*, uint8_t*, size_t);
-static uint64_t integerify(uint8_t*, size_t);
-static void smix(uint8_t* , size_t, uint64_t, uint8_t*, uint8_t*);
+static void blkcpy(uint32_t*, const uint32_t*, size_t);
+static void blkxor(uint32_t*, const uint32_t*, size_t);
+static void salsa20_8(uint32_t[16]);
+static void blockmix_salsa8(uint32_t*, uint32_t*, size_t);
+static uint64_t integerify(const uint32_t*, size_t);
 
 static BC_C_INLINE uint32_t le32dec(const void* pp)
 {
@@ -58,18 +57,8 @@ static BC_C_INLINE void le32enc(void* pp, uint32_t x)
     p[3] = (x >> 24) & 0xff;
 }
 
-static BC_C_INLINE uint64_t le64dec(const void* pp)
-{
-    const uint8_t* p = (uint8_t const* )pp;
-
-    return ((uint64_t)(p[0]) + ((uint64_t)(p[1]) << 8) +
-            ((uint64_t)(p[2]) << 16) + ((uint64_t)(p[3]) << 24) +
-            ((uint64_t)(p[4]) << 32) + ((uint64_t)(p[5]) << 40) +
-            ((uint64_t)(p[6]) << 48) + ((uint64_t)(p[7]) << 56));
-}
-
-
-static void blkcpy(uint8_t* dest, uint8_t* src, size_t len)
+/* Blocks are processed as host order words, lengths are in words. */
+static void blkcpy(uint32_t* dest, const uint32_t* src, size_t len)
 {
     size_t i;
 
@@ -77,7 +66,7 @@ static void blkcpy(uint8_t* dest, uint8_t* src, size_t len)
         dest[i] = src[i];
 }
 
-static void blkxor(uint8_t* dest, uint8_t* src, size_t len)
+static void blkxor(uint32_t* dest, const uint32_t* src, size_t len)
 {
     size_t i;
 
@@ -87,21 +76,17 @@ static void blkxor(uint8_t* dest, uint8_t* src, size_t len)
 
 /**
  * salsa20_8(B):
- * Apply the salsa20/8 core to the provided block.
+ * Apply the salsa20/8 core to the provided block of host order words.
+ * Words are decoded once per smix, not once per core invocation.
  */
-static void salsa20_8(uint8_t B[64])
+static void salsa20_8(uint32_t B[16])
 {
-    uint32_t B32[16];
     uint32_t x[16];
     size_t i;
 
-    /* Convert little-endian values in. */
+    /* Compute x = doubleround^4(B). */
     for (i = 0; i < 16; i++)
-        B32[i] = le32dec(&B[i * 4]);
-
-    /* Compute x = doubleround^4(B32). */
-    for (i = 0; i < 16; i++)
-        x[i] = B32[i];
+        x[i] = B[i];
     for (i = 0; i < 8; i += 2) {
 #define R(a,b) (((a) << (b)) | ((a) >> (32 - (b))))
         /* Operate on columns. */
@@ -132,77 +117,68 @@ static void salsa20_8(uint8_t B[64])
 #undef R
     }
 
-    /* Compute B32 = B32 + x. */
-    for (i = 0; i < 16; i++)
-        B32[i] += x[i];
-
-    /* Convert little-endian values out. */
+    /* Compute B = B + x. */
     for (i = 0; i < 16; i++)
-        le32enc(&B[4 * i], B32[i]);
+        B[i] += x[i];
 }
 
 /**
  * blockmix_salsa8(B, Y, r):
- * Compute B = BlockMix_{salsa20/8, r}(B).  The input B must be 128r bytes in
+ * Compute B = BlockMix_{salsa20/8, r}(B).  The input B must be 32r words in
  * length; the temporary space Y must also be the same size.
  */
-static void blockmix_salsa8(uint8_t* B, uint8_t* Y, size_t r)
+static void blockmix_salsa8(uint32_t* B, uint32_t* Y, size_t r)
 {
-    uint8_t X[64];
+    uint32_t X[16];
     size_t i;
 
     /* 1: X <-- B_{2r - 1} */
-    blkcpy(X, &B[(2 * r - 1) * 64], 64);
+    blkcpy(X, &B[(2 * r - 1) * 16], 16);
 
     /* 2: for i = 0 to 2r - 1 do */
     for (i = 0; i < 2 * r; i++) {
         /* 3: X <-- H(X \xor B_i) */
-        blkxor(X, &B[i * 64], 64);
+        blkxor(X, &B[i * 16], 16);
         salsa20_8(X);
 
         /* 4: Y_i <-- X */
-        blkcpy(&Y[i * 64], X, 64);
+        blkcpy(&Y[i * 16], X, 16);
     }
 
     /* 6: B' <-- (Y_0, Y_2 ... Y_{2r-2}, Y_1, Y_3 ... Y_{2r-1}) */
     for (i = 0; i < r; i++)
-        blkcpy(&B[i * 64], &Y[(i * 2) * 64], 64);
+        blkcpy(&B[i * 16], &Y[(i * 2) * 16], 16);
     for (i = 0; i < r; i++)
-        blkcpy(&B[(i + r) * 64], &Y[(i * 2 + 1) * 64], 64);
+        blkcpy(&B[(i + r) * 16], &Y[(i * 2 + 1) * 16], 16);
 }
 
 /**
  * integerify(B, r):
  * Return the result of parsing B_{2r-1} as a little-endian integer.
  */
-static uint64_t integerify(uint8_t* B, size_t r)
+static uint64_t integerify(const uint32_t* B, size_t r)
 {
-    uint8_t* X = &B[(2 * r - 1) * 64];
+    const uint32_t* X = &B[(2 * r - 1) * 16];
 
-    return (le64dec(X));
+    return (((uint64_t)(X[1]) << 32) + X[0]);
 }
 
-/**
- * smix(B, r, N, V, XY):
- * Compute B = SMix_r(B, N).  The input B must be 128r bytes in length; the
- * temporary storage V must be 128rN bytes in length; the temporary storage
- * XY must be 256r bytes in length.  The value N must be a power of 2.
- */
-static void smix(uint8_t* B, size_t r,
-    uint64_t N, uint8_t* V, uint8_t* XY)
+void crypto_scrypt_smix(uint8_t* B, size_t r, uint64_t N, uint32_t* V,
+    uint32_t* XY)
 {
-    uint8_t* X = XY;
-    uint8_t* Y = &XY[128 * r];
+    uint32_t* X = XY;
+    uint32_t* Y = &XY[32 * r];
     uint64_t i;
     uint64_t j;
 
     /* 1: X <-- B */
-    blkcpy(X, B, 128 * r);
+    for (i = 0; i < 32 * r; i++)
+        X[i] = le32dec(&B[4 * i]);
 
     /* 2: for i = 0 to N - 1 do */
     for (i = 0; i < N; i++) {
         /* 3: V_i <-- X */
-        blkcpy(&V[i * (128 * r)], X, 128 * r);
+        blkcpy(&V[i * (32 * r)], X, 32 * r);
 
         /* 4: X <-- H(X) */
         blockmix_salsa8(X, Y, r);
@@ -214,12 +190,13 @@ static void smix(uint8_t* B, size_t r,
         j = integerify(X, r) & (N - 1);
 
         /* 8: X <-- H(X \xor V_j) */
-        blkxor(X, &V[j * (128 * r)], 128 * r);
+        blkxor(X, &V[j * (32 * r)], 32 * r);
         blockmix_salsa8(X, Y, r);
     }
 
     /* 10: B' <-- X */
-    blkcpy(B, X, 128 * r);
+    for (i = 0; i < 32 * r; i++)
+        le32enc(&B[4 * i], X[i]);
 }
 
 /**
@@ -236,8 +213,8 @@ int crypto_scrypt(const uint8_t* passphrase, size_t passphrase_length,
     uint32_t r, uint32_t p, uint8_t* buf, size_t buf_length)
 {
     uint8_t* B;
-    uint8_t* V;
-    uint8_t* XY;
+    uint32_t* V;
+    uint32_t* XY;
     uint32_t i;
 
     /* Sanity-check parameters. */
@@ -279,7 +256,7 @@ int crypto_scrypt(const uint8_t* passphrase, size_t passphrase_length,
     /* 2: for i = 0 to p - 1 do */
     for (i = 0; i < p; i++) {
         /* 3: B_i <-- MF(B_i, N) */
-        smix(&B[i * 128 * r], r, N, V, XY);
+        crypto_scrypt_smix(&B[i * 128 * r], r, N, V, XY);
     }
 
     /* 5: DK <-- PBKDF2(P, B, 1, dkLen) */
@@ -50,6 +50,16 @@ int crypto_scrypt(const uint8_t* passphrase, size_t passphrase_length,
     const uint8_t* salt, size_t salt_length, uint64_t N, uint32_t r,
     uint32_t p, uint8_t* buf, size_t buf_length);
 
+/**
+ * crypto_scrypt_smix(B, r, N, V, XY):
+ * Compute B = SMix_r(B, N).  The input B must be 128r bytes in length; the
+ * temporary storage V must be 32rN words in length; the temporary storage
+ * XY must be 64r words in length.  The value N must be a power of 2.
+ * Distinct V and XY allow independent lanes to be mixed concurrently.
+ */
+void crypto_scrypt_smix(uint8_t* B, size_t r, uint64_t N, uint32_t* V,
+    uint32_t* XY);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,50 +18,59 @@
 
 #include <stddef.h>
 #include <stdint.h>
-#include <stdlib.h>
 #include <string.h>
 #include "hmac_sha512.h"
+#include "sha512.h"
 #include "zeroize.h"
 
+/* The length in bits of a key block followed by a digest, as hashed by each
+ * (inner and outer) iteration of hmac over a single digest. */
+#define ITERATION_BITS ((SHA512_BLOCK_LENGTH + SHA512_DIGEST_LENGTH) * 8U)
+#define DIGEST_WORDS (SHA512_DIGEST_LENGTH / 8U)
+
+static void encode_count(uint8_t count_bytes[4], size_t count)
+{
+    count_bytes[0] = (count >> 24) & 0xff;
+    count_bytes[1] = (count >> 16) & 0xff;
+    count_bytes[2] = (count >> 8) & 0xff;
+    count_bytes[3] = (count >> 0) & 0xff;
+}
+
 int pkcs5_pbkdf2(const uint8_t* passphrase, size_t passphrase_length,
     const uint8_t* salt, size_t salt_length, uint8_t* key, size_t key_length,
     size_t iterations)
 {
-    uint8_t* asalt;
-    size_t asalt_size;
     size_t count, index, iteration, length;
+    uint8_t count_bytes[4];
     uint8_t buffer[HMACSHA512_DIGEST_LENGTH];
-    uint8_t digest1[HMACSHA512_DIGEST_LENGTH];
-    uint8_t digest2[HMACSHA512_DIGEST_LENGTH];
+    uint8_t digest[HMACSHA512_DIGEST_LENGTH];
+    HMACSHA512CTX keyed;
+    HMACSHA512CTX context;
 
     /* An iteration count of 0 is equivalent to a count of 1. */
     /* A key_length of 0 is a no-op. */
     /* A salt_length of 0 is perfectly valid. */
 
-    if (salt_length > SIZE_MAX - 4)
-        return -1;
-    asalt_size = salt_length + 4;
-    asalt = malloc(asalt_size);
-    if (asalt == NULL)
-        return -1;
+    /* The key schedule (inner and outer midstates) is computed once and */
+    /* copied for each hmac, saving two compressions per iteration. */
+    HMACSHA512Init(&keyed, passphrase, passphrase_length);
 
-    memcpy(asalt, salt, salt_length);
     for (count = 1; key_length > 0; count++)
     {
-        asalt[salt_length + 0] = (count >> 24) & 0xff;
-        asalt[salt_length + 1] = (count >> 16) & 0xff;
-        asalt[salt_length + 2] = (count >> 8) & 0xff;
-        asalt[salt_length + 3] = (count >> 0) & 0xff;
-        HMACSHA512(asalt, asalt_size, passphrase, passphrase_length, digest1);
-        memcpy(buffer, digest1, sizeof(buffer));
+        encode_count(count_bytes, count);
+        context = keyed;
+        HMACSHA512Update(&context, salt, salt_length);
+        HMACSHA512Update(&context, count_bytes, sizeof(count_bytes));
+        HMACSHA512Final(&context, digest);
+        memcpy(buffer, digest, sizeof(buffer));
 
         for (iteration = 1; iteration < iterations; iteration++)
         {
-            HMACSHA512(digest1, sizeof(digest1), passphrase, passphrase_length,
-                digest2);
-            memcpy(digest1, digest2, sizeof(digest1));
+            context = keyed;
+            HMACSHA512Update(&context, digest, sizeof(digest));
+            HMACSHA512Final(&context, digest);
             for (index = 0; index < sizeof(buffer); index++)
-                buffer[index] ^= digest1[index];
+                buffer[index] ^= digest[index];
         }
 
         length = (key_length < sizeof(buffer) ? key_length : sizeof(buffer));
@@ -70,11 +79,118 @@ int pkcs5_pbkdf2(const uint8_t* passphrase, size_t passphrase_length,
         key_length -= length;
     };
 
-    zeroize(digest1, sizeof(digest1));
-    zeroize(digest2, sizeof(digest2));
+    zeroize(digest, sizeof(digest));
+    zeroize(buffer, sizeof(buffer));
+    zeroize(&keyed, sizeof(keyed));
+    zeroize(&context, sizeof(context));
+
+    return 0;
+}
+
+static uint64_t load64_be(const uint8_t* bytes)
+{
+    size_t index;
+    uint64_t value = 0;
+
+    for (index = 0; index < 8; index++)
+        value = (value << 8) | bytes[index];
+
+    return value;
+}
+
+static void store64_be(uint8_t* bytes, uint64_t value)
+{
+    size_t index;
+
+    for (index = 0; index < 8; index++)
+        bytes[index] = (value >> (56 - 8 * index)) & 0xff;
+}
+
+/* Set the constant padding of a block holding a single digest. */
+static void pad_lanes(uint64_t block[SHA512_BLOCK_WORDS][SHA512_LANES])
+{
+    size_t word, lane;
+
+    for (lane = 0; lane < SHA512_LANES; lane++)
+    {
+        block[DIGEST_WORDS][lane] = 0x8000000000000000ULL;
+
+        for (word = DIGEST_WORDS + 1; word < SHA512_BLOCK_WORDS - 1; word++)
+            block[word][lane] = 0;
+
+        block[SHA512_BLOCK_WORDS - 1][lane] = ITERATION_BITS;
+    }
+}
+
+int pkcs5_pbkdf2_lanes(const uint8_t* const* passphrases,
+    const size_t* passphrase_lengths, const uint8_t* salt, size_t salt_length,
+    uint8_t* keys, size_t iterations)
+{
+    size_t lane, word, iteration;
+    uint8_t count_bytes[4];
+    uint8_t digest[HMACSHA512_DIGEST_LENGTH];
+    uint64_t inner[SHA512_STATE_LENGTH][SHA512_LANES];
+    uint64_t outer[SHA512_STATE_LENGTH][SHA512_LANES];
+    uint64_t state[SHA512_STATE_LENGTH][SHA512_LANES];
+    uint64_t block[SHA512_BLOCK_WORDS][SHA512_LANES];
+    uint64_t buffer[DIGEST_WORDS][SHA512_LANES];
+    HMACSHA512CTX context;
+
+    /* The first iteration hashes the salt, which is of arbitrary length. */
+    encode_count(count_bytes, 1);
+
+    for (lane = 0; lane < SHA512_LANES; lane++)
+    {
+        HMACSHA512Init(&context, passphrases[lane], passphrase_lengths[lane]);
+
+        /* The midstates follow exactly one block each (the padded key). */
+        for (word = 0; word < SHA512_STATE_LENGTH; word++)
+        {
+            inner[word][lane] = context.ictx.state[word];
+            outer[word][lane] = context.octx.state[word];
+        }
+
+        HMACSHA512Update(&context, salt, salt_length);
+        HMACSHA512Update(&context, count_bytes, sizeof(count_bytes));
+        HMACSHA512Final(&context, digest);
+
+        for (word = 0; word < DIGEST_WORDS; word++)
+        {
+            block[word][lane] = load64_be(digest + 8 * word);
+            buffer[word][lane] = block[word][lane];
+        }
+    }
+
+    /* Subsequent iterations hash one digest, a single fixed-format block. */
+    pad_lanes(block);
+
+    for (iteration = 1; iteration < iterations; iteration++)
+    {
+        memcpy(state, inner, sizeof(state));
+        SHA512TransformLanes(state, (const uint64_t(*)[SHA512_LANES])block);
+        memcpy(block, state, sizeof(state));
+
+        memcpy(state, outer, sizeof(state));
+        SHA512TransformLanes(state, (const uint64_t(*)[SHA512_LANES])block);
+        memcpy(block, state, sizeof(state));
+
+        for (word = 0; word < DIGEST_WORDS; word++)
+            for (lane = 0; lane < SHA512_LANES; lane++)
+                buffer[word][lane] ^= block[word][lane];
+    }
+
+    for (lane = 0; lane < SHA512_LANES; lane++)
+        for (word = 0; word < DIGEST_WORDS; word++)
+            store64_be(keys + lane * SHA512_DIGEST_LENGTH + 8 * word,
+                buffer[word][lane]);
+
+    zeroize(digest, sizeof(digest));
+    zeroize(inner, sizeof(inner));
+    zeroize(outer, sizeof(outer));
+    zeroize(state, sizeof(state));
+    zeroize(block, sizeof(block));
     zeroize(buffer, sizeof(buffer));
-    zeroize(asalt, asalt_size);
-    free(asalt);
+    zeroize(&context, sizeof(context));
 
     return 0;
 }
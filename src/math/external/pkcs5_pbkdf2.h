@@ -33,6 +33,13 @@ int pkcs5_pbkdf2(const uint8_t* passphrase, size_t passphrase_length,
     const uint8_t* salt, size_t salt_length, uint8_t* key, size_t key_length,
     size_t iterations);
 
+/* Derive one digest-length key for each of SHA512_LANES passphrases, with a
+ * common salt, computing the lanes together. */
+/* returns 0 if successful. */
+int pkcs5_pbkdf2_lanes(const uint8_t* const* passphrases,
+    const size_t* passphrase_lengths, const uint8_t* salt, size_t salt_length,
+    uint8_t* keys, size_t iterations);
+
 #ifdef __cplusplus
 }
 #endif
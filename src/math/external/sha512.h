@@ -33,6 +33,8 @@
 #define SHA512_COUNT_LENGTH 2U
 #define SHA512_BLOCK_LENGTH 128U
 #define SHA512_DIGEST_LENGTH 64U
+#define SHA512_BLOCK_WORDS 16U
+#define SHA512_LANES 4U
 
 #ifdef __cplusplus
 extern "C" 
@@ -53,6 +55,11 @@ void SHA512Init(SHA512CTX* context);
 void SHA512Update(SHA512CTX* context, const uint8_t* input, size_t length);
 void SHA512Final(SHA512CTX* context, uint8_t digest[SHA512_DIGEST_LENGTH]);
 
+/* Transform independent states by word blocks, with words interleaved by
+ * lane so that each round may be vectorized across lanes. */
+void SHA512TransformLanes(uint64_t state[SHA512_STATE_LENGTH][SHA512_LANES],
+    const uint64_t block[SHA512_BLOCK_WORDS][SHA512_LANES]);
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,17 +22,23 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <errno.h>
 #include <new>
 #include <stdexcept>
+#include <vector>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include "../math/external/crypto_scrypt.h"
 #include "../math/external/hmac_sha256.h"
 #include "../math/external/hmac_sha512.h"
+#include "../math/external/pbkdf2_sha256.h"
 #include "../math/external/pkcs5_pbkdf2.h"
 #include "../math/external/ripemd160.h"
 #include "../math/external/sha1.h"
 #include "../math/external/sha256.h"
 #include "../math/external/sha512.h"
+#include "../math/external/zeroize.h"
 
 namespace libbitcoin {
 
@@ -89,6 +95,33 @@ long_hash hmac_sha512_hash(data_slice data, data_slice key)
     return hash;
 }
 
+static_assert(sizeof(HMACSHA512CTX) <= sizeof(std::array<uint64_t, 52>),
+    "hmac_sha512_context storage is insufficient");
+
+hmac_sha512_context::hmac_sha512_context(data_slice key)
+{
+    HMACSHA512CTX context;
+    HMACSHA512Init(&context, key.data(), key.size());
+    std::memcpy(context_.data(), &context, sizeof(context));
+    zeroize(&context, sizeof(context));
+}
+
+hmac_sha512_context::~hmac_sha512_context()
+{
+    zeroize(context_.data(), sizeof(context_));
+}
+
+long_hash hmac_sha512_context::hash(data_slice data) const
+{
+    // Copying the keyed state saves two compressions over HMACSHA512.
+    long_hash hash;
+    HMACSHA512CTX context;
+    std::memcpy(&context, context_.data(), sizeof(context));
+    HMACSHA512Update(&context, data.data(), data.size());
+    HMACSHA512Final(&context, hash.data());
+    return hash;
+}
+
 long_hash pkcs5_pbkdf2_hmac_sha512(data_slice passphrase,
     data_slice salt, size_t iterations)
 {
@@ -102,6 +135,43 @@ long_hash pkcs5_pbkdf2_hmac_sha512(data_slice passphrase,
     return hash;
 }
 
+long_hash_list pkcs5_pbkdf2_hmac_sha512(const data_stack& passphrases,
+    data_slice salt, size_t iterations)
+{
+    long_hash_list hashes(passphrases.size());
+    const uint8_t* lane_passphrases[SHA512_LANES];
+    size_t lane_sizes[SHA512_LANES];
+    uint8_t lane_hashes[SHA512_LANES * long_hash_size];
+
+    for (size_t first = 0; first < passphrases.size(); first += SHA512_LANES)
+    {
+        const auto lanes = std::min(passphrases.size() - first,
+            size_t(SHA512_LANES));
+
+        // A partial group fills its unused lanes with the last passphrase.
+        for (size_t lane = 0; lane < SHA512_LANES; ++lane)
+        {
+            const auto& passphrase = passphrases[first +
+                std::min(lane, lanes - 1)];
+            lane_passphrases[lane] = passphrase.data();
+            lane_sizes[lane] = passphrase.size();
+        }
+
+        const auto result = pkcs5_pbkdf2_lanes(lane_passphrases, lane_sizes,
+            salt.data(), salt.size(), lane_hashes, iterations);
+
+        if (result != 0)
+            throw std::bad_alloc();
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+            std::copy_n(&lane_hashes[lane * long_hash_size], long_hash_size,
+                hashes[first + lane].begin());
+    }
+
+    zeroize(lane_hashes, sizeof(lane_hashes));
+    return hashes;
+}
+
 hash_digest bitcoin_hash(data_slice data)
 {
     return sha256_hash(sha256_hash(data));
@@ -140,4 +210,107 @@ data_chunk scrypt(data_slice data, data_slice salt, uint64_t N, uint32_t p,
     return output;
 }
 
+// scrypt_arena
+// ----------------------------------------------------------------------------
+
+scrypt_arena::scrypt_arena()
+  : pool_(nullptr), memory_(1)
+{
+}
+
+scrypt_arena::scrypt_arena(threadpool& pool, size_t lanes)
+  : pool_(&pool), memory_(std::max(lanes, size_t(1)))
+{
+}
+
+scrypt_arena::~scrypt_arena()
+{
+    for (auto& lane: memory_)
+        zeroize(lane.data(), lane.size() * sizeof(uint32_t));
+}
+
+size_t scrypt_arena::lanes() const
+{
+    return memory_.size();
+}
+
+// private
+void scrypt_arena::reserve(size_t words)
+{
+    // Memory is retained at its high water mark for reuse by later calls.
+    for (auto& lane: memory_)
+        if (lane.size() < words)
+            lane.resize(words);
+}
+
+// private
+void scrypt_arena::mix(uint8_t* block, size_t lane, uint64_t N, uint32_t r)
+{
+    // V occupies 32rN words and is followed by 64r words of XY.
+    auto& memory = memory_[lane];
+    const auto V = memory.data();
+    const auto XY = V + 32 * static_cast<size_t>(N) * r;
+    crypto_scrypt_smix(block, r, N, V, XY);
+}
+
+data_chunk scrypt_arena::hash(data_slice data, data_slice salt, uint64_t N,
+    uint32_t p, uint32_t r, size_t length)
+{
+    // These are the parameter constraints of crypto_scrypt.
+    static constexpr uint64_t max_lanes = uint64_t(1) << 30;
+    static constexpr uint64_t max_length = ((uint64_t(1) << 32) - 1) * 32;
+
+    if (length > max_length || uint64_t(r) * p >= max_lanes)
+        throw std::length_error("scrypt parameter too large");
+
+    if (N == 0 || (N & (N - 1)) != 0)
+        throw std::runtime_error("scrypt invalid argument");
+
+    if (r == 0 || p == 0 || r > SIZE_MAX / 256 / p ||
+        N > (SIZE_MAX / 128 - 2 * r) / r)
+        throw std::length_error("scrypt address space");
+
+    const auto block_size = 128 * static_cast<size_t>(r);
+    data_chunk blocks(block_size * p);
+    reserve(32 * static_cast<size_t>(N) * r + 64 * r);
+
+    // 1: (B_0 ... B_{p-1}) <-- PBKDF2(P, S, 1, p * MFLen)
+    pbkdf2_sha256(data.data(), data.size(), salt.data(), salt.size(), 1,
+        blocks.data(), blocks.size());
+
+    // 2: for i = 0 to p - 1 do B_i <-- MF(B_i, N), one lane per block.
+    for (size_t first = 0; first < p; first += lanes())
+    {
+        const auto count = std::min(lanes(), p - first);
+
+        // Each block of the batch is mixed in its own lane.
+        const auto batch = [&](size_t begin, size_t end)
+        {
+            for (auto lane = begin; lane < end; ++lane)
+                mix(&blocks[(first + lane) * block_size], lane, N, r);
+        };
+
+        try
+        {
+            if (pool_ == nullptr)
+                batch(0, count);
+            else
+                parallel_for(*pool_, count, 1, batch);
+        }
+        catch (...)
+        {
+            zeroize(blocks.data(), blocks.size());
+            throw;
+        }
+    }
+
+    // 5: DK <-- PBKDF2(P, B, 1, dkLen)
+    data_chunk output(length);
+    pbkdf2_sha256(data.data(), data.size(), blocks.data(), blocks.size(), 1,
+        output.data(), output.size());
+
+    zeroize(blocks.data(), blocks.size());
+    return output;
+}
+
 } // namespace libbitcoin
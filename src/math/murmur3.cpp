@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/murmur3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+
+static BC_CONSTEXPR uint32_t murmur3_c1 = 0xcc9e2d51;
+static BC_CONSTEXPR uint32_t murmur3_c2 = 0x1b873593;
+static BC_CONSTEXPR uint32_t murmur3_n = 0xe6546b64;
+static BC_CONSTEXPR uint32_t murmur3_m = 5;
+static BC_CONSTEXPR uint32_t murmur3_f1 = 0x85ebca6b;
+static BC_CONSTEXPR uint32_t murmur3_f2 = 0xc2b2ae35;
+static BC_CONSTEXPR size_t murmur3_word_size = sizeof(uint32_t);
+
+static uint32_t rotate_left(uint32_t value, uint32_t bits)
+{
+    return (value << bits) | (value >> (32 - bits));
+}
+
+static uint32_t scramble(uint32_t word)
+{
+    return rotate_left(word * murmur3_c1, 15) * murmur3_c2;
+}
+
+uint32_t murmur3(data_slice data, uint32_t seed)
+{
+    const auto size = data.size();
+    const auto words = size / murmur3_word_size;
+    auto hash = seed;
+    auto it = data.begin();
+
+    for (size_t word = 0; word < words; ++word)
+    {
+        hash ^= scramble(from_little_endian_unsafe<uint32_t>(it));
+        hash = rotate_left(hash, 13) * murmur3_m + murmur3_n;
+        it += murmur3_word_size;
+    }
+
+    uint32_t tail = 0;
+
+    for (size_t byte = 0; it != data.end(); ++it, ++byte)
+        tail |= static_cast<uint32_t>(*it) << (8 * byte);
+
+    if (size % murmur3_word_size != 0)
+        hash ^= scramble(tail);
+
+    // The length is mixed modulo 2^32, as specified.
+    hash ^= static_cast<uint32_t>(size);
+
+    // Finalization mix, forces all bits to avalanche.
+    hash ^= hash >> 16;
+    hash *= murmur3_f1;
+    hash ^= hash >> 13;
+    hash *= murmur3_f2;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+} // namespace libbitcoin
@@ -19,8 +19,12 @@
  */
 #include "secp256k1_initializer.hpp"
 
+#include <cstddef>
 #include <mutex>
+#include <boost/thread.hpp>
 #include <secp256k1.h>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/random.hpp>
 
 namespace libbitcoin {
 
@@ -35,29 +39,76 @@ void secp256k1_initializer::set_context(secp256k1_context** context,
     *context = secp256k1_context_create(flags);
 }
 
+// Static helper to refresh the blinding of a signing context.
+// The seed must be unpredictable, so this throws if the os source fails.
+void secp256k1_initializer::randomize(secp256k1_context* context)
+{
+    data_chunk seed(32);
+    secure_random_fill(seed);
+
+    // A failure leaves the context blinded with its prior value.
+    secp256k1_context_randomize(context, seed.data());
+}
+
+// Static helper for use with boost::thread_specific_ptr on thread exit.
+void secp256k1_initializer::destroy(thread_context* context)
+{
+    secp256k1_context_destroy(context->context);
+    delete context;
+}
+
 // Protected base class constructor (must be derived).
-secp256k1_initializer::secp256k1_initializer(int flags)
-  : flags_(flags), context_(nullptr)
+secp256k1_initializer::secp256k1_initializer(int flags,
+    size_t randomize_interval)
+  : flags_(flags), randomize_interval_(randomize_interval),
+    context_(nullptr), thread_context_(destroy)
 {
 }
 
 // Clean up the context on destruct.
 secp256k1_initializer::~secp256k1_initializer()
 {
+    thread_context_.reset();
+
     if (context_ != nullptr)
         secp256k1_context_destroy(context_);
 }
 
 // Get the curve context and initialize on first use.
 secp256k1_context* secp256k1_initializer::context()
+{
+    if (randomize_interval_ == 0)
+        return shared_context();
+
+    // Each thread clones the shared context, avoiding costly table creation.
+    auto local = thread_context_.get();
+
+    if (local == nullptr)
+    {
+        local = new thread_context{ secp256k1_context_clone(shared_context()),
+            0 };
+        thread_context_.reset(local);
+    }
+
+    if (local->uses++ % randomize_interval_ == 0)
+        randomize(local->context);
+
+    return local->context;
+}
+
+// private
+secp256k1_context* secp256k1_initializer::shared_context()
 {
     std::call_once(mutex_, set_context, &context_, flags_);
     return context_;
 }
 
+// Blinding costs about one signature, so this is well amortized.
+const size_t secp256k1_signing::randomize_interval = 1024;
+
 // Concrete type for signing init.
 secp256k1_signing::secp256k1_signing()
-  : secp256k1_initializer(SECP256K1_CONTEXT_SIGN)
+  : secp256k1_initializer(SECP256K1_CONTEXT_SIGN, randomize_interval)
 {
 }
 
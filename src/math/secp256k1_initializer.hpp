@@ -20,9 +20,13 @@
 #ifndef LIBBITCOIN_SECP256K1_INITIALIZER_HPP
 #define LIBBITCOIN_SECP256K1_INITIALIZER_HPP
 
+#include <cstddef>
 #include <mutex>
+#include <boost/thread.hpp>
 #include <secp256k1.h>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 
 namespace libbitcoin {
 
@@ -35,7 +39,15 @@ namespace libbitcoin {
 class BC_API secp256k1_initializer
 {
 private:
+    struct thread_context
+    {
+        secp256k1_context* context;
+        size_t uses;
+    };
+
     static void set_context(secp256k1_context** context, int flags);
+    static void randomize(secp256k1_context* context);
+    static void destroy(thread_context* context);
 
 protected:
     int flags_;
@@ -43,8 +55,11 @@ protected:
     /**
      * Construct a signing context initializer of the specified context.
      * @param[in]  flags  { SECP256K1_CONTEXT_SIGN, SECP256K1_CONTEXT_VERIFY }
+     * @param[in]  randomize_interval  If nonzero each thread obtains its own
+     *                     clone of the context, blinded on first use and
+     *                     re-blinded after each interval of uses.
      */
-    secp256k1_initializer(int flags);
+    secp256k1_initializer(int flags, size_t randomize_interval=0);
 
 public:
     /**
@@ -54,21 +69,33 @@ public:
 
     /**
      * Call to obtain the secp256k1 context, initialized on first call.
+     * The context is valid for the calling thread only if thread local.
      */
     secp256k1_context* context();
 
 private:
+    secp256k1_context* shared_context();
+
+    const size_t randomize_interval_;
     std::once_flag mutex_;
     secp256k1_context* context_;
+    boost::thread_specific_ptr<thread_context> thread_context_;
 };
 
 /**
  * Create and hold this class to initialize signing context on first use.
+ * Signing contexts are thread local, so that blinding may be refreshed
+ * without synchronizing concurrent signers.
  */
 class BC_API secp256k1_signing
     : public secp256k1_initializer
 {
 public:
+    /**
+     * The number of uses of a thread's context between re-blinding.
+     */
+    static const size_t randomize_interval;
+
     /**
      * Construct a signing context initializer.
      */
@@ -98,6 +125,14 @@ extern secp256k1_signing signing;
  */
 extern secp256k1_verification verification;
 
+/**
+ * Verify the signature against a parsed point, normalizing the signature.
+ * This is the verification of elliptic_curve, shared with signature_cache.
+ */
+bool verify_signature(const secp256k1_context* context,
+    const secp256k1_pubkey point, const hash_digest& hash,
+    const ec_signature& signature);
+
 } // namespace libbitcoin
 
 #endif
\ No newline at end of file
@@ -0,0 +1,275 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/signature_cache.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <secp256k1.h>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/random.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+#include "secp256k1_initializer.hpp"
+
+namespace libbitcoin {
+
+// The largest point that can be parsed (uncompressed).
+static BC_CONSTEXPR size_t max_point_size = ec_uncompressed_size;
+
+// Each signature entry costs about 100 bytes including container overhead.
+const size_t signature_cache::default_signatures = 1u << 18;
+const size_t signature_cache::default_points = 1u << 16;
+
+// The salt must not be predictable, so this throws if the os source fails.
+static hash_digest new_salt()
+{
+    data_chunk salt(hash_size);
+    secure_random_fill(salt);
+    return to_array<hash_size>(salt);
+}
+
+// Select a random slot of the full key list and replace its key.
+template <typename Container>
+static void evict(Container& container, hash_list& keys,
+    const hash_digest& key)
+{
+    auto& slot = keys[pseudo_random(0, keys.size() - 1)];
+    container.erase(slot);
+    slot = key;
+}
+
+signature_cache& signature_cache::instance()
+{
+    static signature_cache cache;
+    return cache;
+}
+
+signature_cache::signature_cache(size_t signatures, size_t points)
+  : signature_capacity_(signatures),
+    point_capacity_(points),
+    salt_(new_salt()),
+    hits_(0),
+    misses_(0),
+    point_hits_(0),
+    point_misses_(0)
+{
+    signatures_.reserve(signature_capacity_);
+    points_.reserve(point_capacity_);
+}
+
+bool signature_cache::verify(data_slice point, const hash_digest& hash,
+    const ec_signature& signature)
+{
+    // Oversized points are never valid, and would truncate the cache key.
+    if (point.size() > max_point_size)
+        return false;
+
+    const auto key = signature_key(point, hash, signature);
+
+    if (signature_capacity_ > 0)
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        shared_lock lock(signature_mutex_);
+
+        if (signatures_.find(key) != signatures_.end())
+        {
+            ++hits_;
+            return true;
+        }
+        ///////////////////////////////////////////////////////////////////////
+    }
+
+    ++misses_;
+    parsed_point parsed;
+
+    if (!parse(parsed, point))
+        return false;
+
+    // Copy to avoid exposing external types.
+    secp256k1_pubkey pubkey;
+    std::copy(parsed.begin(), parsed.end(), std::begin(pubkey.data));
+
+    if (!verify_signature(verification.context(), pubkey, hash, signature))
+        return false;
+
+    insert(key);
+    return true;
+}
+
+bool signature_cache::contains(data_slice point, const hash_digest& hash,
+    const ec_signature& signature) const
+{
+    if (point.size() > max_point_size)
+        return false;
+
+    const auto key = signature_key(point, hash, signature);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(signature_mutex_);
+
+    return signatures_.find(key) != signatures_.end();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void signature_cache::store(data_slice point, const hash_digest& hash,
+    const ec_signature& signature)
+{
+    if (point.size() > max_point_size)
+        return;
+
+    insert(signature_key(point, hash, signature));
+}
+
+void signature_cache::clear()
+{
+    unique_lock signature_lock(signature_mutex_);
+    unique_lock point_lock(point_mutex_);
+    signatures_.clear();
+    signature_keys_.clear();
+    points_.clear();
+    point_keys_.clear();
+}
+
+size_t signature_cache::size() const
+{
+    shared_lock lock(signature_mutex_);
+    return signatures_.size();
+}
+
+uint64_t signature_cache::hits() const
+{
+    return hits_;
+}
+
+uint64_t signature_cache::misses() const
+{
+    return misses_;
+}
+
+uint64_t signature_cache::point_hits() const
+{
+    return point_hits_;
+}
+
+uint64_t signature_cache::point_misses() const
+{
+    return point_misses_;
+}
+
+// private
+hash_digest signature_cache::signature_key(data_slice point,
+    const hash_digest& hash, const ec_signature& signature) const
+{
+    // Assemble the preimage on the stack to avoid allocation.
+    static BC_CONSTEXPR size_t preimage_size = hash_size + hash_size +
+        ec_signature_size + max_point_size;
+    byte_array<preimage_size> preimage;
+    const auto point_size = std::min(point.size(), max_point_size);
+
+    auto it = std::copy(salt_.begin(), salt_.end(), preimage.begin());
+    it = std::copy(hash.begin(), hash.end(), it);
+    it = std::copy(signature.begin(), signature.end(), it);
+    it = std::copy(point.begin(), point.begin() + point_size, it);
+    const auto size = std::distance(preimage.begin(), it);
+    return sha256_hash(data_slice(preimage.data(), preimage.data() + size));
+}
+
+// private
+hash_digest signature_cache::point_key(data_slice point) const
+{
+    return sha256_hash(salt_, point);
+}
+
+// private
+void signature_cache::insert(const hash_digest& key)
+{
+    if (signature_capacity_ == 0)
+        return;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(signature_mutex_);
+
+    if (!signatures_.insert(key).second)
+        return;
+
+    if (signature_keys_.size() < signature_capacity_)
+        signature_keys_.push_back(key);
+    else
+        evict(signatures_, signature_keys_, key);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// private
+bool signature_cache::parse(parsed_point& out, data_slice point)
+{
+    const auto key = point_key(point);
+
+    if (point_capacity_ > 0)
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        shared_lock lock(point_mutex_);
+
+        const auto it = points_.find(key);
+
+        if (it != points_.end())
+        {
+            ++point_hits_;
+            out = it->second;
+            return true;
+        }
+        ///////////////////////////////////////////////////////////////////////
+    }
+
+    ++point_misses_;
+    secp256k1_pubkey pubkey;
+    const auto context = verification.context();
+
+    if (secp256k1_ec_pubkey_parse(context, &pubkey, point.data(),
+        point.size()) != 1)
+        return false;
+
+    std::copy(std::begin(pubkey.data), std::end(pubkey.data), out.begin());
+
+    if (point_capacity_ == 0)
+        return true;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(point_mutex_);
+
+    if (!points_.emplace(key, out).second)
+        return true;
+
+    if (point_keys_.size() < point_capacity_)
+        point_keys_.push_back(key);
+    else
+        evict(points_, point_keys_, key);
+
+    return true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+} // namespace libbitcoin
@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/siphash.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+
+// Initialization constants ("somepseudorandomlygeneratedbytes").
+static BC_CONSTEXPR uint64_t siphash_v0 = 0x736f6d6570736575;
+static BC_CONSTEXPR uint64_t siphash_v1 = 0x646f72616e646f6d;
+static BC_CONSTEXPR uint64_t siphash_v2 = 0x6c7967656e657261;
+static BC_CONSTEXPR uint64_t siphash_v3 = 0x7465646279746573;
+static BC_CONSTEXPR uint64_t siphash_finalizer = 0xff;
+static BC_CONSTEXPR size_t siphash_word_size = sizeof(uint64_t);
+
+class siphash_state
+{
+public:
+    siphash_state(const siphash_key& key)
+      : v0_(siphash_v0 ^ key.first), v1_(siphash_v1 ^ key.second),
+        v2_(siphash_v2 ^ key.first), v3_(siphash_v3 ^ key.second)
+    {
+    }
+
+    void compress(uint64_t word)
+    {
+        v3_ ^= word;
+        round();
+        round();
+        v0_ ^= word;
+    }
+
+    uint64_t finalize()
+    {
+        v2_ ^= siphash_finalizer;
+        round();
+        round();
+        round();
+        round();
+        return v0_ ^ v1_ ^ v2_ ^ v3_;
+    }
+
+private:
+    static uint64_t rotate_left(uint64_t value, uint32_t bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    void round()
+    {
+        v0_ += v1_;
+        v1_ = rotate_left(v1_, 13);
+        v1_ ^= v0_;
+        v0_ = rotate_left(v0_, 32);
+        v2_ += v3_;
+        v3_ = rotate_left(v3_, 16);
+        v3_ ^= v2_;
+        v0_ += v3_;
+        v3_ = rotate_left(v3_, 21);
+        v3_ ^= v0_;
+        v2_ += v1_;
+        v1_ = rotate_left(v1_, 17);
+        v1_ ^= v2_;
+        v2_ = rotate_left(v2_, 32);
+    }
+
+    uint64_t v0_;
+    uint64_t v1_;
+    uint64_t v2_;
+    uint64_t v3_;
+};
+
+siphash_key to_siphash_key(const half_hash& hash)
+{
+    const auto middle = hash.begin() + siphash_word_size;
+    const auto first = from_little_endian_unsafe<uint64_t>(hash.begin());
+    const auto second = from_little_endian_unsafe<uint64_t>(middle);
+    return{ first, second };
+}
+
+uint64_t siphash(const siphash_key& key, data_slice message)
+{
+    siphash_state state(key);
+    const auto size = message.size();
+    const auto words = size / siphash_word_size;
+    auto it = message.begin();
+
+    for (size_t word = 0; word < words; ++word)
+    {
+        state.compress(from_little_endian_unsafe<uint64_t>(it));
+        it += siphash_word_size;
+    }
+
+    // The final word holds the remaining bytes and the low byte of the size.
+    uint64_t last = static_cast<uint64_t>(size) << 56;
+
+    for (size_t byte = 0; it != message.end(); ++it, ++byte)
+        last |= static_cast<uint64_t>(*it) << (8 * byte);
+
+    state.compress(last);
+    return state.finalize();
+}
+
+uint64_t siphash(const siphash_key& key, const hash_digest& hash)
+{
+    static BC_CONSTEXPR uint64_t size_word = uint64_t(hash_size) << 56;
+
+    static BC_CONSTEXPR size_t words = hash_size / siphash_word_size;
+
+    siphash_state state(key);
+
+    for (size_t word = 0; word < words; ++word)
+    {
+        const auto it = hash.begin() + (word * siphash_word_size);
+        state.compress(from_little_endian_unsafe<uint64_t>(it));
+    }
+
+    state.compress(size_word);
+    return state.finalize();
+}
+
+} // namespace libbitcoin
@@ -128,6 +128,11 @@ bool create_stealth_data(data_chunk& out_stealth_data, ec_secret& out_secret,
     // This will iterate up to 2^32 times before giving up.
     for (uint32_t nonce = start + 1; nonce != start; ++nonce)
     {
+        // Copy the nonce into the end of data.
+        const auto nonce_bytes = to_little_endian(nonce);
+        std::copy(nonce_bytes.begin(), nonce_bytes.end(),
+            data.end() - sizeof(uint32_t));
+
         // Create the stealth script with the current data.
         const auto ops = operation::to_null_data_pattern(data);
         const auto stealth_script = script{ ops };
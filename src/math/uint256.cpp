@@ -20,22 +20,172 @@ base_uint<BITS>::base_uint(const std::vector<unsigned char>& vch)
     memcpy(pn, &vch[0], sizeof(pn));
 }
 
+#ifdef __SIZEOF_INT128__
+// The extension keyword suppresses the pedantic warning for the type.
+__extension__ typedef unsigned __int128 uint128;
+#endif
+
+// The high and low 64 bits of the 128 bit product.
+static inline uint64_t multiply(uint64_t& high, uint64_t left, uint64_t right)
+{
+#ifdef __SIZEOF_INT128__
+    const auto product = static_cast<uint128>(left) * right;
+    high = static_cast<uint64_t>(product >> 64);
+    return static_cast<uint64_t>(product);
+#else
+    const uint64_t left_low = left & 0xffffffff;
+    const uint64_t left_high = left >> 32;
+    const uint64_t right_low = right & 0xffffffff;
+    const uint64_t right_high = right >> 32;
+
+    const auto low_low = left_low * right_low;
+    const auto high_low = left_high * right_low;
+    const auto low_high = left_low * right_high;
+    const auto high_high = left_high * right_high;
+
+    const auto middle = (low_low >> 32) + (high_low & 0xffffffff) + low_high;
+    high = high_high + (high_low >> 32) + (middle >> 32);
+    return (middle << 32) | (low_low & 0xffffffff);
+#endif
+}
+
+// The number of leading zero bits of a nonzero 32 bit value.
+static inline int leading_zeros(uint32_t value)
+{
+    BITCOIN_ASSERT(value != 0);
+#if defined(__GNUC__)
+    return __builtin_clz(value);
+#else
+    int zeros = 0;
+    for (; (value & 0x80000000) == 0; value <<= 1)
+        ++zeros;
+
+    return zeros;
+#endif
+}
+
+// The number of significant 32 bit digits of the value.
+static inline int significant(const uint32_t* digits, int count)
+{
+    while (count > 0 && digits[count - 1] == 0)
+        --count;
+
+    return count;
+}
+
+// Knuth's algorithm D (TAOCP 4.3.1) in 32 bit digits, with 64 bit
+// intermediates, for the quotient of numerator (m) by divisor (n) digits.
+// The divisor must have a nonzero high digit and m must be at least n.
+static void divide(uint32_t* quotient, const uint32_t* numerator, int m,
+    const uint32_t* divisor, int n)
+{
+    static const uint64_t base = 0x100000000;
+
+    // Divide by a single digit with 64 bit short division.
+    if (n == 1)
+    {
+        uint64_t remainder = 0;
+        for (int j = m - 1; j >= 0; j--)
+        {
+            const auto dividend = (remainder << 32) | numerator[j];
+            quotient[j] = static_cast<uint32_t>(dividend / divisor[0]);
+            remainder = dividend % divisor[0];
+        }
+
+        return;
+    }
+
+    // Normalize so that the high divisor digit has its high bit set.
+    uint32_t normal_divisor[16];
+    uint32_t normal_numerator[17];
+    const auto shift = leading_zeros(divisor[n - 1]);
+
+    for (int i = n - 1; i > 0; i--)
+        normal_divisor[i] = shift == 0 ? divisor[i] : (divisor[i] << shift) |
+            (divisor[i - 1] >> (32 - shift));
+
+    normal_divisor[0] = divisor[0] << shift;
+    normal_numerator[m] = shift == 0 ? 0 : numerator[m - 1] >> (32 - shift);
+
+    for (int i = m - 1; i > 0; i--)
+        normal_numerator[i] = shift == 0 ? numerator[i] :
+            (numerator[i] << shift) | (numerator[i - 1] >> (32 - shift));
+
+    normal_numerator[0] = numerator[0] << shift;
+
+    const uint64_t high = normal_divisor[n - 1];
+    const uint64_t next = normal_divisor[n - 2];
+
+    for (int j = m - n; j >= 0; j--)
+    {
+        // Estimate the quotient digit from the top two digits, then correct.
+        const auto dividend = (static_cast<uint64_t>(
+            normal_numerator[j + n]) << 32) | normal_numerator[j + n - 1];
+        auto estimate = dividend / high;
+        auto remainder = dividend % high;
+
+        while (estimate >= base || estimate * next >
+            ((remainder << 32) | normal_numerator[j + n - 2]))
+        {
+            --estimate;
+            remainder += high;
+            if (remainder >= base)
+                break;
+        }
+
+        // Multiply and subtract.
+        int64_t borrow = 0;
+        uint64_t carry = 0;
+        for (int i = 0; i < n; i++)
+        {
+            const auto product = estimate * normal_divisor[i] + carry;
+            carry = product >> 32;
+            const auto difference = static_cast<int64_t>(
+                normal_numerator[i + j]) - borrow -
+                static_cast<int64_t>(product & 0xffffffff);
+            normal_numerator[i + j] = static_cast<uint32_t>(difference);
+            borrow = difference < 0 ? 1 : 0;
+        }
+
+        const auto difference = static_cast<int64_t>(
+            normal_numerator[j + n]) - borrow - static_cast<int64_t>(carry);
+        normal_numerator[j + n] = static_cast<uint32_t>(difference);
+
+        // The estimate was one too large, so add back.
+        if (difference < 0)
+        {
+            --estimate;
+            uint64_t sum = 0;
+            for (int i = 0; i < n; i++)
+            {
+                sum = static_cast<uint64_t>(normal_numerator[i + j]) +
+                    normal_divisor[i] + (sum >> 32);
+                normal_numerator[i + j] = static_cast<uint32_t>(sum);
+            }
+
+            normal_numerator[j + n] += static_cast<uint32_t>(sum >> 32);
+        }
+
+        quotient[j] = static_cast<uint32_t>(estimate);
+    }
+}
+
 template <unsigned int BITS>
 base_uint<BITS>& base_uint<BITS>::operator<<=(unsigned int shift)
 {
-    base_uint<BITS> a(*this);
-    for (int i = 0; i < WIDTH; i++)
-        pn[i] = 0;
+    const int k = shift / 64;
+    shift = shift % 64;
 
-    int k = shift / 32;
-    shift = shift % 32;
-    for (int i = 0; i < WIDTH; i++)
+    for (int i = WIDTH - 1; i >= 0; i--)
     {
-        if (i + k + 1 < WIDTH && shift != 0)
-            pn[i + k + 1] |= (a.pn[i] >> (32 - shift));
+        uint64_t limb = 0;
+        if (i - k >= 0)
+            limb = pn[i - k] << shift;
 
-        if (i + k < WIDTH)
-            pn[i + k] |= (a.pn[i] << shift);
+        if (i - k - 1 >= 0 && shift != 0)
+            limb |= pn[i - k - 1] >> (64 - shift);
+
+        pn[i] = limb;
     }
 
     return *this;
@@ -44,19 +194,19 @@ base_uint<BITS>& base_uint<BITS>::operator<<=(unsigned int shift)
 template <unsigned int BITS>
 base_uint<BITS>& base_uint<BITS>::operator>>=(unsigned int shift)
 {
-    base_uint<BITS> a(*this);
-    for (int i = 0; i < WIDTH; i++)
-        pn[i] = 0;
+    const int k = shift / 64;
+    shift = shift % 64;
 
-    int k = shift / 32;
-    shift = shift % 32;
     for (int i = 0; i < WIDTH; i++)
     {
-        if (i - k - 1 >= 0 && shift != 0)
-            pn[i - k - 1] |= (a.pn[i] << (32 - shift));
+        uint64_t limb = 0;
+        if (i + k < WIDTH)
+            limb = pn[i + k] >> shift;
 
-        if (i - k >= 0)
-            pn[i - k] |= (a.pn[i] >> shift);
+        if (i + k + 1 < WIDTH && shift != 0)
+            limb |= pn[i + k + 1] << (64 - shift);
+
+        pn[i] = limb;
     }
 
     return *this;
@@ -68,9 +218,10 @@ base_uint<BITS>& base_uint<BITS>::operator*=(uint32_t b32)
     uint64_t carry = 0;
     for (int i = 0; i < WIDTH; i++)
     {
-        uint64_t n = carry + (uint64_t)b32 * pn[i];
-        pn[i] = n & 0xffffffff;
-        carry = n >> 32;
+        uint64_t high;
+        const auto low = multiply(high, pn[i], b32);
+        pn[i] = low + carry;
+        carry = high + (pn[i] < low ? 1 : 0);
     }
 
     return *this;
@@ -79,16 +230,21 @@ base_uint<BITS>& base_uint<BITS>::operator*=(uint32_t b32)
 template <unsigned int BITS>
 base_uint<BITS>& base_uint<BITS>::operator*=(const base_uint& b)
 {
-    base_uint<BITS> a = *this;
+    const base_uint<BITS> a = *this;
     *this = 0;
+
     for (int j = 0; j < WIDTH; j++)
     {
         uint64_t carry = 0;
         for (int i = 0; i + j < WIDTH; i++)
         {
-            uint64_t n = carry + pn[i + j] + (uint64_t)a.pn[j] * b.pn[i];
-            pn[i + j] = n & 0xffffffff;
-            carry = n >> 32;
+            uint64_t high;
+            auto low = multiply(high, a.pn[j], b.pn[i]);
+            low += carry;
+            high += low < carry ? 1 : 0;
+            pn[i + j] += low;
+            high += pn[i + j] < low ? 1 : 0;
+            carry = high;
         }
     }
 
@@ -98,77 +254,36 @@ base_uint<BITS>& base_uint<BITS>::operator*=(const base_uint& b)
 template <unsigned int BITS>
 base_uint<BITS>& base_uint<BITS>::operator/=(const base_uint& b)
 {
-    // make a copy, so we can shift.
-    base_uint<BITS> div = b;
-
-    // make a copy, so we can subtract.
-    base_uint<BITS> num = *this; 
-
-    // the quotient.
-    *this = 0;
-
-    int num_bits = num.bits();
-    int div_bits = div.bits();
-    if (div_bits == 0)
-        throw uint_error("Division by zero");
-
-    // the result is certainly 0.
-    if (div_bits > num_bits)
-        return *this;
-
-    int shift = num_bits - div_bits;
-
-    // shift so that div and nun align.
-    div <<= shift;
-
-    while (shift >= 0)
-    {
-        if (num >= div)
-        {
-            num -= div;
-
-            // set a bit of the result.
-            pn[shift / 32] |= (1 << (shift & 31));
-        }
+    static const int digits = BITS / 32;
+    static_assert(digits <= 16, "division buffer too small");
 
-        // shift back.
-        div >>= 1;
-        shift--;
-    }
+    uint32_t numerator[digits];
+    uint32_t divisor[digits];
+    uint32_t quotient[digits] = { 0 };
 
-    // num now contains the remainder of the division.
-    return *this;
-}
-
-template <unsigned int BITS>
-int base_uint<BITS>::CompareTo(const base_uint<BITS>& b) const
-{
-    for (int i = WIDTH - 1; i >= 0; i--)
+    for (int i = 0; i < WIDTH; i++)
     {
-        if (pn[i] < b.pn[i])
-            return -1;
-
-        if (pn[i] > b.pn[i])
-            return 1;
+        numerator[2 * i] = static_cast<uint32_t>(pn[i]);
+        numerator[2 * i + 1] = static_cast<uint32_t>(pn[i] >> 32);
+        divisor[2 * i] = static_cast<uint32_t>(b.pn[i]);
+        divisor[2 * i + 1] = static_cast<uint32_t>(b.pn[i] >> 32);
     }
 
-    return 0;
-}
+    const auto m = significant(numerator, digits);
+    const auto n = significant(divisor, digits);
 
-template <unsigned int BITS>
-bool base_uint<BITS>::EqualTo(uint64_t b) const
-{
-    for (int i = WIDTH - 1; i >= 2; i--)
-        if (pn[i] != 0)
-            return false;
+    if (n == 0)
+        throw uint_error("Division by zero");
 
-    if (pn[1] != (b >> 32))
-        return false;
+    // The result is certainly zero when the divisor has more digits.
+    if (n <= m)
+        divide(quotient, numerator, m, divisor, n);
 
-    if (pn[0] != (b & 0xfffffffful))
-        return false;
+    for (int i = 0; i < WIDTH; i++)
+        pn[i] = static_cast<uint64_t>(quotient[2 * i + 1]) << 32 |
+            quotient[2 * i];
 
-    return true;
+    return *this;
 }
 
 template <unsigned int BITS>
@@ -178,11 +293,15 @@ unsigned int base_uint<BITS>::bits() const
     {
         if (pn[pos] != 0)
         {
-            for (int bits = 31; bits > 0; bits--)
-                if ((pn[pos] & 1 << bits) != 0)
-                    return 32 * pos + bits + 1;
-
-            return 32 * pos + 1;
+#if defined(__GNUC__)
+            return 64 * pos + 64 - __builtin_clzll(pn[pos]);
+#else
+            for (int bits = 63; bits > 0; bits--)
+                if ((pn[pos] & (uint64_t)1 << bits) != 0)
+                    return 64 * pos + bits + 1;
+
+            return 64 * pos + 1;
+#endif
         }
     }
 
@@ -196,8 +315,6 @@ template base_uint<256>& base_uint<256>::operator>>=(unsigned int);
 template base_uint<256>& base_uint<256>::operator*=(uint32_t b32);
 template base_uint<256>& base_uint<256>::operator*=(const base_uint<256>& b);
 template base_uint<256>& base_uint<256>::operator/=(const base_uint<256>& b);
-template int base_uint<256>::CompareTo(const base_uint<256>&) const;
-template bool base_uint<256>::EqualTo(uint64_t) const;
 template unsigned int base_uint<256>::bits() const;
 
 uint32_t uint256_t::GetCompact(bool fNegative) const
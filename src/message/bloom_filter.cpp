@@ -0,0 +1,276 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/bloom_filter.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/chain/script/operation.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/murmur3.hpp>
+#include <bitcoin/bitcoin/message/filter_add.hpp>
+#include <bitcoin/bitcoin/message/filter_load.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+using namespace bc::chain;
+
+// The serialized size of an outpoint (hash and index).
+static BC_CONSTEXPR size_t outpoint_size = hash_size + sizeof(uint32_t);
+typedef byte_array<outpoint_size> outpoint_bytes;
+
+// Bip37 seed multiplier, chosen to maximize bit differences between seeds.
+static BC_CONSTEXPR uint32_t seed_multiplier = 0xfba4c795;
+
+const size_t bloom_filter::max_filter_size = 36000;
+const uint32_t bloom_filter::max_hash_functions = 50;
+
+// The filterable elements of a transaction, extracted once so that they may
+// be matched against any number of filters. Slices refer into the source.
+struct bloom_filter::elements
+{
+    struct output
+    {
+        std::vector<data_slice> pushes;
+        bool is_pubkey;
+    };
+
+    struct input
+    {
+        outpoint_bytes previous;
+        std::vector<data_slice> pushes;
+    };
+
+    hash_digest hash;
+    std::vector<output> outputs;
+    std::vector<input> inputs;
+};
+
+static outpoint_bytes to_outpoint(const hash_digest& hash, uint32_t index)
+{
+    return splice(hash, to_little_endian(index));
+}
+
+static void to_pushes(std::vector<data_slice>& out, const script& script)
+{
+    const auto& operations = script.operations();
+    out.clear();
+    out.reserve(operations.size());
+
+    for (const auto& op: operations)
+        if (!op.data().empty())
+            out.emplace_back(op.data());
+}
+
+// private
+// static
+void bloom_filter::to_elements(elements& out, const transaction& tx)
+{
+    out.hash = tx.hash();
+    out.outputs.resize(tx.outputs().size());
+    out.inputs.resize(tx.inputs().size());
+
+    for (size_t index = 0; index < tx.outputs().size(); ++index)
+    {
+        const auto& script = tx.outputs()[index].script();
+        const auto pattern = script.pattern();
+        auto& output = out.outputs[index];
+        to_pushes(output.pushes, script);
+        output.is_pubkey = pattern == script_pattern::pay_public_key ||
+            pattern == script_pattern::pay_multisig;
+    }
+
+    for (size_t index = 0; index < tx.inputs().size(); ++index)
+    {
+        const auto& input = tx.inputs()[index];
+        const auto& previous = input.previous_output();
+        out.inputs[index].previous = to_outpoint(previous.hash(),
+            previous.index());
+        to_pushes(out.inputs[index].pushes, input.script());
+    }
+}
+
+std::vector<bloom_filter::matches> bloom_filter::match(list& filters,
+    const transaction::list& transactions)
+{
+    std::vector<matches> result(filters.size(),
+        matches(transactions.size(), false));
+
+    // Reuse element storage across transactions to limit allocation.
+    elements tx_elements;
+
+    for (size_t tx = 0; tx < transactions.size(); ++tx)
+    {
+        to_elements(tx_elements, transactions[tx]);
+
+        for (size_t filter = 0; filter < filters.size(); ++filter)
+            result[filter][tx] = filters[filter].is_relevant(tx_elements);
+    }
+
+    return result;
+}
+
+bloom_filter::bloom_filter()
+  : filter_(), hash_functions_(0), tweak_(0), flags_(update::none)
+{
+}
+
+bloom_filter::bloom_filter(const filter_load& load)
+  : bloom_filter(load.filter(), load.hash_functions(), load.tweak(),
+      load.flags())
+{
+}
+
+bloom_filter::bloom_filter(const data_chunk& filter, uint32_t hash_functions,
+    uint32_t tweak, uint8_t flags)
+  : filter_(filter), hash_functions_(hash_functions), tweak_(tweak),
+    flags_(flags)
+{
+}
+
+bloom_filter::bloom_filter(data_chunk&& filter, uint32_t hash_functions,
+    uint32_t tweak, uint8_t flags)
+  : filter_(std::move(filter)), hash_functions_(hash_functions),
+    tweak_(tweak), flags_(flags)
+{
+}
+
+const data_chunk& bloom_filter::filter() const
+{
+    return filter_;
+}
+
+uint32_t bloom_filter::hash_functions() const
+{
+    return hash_functions_;
+}
+
+uint32_t bloom_filter::tweak() const
+{
+    return tweak_;
+}
+
+uint8_t bloom_filter::flags() const
+{
+    return flags_;
+}
+
+bool bloom_filter::is_valid() const
+{
+    return filter_.size() <= max_filter_size &&
+        hash_functions_ <= max_hash_functions;
+}
+
+void bloom_filter::insert(data_slice element)
+{
+    const auto bits = static_cast<uint32_t>(filter_.size() * byte_bits);
+
+    if (bits == 0)
+        return;
+
+    for (uint32_t function = 0; function < hash_functions_; ++function)
+    {
+        const auto seed = function * seed_multiplier + tweak_;
+        const auto bit = murmur3(element, seed) % bits;
+        filter_[bit >> 3] |= (1 << (bit & 7));
+    }
+}
+
+void bloom_filter::add(const filter_add& message)
+{
+    insert(message.data());
+}
+
+bool bloom_filter::contains(data_slice element) const
+{
+    const auto bits = static_cast<uint32_t>(filter_.size() * byte_bits);
+
+    if (bits == 0)
+        return false;
+
+    // Early exit on the first unset bit, which is the common (miss) case.
+    for (uint32_t function = 0; function < hash_functions_; ++function)
+    {
+        const auto seed = function * seed_multiplier + tweak_;
+        const auto bit = murmur3(element, seed) % bits;
+
+        if ((filter_[bit >> 3] & (1 << (bit & 7))) == 0)
+            return false;
+    }
+
+    return true;
+}
+
+bool bloom_filter::is_relevant(const transaction& tx)
+{
+    elements tx_elements;
+    to_elements(tx_elements, tx);
+    return is_relevant(tx_elements);
+}
+
+// private
+bool bloom_filter::is_relevant(const elements& tx)
+{
+    auto relevant = contains(tx.hash);
+    const auto mode = flags_ & (update::all | update::pubkey_only);
+
+    // Outputs are matched in full so that all matching outpoints are added.
+    for (size_t index = 0; index < tx.outputs.size(); ++index)
+    {
+        const auto& output = tx.outputs[index];
+
+        for (const auto& push: output.pushes)
+        {
+            if (!contains(push))
+                continue;
+
+            relevant = true;
+
+            if (mode == update::all ||
+                (mode == update::pubkey_only && output.is_pubkey))
+                insert(to_outpoint(tx.hash, static_cast<uint32_t>(index)));
+
+            break;
+        }
+    }
+
+    if (relevant)
+        return true;
+
+    for (const auto& input: tx.inputs)
+    {
+        if (contains(input.previous))
+            return true;
+
+        for (const auto& push: input.pushes)
+            if (contains(push))
+                return true;
+    }
+
+    return false;
+}
+
+} // namespace message
+} // namespace libbitcoin
@@ -20,10 +20,14 @@
 #include <bitcoin/bitcoin/message/compact_block.hpp>
 
 #include <initializer_list>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 
@@ -58,6 +62,14 @@ compact_block compact_block::factory_from_data(uint32_t version,
     return instance;
 }
 
+// The short id is the low six bytes of the siphash, little endian.
+compact_block::short_id compact_block::to_short_id(const siphash_key& key,
+    const hash_digest& hash)
+{
+    const auto digest = to_little_endian(siphash(key, hash));
+    return slice<0, mini_hash_size>(digest);
+}
+
 compact_block::compact_block()
   : header_(), nonce_(0), short_ids_(), transactions_()
 {
@@ -90,6 +102,13 @@ compact_block::compact_block(compact_block&& other)
 {
 }
 
+siphash_key compact_block::short_id_key() const
+{
+    const auto digest = sha256_hash(header_.to_data(),
+        to_little_endian(nonce_));
+    return to_siphash_key(slice<0, half_hash_size>(digest));
+}
+
 bool compact_block::is_valid() const
 {
     return header_.is_valid() && !short_ids_.empty() && !transactions_.empty();
@@ -0,0 +1,286 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/compact_block_reconstructor.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/limits.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
+#include <bitcoin/bitcoin/message/block_message.hpp>
+#include <bitcoin/bitcoin/message/block_transactions.hpp>
+#include <bitcoin/bitcoin/message/compact_block.hpp>
+#include <bitcoin/bitcoin/message/get_block_transactions.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+// Short ids are 48 bits, so this value cannot collide with any short id.
+static BC_CONSTEXPR uint64_t empty_key = max_uint64;
+static BC_CONSTEXPR uint64_t short_id_mask = 0x0000ffffffffffff;
+static BC_CONSTEXPR size_t minimum_table_size = 16;
+
+// Bound the block size implied by the message (avoids excess allocation).
+static BC_CONSTEXPR size_t maximum_transactions = max_uint16;
+
+compact_block_reconstructor::compact_block_reconstructor(
+    const compact_block& block)
+  : valid_(false), header_(block.header()), key_(block.short_id_key()),
+    mask_(0)
+{
+    valid_ = populate(block);
+}
+
+// private
+bool compact_block_reconstructor::populate(const compact_block& block)
+{
+    const auto& prefilled = block.transactions();
+    const auto& short_ids = block.short_ids();
+    const auto count = prefilled.size() + short_ids.size();
+
+    if (count == 0 || count > maximum_transactions)
+        return false;
+
+    transactions_.resize(count);
+    states_.resize(count, slot_state::empty);
+
+    // Prefilled indexes are differentially encoded (bip152).
+    uint64_t next = 0;
+
+    for (const auto& tx: prefilled)
+    {
+        if (tx.index() >= count - next)
+            return false;
+
+        const auto index = static_cast<size_t>(next + tx.index());
+        transactions_[index] = tx.transaction();
+        states_[index] = slot_state::prefilled;
+        next = index + 1;
+    }
+
+    // Size the table to a power of two at least twice the number of ids.
+    auto size = minimum_table_size;
+    while (size < 2 * short_ids.size())
+        size <<= 1;
+
+    keys_.resize(size, empty_key);
+    slots_.resize(size, 0);
+    mask_ = size - 1;
+
+    // Short ids are assigned to the unfilled slots in order.
+    size_t slot = 0;
+
+    for (const auto& id: short_ids)
+    {
+        while (states_[slot] == slot_state::prefilled)
+            ++slot;
+
+        // A duplicated short id cannot be resolved (bip152).
+        if (!insert(to_integer(id), static_cast<uint32_t>(slot)))
+            return false;
+
+        ++slot;
+    }
+
+    return true;
+}
+
+// private
+// static
+uint64_t compact_block_reconstructor::to_integer(
+    const compact_block::short_id& id)
+{
+    uint64_t value = 0;
+
+    for (size_t byte = 0; byte < id.size(); ++byte)
+        value |= static_cast<uint64_t>(id[byte]) << (8 * byte);
+
+    return value;
+}
+
+// private
+bool compact_block_reconstructor::insert(uint64_t short_id, uint32_t slot)
+{
+    // Short ids are uniformly distributed, so the low bits index directly.
+    for (auto bucket = short_id & mask_; ; bucket = (bucket + 1) & mask_)
+    {
+        if (keys_[bucket] == short_id)
+            return false;
+
+        if (keys_[bucket] == empty_key)
+        {
+            keys_[bucket] = short_id;
+            slots_[bucket] = slot;
+            return true;
+        }
+    }
+}
+
+// private
+bool compact_block_reconstructor::find(uint64_t short_id,
+    uint32_t& slot) const
+{
+    // The table is never full, so an empty bucket terminates the probe.
+    for (auto bucket = short_id & mask_; ; bucket = (bucket + 1) & mask_)
+    {
+        if (keys_[bucket] == empty_key)
+            return false;
+
+        if (keys_[bucket] == short_id)
+        {
+            slot = slots_[bucket];
+            return true;
+        }
+    }
+}
+
+bool compact_block_reconstructor::is_valid() const
+{
+    return valid_;
+}
+
+// private
+size_t compact_block_reconstructor::resolved() const
+{
+    size_t count = 0;
+
+    for (const auto state: states_)
+        if (state == slot_state::prefilled || state == slot_state::matched)
+            ++count;
+
+    return count;
+}
+
+bool compact_block_reconstructor::is_complete() const
+{
+    return valid_ && resolved() == states_.size();
+}
+
+size_t compact_block_reconstructor::match(
+    const chain::transaction::list& known)
+{
+    if (!valid_)
+        return 0;
+
+    const auto before = resolved();
+    uint32_t slot;
+
+    for (const auto& tx: known)
+    {
+        const auto hash = tx.hash();
+        const auto short_id = siphash(key_, hash) & short_id_mask;
+
+        if (!find(short_id, slot))
+            continue;
+
+        auto& state = states_[slot];
+
+        if (state == slot_state::empty)
+        {
+            transactions_[slot] = chain::transaction(tx, hash);
+            state = slot_state::matched;
+        }
+        else if (state == slot_state::matched &&
+            transactions_[slot].hash() != hash)
+        {
+            // Two known transactions share the short id, request it instead.
+            transactions_[slot] = chain::transaction{};
+            state = slot_state::ambiguous;
+        }
+    }
+
+    return floor_subtract(resolved(), before);
+}
+
+get_block_transactions compact_block_reconstructor::missing() const
+{
+    std::vector<uint64_t> indexes;
+    uint64_t next = 0;
+
+    for (size_t index = 0; valid_ && index < states_.size(); ++index)
+    {
+        const auto state = states_[index];
+
+        if (state == slot_state::empty || state == slot_state::ambiguous)
+        {
+            indexes.push_back(index - next);
+            next = index + 1;
+        }
+    }
+
+    return get_block_transactions(header_.hash(), std::move(indexes));
+}
+
+bool compact_block_reconstructor::fill(const block_transactions& reply)
+{
+    if (!valid_ || reply.block_hash() != header_.hash())
+        return false;
+
+    const auto is_missing = [](slot_state state)
+    {
+        return state == slot_state::empty || state == slot_state::ambiguous;
+    };
+
+    // The reply must contain exactly the missing transactions, which is
+    // verified before any slot is changed so a bad reply leaves no trace.
+    const auto& transactions = reply.transactions();
+    const auto missing = std::count_if(states_.begin(), states_.end(),
+        is_missing);
+
+    if (static_cast<size_t>(missing) != transactions.size())
+        return false;
+
+    auto tx = transactions.begin();
+
+    for (size_t index = 0; index < states_.size(); ++index)
+    {
+        auto& state = states_[index];
+
+        if (!is_missing(state))
+            continue;
+
+        transactions_[index] = *tx++;
+        state = slot_state::matched;
+    }
+
+    return true;
+}
+
+bool compact_block_reconstructor::to_block(block_message& out) const
+{
+    if (!is_complete())
+        return false;
+
+    block_message block(header_, transactions_);
+
+    // A short id collision with a known transaction produces a bad root.
+    if (block.generate_merkle_root() != header_.merkle())
+        return false;
+
+    out = std::move(block);
+    return true;
+}
+
+} // namespace message
+} // namespace libbitcoin
@@ -20,10 +20,13 @@
 #include <bitcoin/bitcoin/message/headers.hpp>
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <istream>
 #include <utility>
+#include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/message/inventory.hpp>
 #include <bitcoin/bitcoin/message/inventory_vector.hpp>
@@ -32,6 +35,7 @@
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -183,6 +187,31 @@ void headers::to_inventory(inventory_vector::list& out,
     std::transform(elements_.begin(), elements_.end(), std::back_inserter(out), map);
 }
 
+// Headers are serialized into one reused buffer and hashed directly, which
+// avoids the allocation and cache lock incurred by header::hash().
+size_t headers::check_chain() const
+{
+    data_chunk serial(chain::header::satoshi_fixed_size());
+    auto previous = null_hash;
+
+    for (size_t index = 0; index < elements_.size(); ++index)
+    {
+        const chain::header& header = elements_[index];
+        auto sink = make_unsafe_serializer(serial.begin());
+        header.to_data(sink);
+        const auto current = bitcoin_hash(serial);
+
+        if ((index != 0 && header.previous_block_hash() != previous) ||
+            !chain::header::is_valid_proof_of_work(header.bits(), current) ||
+            !header.is_valid_time_stamp())
+            return index;
+
+        previous = current;
+    }
+
+    return elements_.size();
+}
+
 uint64_t headers::serialized_size(uint32_t version) const
 {
     return variable_uint_size(elements_.size()) +
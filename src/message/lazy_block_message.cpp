@@ -0,0 +1,282 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/lazy_block_message.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/message/block_message.hpp>
+#include <bitcoin/bitcoin/message/version.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+const std::string lazy_block_message::command = block_message::command;
+const uint32_t lazy_block_message::version_minimum =
+    block_message::version_minimum;
+const uint32_t lazy_block_message::version_maximum =
+    block_message::version_maximum;
+
+// Wire sizes of the fixed-width transaction fields.
+static BC_CONSTEXPR size_t version_size = sizeof(uint32_t);
+static BC_CONSTEXPR size_t locktime_size = sizeof(uint32_t);
+static BC_CONSTEXPR size_t point_size = hash_size + sizeof(uint32_t);
+static BC_CONSTEXPR size_t sequence_size = sizeof(uint32_t);
+static BC_CONSTEXPR size_t value_size = sizeof(uint64_t);
+
+// Read a variable length size and account for its own wire size.
+// The size may be encoded non-canonically, so count the bytes consumed.
+template <class Source>
+static size_t read_size(Source& source, size_t& total)
+{
+    uint64_t value = source.read_byte();
+    total += sizeof(uint8_t);
+
+    switch (value)
+    {
+        case varint_eight_bytes:
+            value = source.read_8_bytes_little_endian();
+            total += sizeof(uint64_t);
+            break;
+        case varint_four_bytes:
+            value = source.read_4_bytes_little_endian();
+            total += sizeof(uint32_t);
+            break;
+        case varint_two_bytes:
+            value = source.read_2_bytes_little_endian();
+            total += sizeof(uint16_t);
+            break;
+        default:
+            break;
+    }
+
+    if (value <= max_size_t)
+        return static_cast<size_t>(value);
+
+    source.invalidate();
+    return 0;
+}
+
+// Skip a length-prefixed script, accounting for its wire size.
+template <class Source>
+static void skip_script(Source& source, size_t& total)
+{
+    const auto size = read_size(source, total);
+    source.skip(size);
+    total += size;
+}
+
+// Skip one wire-serialized transaction, returning its size (zero if invalid).
+template <class Source>
+static size_t skip_transaction(Source& source)
+{
+    size_t total = version_size;
+    source.skip(version_size);
+
+    const auto inputs = read_size(source, total);
+
+    for (size_t input = 0; input < inputs && source; ++input)
+    {
+        source.skip(point_size);
+        skip_script(source, total);
+        source.skip(sequence_size);
+        total += point_size + sequence_size;
+    }
+
+    const auto outputs = read_size(source, total);
+
+    for (size_t output = 0; output < outputs && source; ++output)
+    {
+        source.skip(value_size);
+        skip_script(source, total);
+        total += value_size;
+    }
+
+    source.skip(locktime_size);
+    total += locktime_size;
+    return source ? total : 0;
+}
+
+lazy_block_message lazy_block_message::factory_from_data(uint32_t version,
+    const data_chunk& data)
+{
+    lazy_block_message instance;
+    instance.from_data(version, data);
+    return instance;
+}
+
+lazy_block_message lazy_block_message::factory_from_data(uint32_t version,
+    data_chunk&& data)
+{
+    lazy_block_message instance;
+    instance.from_data(version, std::move(data));
+    return instance;
+}
+
+lazy_block_message::lazy_block_message()
+  : payload_(), header_(), offsets_()
+{
+}
+
+lazy_block_message::lazy_block_message(const lazy_block_message& other)
+  : payload_(other.payload_), header_(other.header_),
+    offsets_(other.offsets_)
+{
+}
+
+lazy_block_message::lazy_block_message(lazy_block_message&& other)
+  : payload_(std::move(other.payload_)), header_(std::move(other.header_)),
+    offsets_(std::move(other.offsets_))
+{
+}
+
+bool lazy_block_message::from_data(uint32_t version, const data_chunk& data)
+{
+    return from_data(version, data_chunk(data));
+}
+
+bool lazy_block_message::from_data(uint32_t, data_chunk&& data)
+{
+    reset();
+    payload_ = std::move(data);
+
+    if (!index_transactions())
+    {
+        reset();
+        return false;
+    }
+
+    return true;
+}
+
+// private
+bool lazy_block_message::index_transactions()
+{
+    auto source = make_safe_deserializer(payload_.begin(), payload_.end());
+
+    if (!header_.from_data(source))
+        return false;
+
+    size_t offset = chain::header::satoshi_fixed_size();
+    const auto count = read_size(source, offset);
+
+    // Guard the reservation against an invalid count.
+    if (!source || count > payload_.size() - offset)
+        return false;
+
+    offsets_.reserve(count + 1);
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        offsets_.push_back(offset);
+        const auto size = skip_transaction(source);
+
+        if (size == 0)
+            return false;
+
+        offset += size;
+    }
+
+    offsets_.push_back(offset);
+
+    // The block must consume the entire payload.
+    return source && source.is_exhausted();
+}
+
+data_chunk lazy_block_message::to_data(uint32_t) const
+{
+    return payload_;
+}
+
+bool lazy_block_message::is_valid() const
+{
+    return !offsets_.empty();
+}
+
+void lazy_block_message::reset()
+{
+    payload_.clear();
+    payload_.shrink_to_fit();
+    header_ = chain::header{};
+    offsets_.clear();
+    offsets_.shrink_to_fit();
+}
+
+uint64_t lazy_block_message::serialized_size(uint32_t) const
+{
+    return payload_.size();
+}
+
+const chain::header& lazy_block_message::header() const
+{
+    return header_;
+}
+
+hash_digest lazy_block_message::hash() const
+{
+    return header_.hash();
+}
+
+size_t lazy_block_message::transaction_count() const
+{
+    return offsets_.empty() ? 0 : offsets_.size() - 1;
+}
+
+chain::transaction lazy_block_message::transaction_at(size_t index) const
+{
+    chain::transaction tx;
+
+    if (index >= transaction_count())
+        return tx;
+
+    const auto begin = payload_.begin() + offsets_[index];
+    const auto end = payload_.begin() + offsets_[index + 1];
+    auto source = make_safe_deserializer(begin, end);
+    tx.from_data(source);
+    return tx;
+}
+
+block_message lazy_block_message::to_block_message() const
+{
+    chain::transaction::list transactions;
+    transactions.reserve(transaction_count());
+
+    for (size_t index = 0; index < transaction_count(); ++index)
+        transactions.push_back(transaction_at(index));
+
+    return block_message(header_, std::move(transactions));
+}
+
+lazy_block_message& lazy_block_message::operator=(
+    lazy_block_message&& other)
+{
+    payload_ = std::move(other.payload_);
+    header_ = std::move(other.header_);
+    offsets_ = std::move(other.offsets_);
+    return *this;
+}
+
+} // namespace message
+} // namespace libbitcoin
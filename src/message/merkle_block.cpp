@@ -19,7 +19,13 @@
  */
 #include <bitcoin/bitcoin/message/merkle_block.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
@@ -79,6 +85,216 @@ merkle_block::merkle_block(chain::header&& header, uint32_t total_transactions,
 {
 }
 
+// The number of nodes at the given height of a tree with the given leaves.
+static size_t tree_width(size_t leaves, size_t height)
+{
+    return (leaves + (size_t(1) << height) - 1) >> height;
+}
+
+merkle_block::merkle_block(const chain::block& block,
+    const std::vector<bool>& matches)
+  : header_(block.header()),
+    total_transactions_(static_cast<uint32_t>(block.transactions().size())),
+    hashes_(), flags_()
+{
+    const auto& transactions = block.transactions();
+    const auto leaves = transactions.size();
+
+    // A flag is required for each transaction.
+    if (matches.size() != leaves)
+    {
+        reset();
+        return;
+    }
+
+    if (leaves == 0)
+        return;
+
+    // Compute every level of the tree once, with the leaves at level zero.
+    // Each node is marked if any leaf beneath it is matched.
+    std::vector<hash_list> levels(1);
+    std::vector<std::vector<bool>> marked(1, matches);
+    levels.front().reserve(leaves);
+
+    for (const auto& tx: transactions)
+        levels.front().push_back(tx.hash());
+
+    for (size_t height = 1; tree_width(leaves, height - 1) > 1; ++height)
+    {
+        const auto& below = levels[height - 1];
+        const auto& below_marked = marked[height - 1];
+        const auto width = tree_width(leaves, height);
+        hash_list level;
+        std::vector<bool> level_marked(width);
+        level.reserve(width);
+
+        for (size_t node = 0; node < width; ++node)
+        {
+            const auto left = 2 * node;
+            const auto right = left + 1 < below.size() ? left + 1 : left;
+            level.push_back(bitcoin_hash(splice(below[left], below[right])));
+            level_marked[node] = below_marked[left] || below_marked[right];
+        }
+
+        levels.push_back(std::move(level));
+        marked.push_back(std::move(level_marked));
+    }
+
+    // Depth-first traversal with an explicit stack, emitting a flag for each
+    // node visited and a hash for each node not descended into (or a leaf).
+    std::vector<std::pair<size_t, size_t>> stack;
+    stack.emplace_back(levels.size() - 1, 0);
+    size_t bit = 0;
+
+    while (!stack.empty())
+    {
+        const auto height = stack.back().first;
+        const auto node = stack.back().second;
+        stack.pop_back();
+
+        const auto parent_of_match = marked[height][node];
+
+        if (bit / byte_bits == flags_.size())
+            flags_.push_back(0);
+
+        if (parent_of_match)
+            flags_[bit / byte_bits] |= (1 << (bit % byte_bits));
+
+        ++bit;
+
+        if (height == 0 || !parent_of_match)
+        {
+            hashes_.push_back(levels[height][node]);
+            continue;
+        }
+
+        // Push right before left so that the left subtree is visited first.
+        const auto left = 2 * node;
+
+        if (left + 1 < levels[height - 1].size())
+            stack.emplace_back(height - 1, left + 1);
+
+        stack.emplace_back(height - 1, left);
+    }
+}
+
+bool merkle_block::is_valid_merkle_root() const
+{
+    hash_list hashes;
+    chain::block::indexes positions;
+    return extract_matches(hashes, positions);
+}
+
+// This is the inverse of the block constructor traversal. The recursion of
+// the bip37 reference implementation is unrolled onto a fixed-size stack,
+// which is bounded by the maximum tree height, so no allocation is required
+// beyond that of the results.
+bool merkle_block::extract_matches(hash_list& out_hashes,
+    chain::block::indexes& out_positions) const
+{
+    struct frame
+    {
+        size_t height;
+        size_t node;
+        bool has_left;
+        hash_digest left;
+    };
+
+    out_hashes.clear();
+    out_positions.clear();
+    const size_t leaves = total_transactions_;
+    const auto bits = flags_.size() * byte_bits;
+
+    // There must be at least one hash and flag bit per hash, and no more
+    // hashes than leaves (an unmatched single hash is the root).
+    if (leaves == 0 || hashes_.empty() || hashes_.size() > leaves ||
+        hashes_.size() > bits)
+        return false;
+
+    size_t root_height = 0;
+    while (tree_width(leaves, root_height) > 1)
+        ++root_height;
+
+    // One frame for each level from the root to the leaves.
+    static BC_CONSTEXPR size_t max_depth = sizeof(size_t) * byte_bits + 1;
+    frame stack[max_depth];
+    stack[0] = { root_height, 0, false, null_hash };
+    size_t depth = 1;
+    size_t bit = 0;
+    size_t hash = 0;
+    auto value = null_hash;
+
+    while (depth > 0)
+    {
+        auto& current = stack[depth - 1];
+
+        if (bit == bits)
+            return false;
+
+        const auto parent_of_match =
+            (flags_[bit / byte_bits] & (1 << (bit % byte_bits))) != 0;
+        ++bit;
+
+        if (current.height > 0 && parent_of_match)
+        {
+            // Descend into the left subtree.
+            stack[depth++] = { current.height - 1, 2 * current.node, false,
+                null_hash };
+            continue;
+        }
+
+        if (hash == hashes_.size())
+            return false;
+
+        value = hashes_[hash++];
+
+        if (current.height == 0 && parent_of_match)
+        {
+            out_hashes.push_back(value);
+            out_positions.push_back(current.node);
+        }
+
+        --depth;
+
+        // Combine completed subtrees upward until a right subtree remains.
+        while (depth > 0)
+        {
+            auto& parent = stack[depth - 1];
+            const auto right = 2 * parent.node + 1;
+
+            if (!parent.has_left)
+            {
+                parent.left = value;
+                parent.has_left = true;
+
+                if (right < tree_width(leaves, parent.height - 1))
+                {
+                    stack[depth++] = { parent.height - 1, right, false,
+                        null_hash };
+                    break;
+                }
+
+                value = bitcoin_hash(splice(parent.left, parent.left));
+            }
+            else
+            {
+                // Identical siblings allow distinct trees with equal roots.
+                if (value == parent.left)
+                    return false;
+
+                value = bitcoin_hash(splice(parent.left, value));
+            }
+
+            --depth;
+        }
+    }
+
+    // All hashes and all (but byte padding) flag bits must be consumed.
+    return hash == hashes_.size() &&
+        (bit + byte_bits - 1) / byte_bits == flags_.size() &&
+        value == header_.merkle();
+}
+
 merkle_block::merkle_block(const merkle_block& other)
   : merkle_block(other.header_, other.total_transactions_, other.hashes_,
       other.flags_)
@@ -83,6 +83,17 @@ void pseudo_random_fill(data_chunk& chunk)
         byte = static_cast<uint8_t>(distribution(get_twister()));
 }
 
+// std::random_device is backed by the operating system (or the processor)
+// and throws if it cannot be opened, which is not caught here.
+void secure_random_fill(data_chunk& chunk)
+{
+    std::random_device device;
+    std::uniform_int_distribution<uint16_t> distribution(0, max_uint8);
+
+    for (auto& byte: chunk)
+        byte = static_cast<uint8_t>(distribution(device));
+}
+
 // Randomly select a time duration in the range:
 // [(expiration - expiration / ratio) .. expiration]
 // Not fully testable due to lack of random engine injection.
@@ -19,13 +19,18 @@
  */
 #include <bitcoin/bitcoin/utility/thread.hpp>
 
+#include <cstddef>
+#include <fstream>
 #include <stdexcept>
+#include <string>
+#include <bitcoin/bitcoin/utility/string.hpp>
 
 #ifdef _MSC_VER
     #include <windows.h>
 #else
     #include <unistd.h>
     #include <pthread.h>
+    #include <sched.h>
     #include <sys/resource.h>
     #include <sys/types.h>
     #ifndef PRIO_MAX
@@ -71,4 +76,112 @@ void set_thread_priority(thread_priority priority)
 #endif
 }
 
+// Processor indexes are bounded to reject unreasonable ranges.
+static const size_t max_processors = 4096;
+
+// Apply the processor set to the current thread where supported.
+bool set_thread_affinity(const processor_set& processors)
+{
+    if (processors.empty())
+        return true;
+
+#if defined(_MSC_VER)
+    DWORD_PTR mask = 0;
+    for (const auto processor: processors)
+    {
+        if (processor >= sizeof(mask) * 8)
+            return false;
+
+        mask |= DWORD_PTR(1) << processor;
+    }
+
+    return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const auto processor: processors)
+    {
+        if (processor >= CPU_SETSIZE)
+            return false;
+
+        CPU_SET(processor, &set);
+    }
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    // Affinity is advisory at best on other platforms (e.g. macOS).
+    return false;
+#endif
+}
+
+// Set the name of the current thread where supported.
+void set_thread_name(const std::string& name)
+{
+#if defined(__linux__)
+    // The linux limit is 16 bytes including the null terminator.
+    static const size_t limit = 15;
+    pthread_setname_np(pthread_self(), name.substr(0, limit).c_str());
+#elif defined(__APPLE__)
+    pthread_setname_np(name.c_str());
+#endif
+}
+
+// Parse one non-empty decimal processor index, false if invalid.
+static bool parse_processor(size_t& out, const std::string& text)
+{
+    if (text.empty() || text.size() > 4)
+        return false;
+
+    out = 0;
+    for (const auto character: text)
+    {
+        if (character < '0' || character > '9')
+            return false;
+
+        out = out * 10 + (character - '0');
+    }
+
+    return out < max_processors;
+}
+
+processor_set parse_processors(const std::string& list)
+{
+    processor_set out;
+
+    for (const auto& token: split(list, ","))
+    {
+        const auto dash = token.find('-');
+        const auto first_text = token.substr(0, dash);
+        const auto last_text = dash == std::string::npos ? first_text :
+            token.substr(dash + 1);
+
+        size_t first;
+        size_t last;
+        if (!parse_processor(first, first_text) ||
+            !parse_processor(last, last_text) || last < first)
+            return{};
+
+        for (auto processor = first; processor <= last; ++processor)
+            out.push_back(processor);
+    }
+
+    return out;
+}
+
+processor_set numa_processors(size_t node)
+{
+#if defined(__linux__)
+    std::ifstream file("/sys/devices/system/node/node" +
+        std::to_string(node) + "/cpulist");
+
+    std::string list;
+    if (!std::getline(file, list))
+        return{};
+
+    return parse_processors(list);
+#else
+    return{};
+#endif
+}
+
 } // namespace libbitcoin
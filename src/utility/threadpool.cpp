@@ -19,8 +19,10 @@
  */
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <new>
+#include <string>
 #include <thread>
 #include <bitcoin/bitcoin/utility/asio.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
@@ -32,6 +34,12 @@ threadpool::threadpool(size_t number_threads, thread_priority priority)
     spawn(number_threads, priority);
 }
 
+threadpool::threadpool(size_t number_threads, thread_priority priority,
+    const thread_placement& placement)
+{
+    spawn(number_threads, priority, placement);
+}
+
 threadpool::~threadpool()
 {
     shutdown();
@@ -42,9 +50,9 @@ bool threadpool::empty() const
 {
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
-    shared_lock(threads_mutex);
+    shared_lock lock(threads_mutex_);
 
-    return threads_.size() != 0;
+    return threads_.empty();
     ///////////////////////////////////////////////////////////////////////////
 }
 
@@ -53,7 +61,7 @@ size_t threadpool::size() const
 {
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
-    shared_lock(threads_mutex);
+    shared_lock lock(threads_mutex_);
 
     return threads_.size();
     ///////////////////////////////////////////////////////////////////////////
@@ -61,13 +69,21 @@ size_t threadpool::size() const
 
 // Not thread safe.
 void threadpool::spawn(size_t number_threads, thread_priority priority)
+{
+    spawn(number_threads, priority, thread_placement{ {}, {}, false });
+}
+
+// Not thread safe.
+void threadpool::spawn(size_t number_threads, thread_priority priority,
+    const thread_placement& placement)
 {
     for (size_t i = 0; i < number_threads; ++i)
-        spawn_once(priority);
+        spawn_once(priority, placement);
 }
 
 // Not thread safe.
-void threadpool::spawn_once(thread_priority priority)
+void threadpool::spawn_once(thread_priority priority,
+    const thread_placement& placement)
 {
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
@@ -86,16 +102,29 @@ void threadpool::spawn_once(thread_priority priority)
     work_mutex_.unlock_upgrade();
     ///////////////////////////////////////////////////////////////////////////
 
-    const auto action = [this, priority]
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(threads_mutex_);
+
+    const auto index = threads_.size();
+    const auto& processors = placement.processors;
+    const auto name = placement.name.empty() ? std::string() :
+        placement.name + "-" + std::to_string(index);
+
+    // A pinned thread takes the next processor of the set in turn.
+    const auto affinity = !placement.pin || processors.empty() ? processors :
+        processor_set{ processors[index % processors.size()] };
+
+    const auto action = [this, priority, name, affinity]
     {
+        if (!name.empty())
+            set_thread_name(name);
+
+        set_thread_affinity(affinity);
         set_thread_priority(priority);
         service_.run();
     };
 
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    unique_lock(threads_mutex);
-
     threads_.push_back(asio::thread(action));
     ///////////////////////////////////////////////////////////////////////////
 }
@@ -147,19 +147,19 @@ ec_private::operator const ec_secret&() const
 // Conversion to WIF loses payment address version info.
 std::string ec_private::encoded() const
 {
+    const auto prefix = to_array(wif_version());
+
     if (compressed())
     {
-        wif_compressed wif;
-        const auto prefix = to_array(wif_version());
-        const auto compressed = to_array(compressed_sentinel);
-        build_checked_array(wif, { prefix, secret_, compressed });
-        return encode_base58(wif);
+        byte_array<1 + ec_secret_size + 1> payload;
+        build_array(payload,
+            { prefix, secret_, to_array(compressed_sentinel) });
+        return encode_base58_checked(payload);
     }
 
-    wif_uncompressed wif;
-    const auto prefix = to_array(wif_version());
-    build_checked_array(wif, { prefix, secret_ });
-    return encode_base58(wif);
+    byte_array<1 + ec_secret_size> payload;
+    build_array(payload, { prefix, secret_ });
+    return encode_base58_checked(payload);
 }
 
 // Accessors.
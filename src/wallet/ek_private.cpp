@@ -58,7 +58,7 @@ ek_private ek_private::from_string(const std::string& encoded)
     // TODO: incorporate existing parser here, setting new members.
 
     encrypted_private key;
-    return decode_base58(key, encoded) && verify_checksum(key) ?
+    return decode_base58_checked(key, encoded) ?
         ek_private(key) : ek_private();
 }
 
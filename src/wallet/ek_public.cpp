@@ -58,7 +58,7 @@ ek_public ek_public::from_string(const std::string& encoded)
     // TODO: incorporate existing parser here, setting new members.
 
     encrypted_public key;
-    return decode_base58(key, encoded) && verify_checksum(key) ?
+    return decode_base58_checked(key, encoded) ?
         ek_public(key) : ek_public();
 }
 
@@ -58,7 +58,7 @@ ek_token ek_token::from_string(const std::string& encoded)
     // TODO: incorporate existing parser here, setting new members.
 
     encrypted_token key;
-    return decode_base58(key, encoded) && verify_checksum(key) ?
+    return decode_base58_checked(key, encoded) ?
         ek_token(key) : ek_token();
 }
 
@@ -22,7 +22,10 @@
 #include <cstdint>
 #include <cstddef>
 #include <algorithm>
+#include <map>
 #include <stdexcept>
+#include <string>
+#include <vector>
 #include <boost/locale.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/checksum.hpp>
@@ -40,6 +43,7 @@
 #include "parse_encrypted_keys/parse_encrypted_private.hpp"
 #include "parse_encrypted_keys/parse_encrypted_public.hpp"
 #include "parse_encrypted_keys/parse_encrypted_token.hpp"
+#include "../math/external/zeroize.h"
 
 namespace libbitcoin {
 namespace wallet {
@@ -125,10 +129,12 @@ static one_byte point_sign(const one_byte& single, const hash_digest& hash)
 // scrypt_
 // ----------------------------------------------------------------------------
 
-static hash_digest scrypt_token(data_slice data, data_slice salt)
+static hash_digest scrypt_token(data_slice data, data_slice salt,
+    scrypt_arena& arena)
 {
     // Arbitrary scrypt parameters from BIP38.
-    return scrypt<hash_size>(data, salt, 16384u, 8u, 8u);
+    return to_array<hash_size>({ arena.hash(data, salt, 16384u, 8u, 8u,
+        hash_size) });
 }
 
 static long_hash scrypt_pair(data_slice data, data_slice salt)
@@ -137,10 +143,12 @@ static long_hash scrypt_pair(data_slice data, data_slice salt)
     return scrypt<long_hash_size>(data, salt, 1024u, 1u, 1u);
 }
 
-static long_hash scrypt_private(data_slice data, data_slice salt)
+static long_hash scrypt_private(data_slice data, data_slice salt,
+    scrypt_arena& arena)
 {
     // Arbitrary scrypt parameters from BIP38.
-    return scrypt<long_hash_size>(data, salt, 16384u, 8u, 8u);
+    return to_array<long_hash_size>({ arena.hash(data, salt, 16384u, 8u, 8u,
+        long_hash_size) });
 }
 
 // set_flags
@@ -296,8 +304,9 @@ static bool create_token(encrypted_token& out_token,
     BITCOIN_ASSERT(owner_salt.size() == ek_salt_size ||
         owner_salt.size() == ek_entropy_size);
 
+    scrypt_arena arena;
     const auto lot_sequence = owner_salt.size() == ek_salt_size;
-    auto factor = scrypt_token(normal(passphrase), owner_salt);
+    auto factor = scrypt_token(normal(passphrase), owner_salt, arena);
 
     if (lot_sequence)
         factor = bitcoin_hash(splice(factor, owner_entropy));
@@ -343,14 +352,15 @@ bool create_token(encrypted_token& out_token, const std::string& passphrase,
 // encrypt
 // ----------------------------------------------------------------------------
 
-bool encrypt(encrypted_private& out_private, const ec_secret& secret,
-    const std::string& passphrase, uint8_t version, bool compressed)
+static bool encrypt_secret(encrypted_private& out_private,
+    const ec_secret& secret, data_slice passphrase, uint8_t version,
+    bool compressed, scrypt_arena& arena)
 {
     ek_salt salt;
     if (!address_salt(salt, secret, version, compressed))
         return false;
 
-    const auto derived = split(scrypt_private(normal(passphrase), salt));
+    const auto derived = split(scrypt_private(passphrase, salt, arena));
     const auto prefix = parse_encrypted_private::prefix_factory(version,
         false);
 
@@ -370,13 +380,55 @@ bool encrypt(encrypted_private& out_private, const ec_secret& secret,
     });
 }
 
+bool encrypt(encrypted_private& out_private, const ec_secret& secret,
+    const std::string& passphrase, uint8_t version, bool compressed)
+{
+    scrypt_arena arena;
+    return encrypt_secret(out_private, secret, normal(passphrase), version,
+        compressed, arena);
+}
+
+static bool encrypt_secrets(encrypted_private_list& out_private,
+    const secret_list& secrets, const std::string& passphrase,
+    uint8_t version, bool compressed, scrypt_arena& arena)
+{
+    const auto normalized = normal(passphrase);
+    encrypted_private_list keys(secrets.size());
+
+    for (size_t index = 0; index < secrets.size(); ++index)
+        if (!encrypt_secret(keys[index], secrets[index], normalized, version,
+            compressed, arena))
+            return false;
+
+    out_private = std::move(keys);
+    return true;
+}
+
+bool encrypt(encrypted_private_list& out_private, const secret_list& secrets,
+    const std::string& passphrase, uint8_t version, bool compressed)
+{
+    scrypt_arena arena;
+    return encrypt_secrets(out_private, secrets, passphrase, version,
+        compressed, arena);
+}
+
+bool encrypt(encrypted_private_list& out_private, const secret_list& secrets,
+    const std::string& passphrase, uint8_t version, bool compressed,
+    threadpool& pool, size_t lanes)
+{
+    scrypt_arena arena(pool, lanes);
+    return encrypt_secrets(out_private, secrets, passphrase, version,
+        compressed, arena);
+}
+
 // decrypt private_key
 // ----------------------------------------------------------------------------
 
+// The prefactor is the scrypt of the passphrase over the owner salt.
 static bool decrypt_multiplied(ec_secret& out_secret,
-    const parse_encrypted_private& parse, const std::string& passphrase)
+    const parse_encrypted_private& parse, const hash_digest& prefactor)
 {
-    auto secret = scrypt_token(normal(passphrase), parse.owner_salt());
+    auto secret = prefactor;
 
     if (parse.lot_sequence())
         secret = bitcoin_hash(splice(secret, parse.entropy()));
@@ -412,12 +464,13 @@ static bool decrypt_multiplied(ec_secret& out_secret,
 }
 
 static bool decrypt_secret(ec_secret& out_secret,
-    const parse_encrypted_private& parse, const std::string& passphrase)
+    const parse_encrypted_private& parse, data_slice passphrase,
+    scrypt_arena& arena)
 {
     auto encrypt1 = splice(parse.entropy(), parse.data1());
     auto encrypt2 = parse.data2();
-    const auto derived = split(scrypt_private(normal(passphrase),
-        parse.salt()));
+    const auto derived = split(scrypt_private(passphrase, parse.salt(),
+        arena));
 
     aes256_decrypt(derived.right, encrypt1);
     aes256_decrypt(derived.right, encrypt2);
@@ -441,9 +494,12 @@ bool decrypt(ec_secret& out_secret, uint8_t& out_version, bool& out_compressed,
     if (!parse.valid())
         return false;
 
+    scrypt_arena arena;
+    const auto normalized = normal(passphrase);
     const auto success = parse.multiplied() ?
-        decrypt_multiplied(out_secret, parse, passphrase) :
-        decrypt_secret(out_secret, parse, passphrase);
+        decrypt_multiplied(out_secret, parse,
+            scrypt_token(normalized, parse.owner_salt(), arena)) :
+        decrypt_secret(out_secret, parse, normalized, arena);
 
     if (success)
     {
@@ -454,6 +510,88 @@ bool decrypt(ec_secret& out_secret, uint8_t& out_version, bool& out_compressed,
     return success;
 }
 
+// Keys created from one token share an owner salt and so a prefactor.
+typedef std::map<data_chunk, hash_digest> prefactor_map;
+
+static bool decrypt_secrets(secret_list& out_secrets,
+    data_chunk& out_versions, std::vector<bool>& out_compressed,
+    const encrypted_private_list& keys, const std::string& passphrase,
+    scrypt_arena& arena, prefactor_map& prefactors)
+{
+    const auto normalized = normal(passphrase);
+    secret_list secrets(keys.size());
+    data_chunk versions(keys.size());
+    std::vector<bool> compressions(keys.size());
+
+    for (size_t index = 0; index < keys.size(); ++index)
+    {
+        const parse_encrypted_private parse(keys[index]);
+        if (!parse.valid())
+            return false;
+
+        auto& secret = secrets[index];
+
+        if (parse.multiplied())
+        {
+            const auto owner_salt = parse.owner_salt();
+            auto it = prefactors.find(owner_salt);
+
+            if (it == prefactors.end())
+                it = prefactors.emplace(owner_salt,
+                    scrypt_token(normalized, owner_salt, arena)).first;
+
+            if (!decrypt_multiplied(secret, parse, it->second))
+                return false;
+        }
+        else if (!decrypt_secret(secret, parse, normalized, arena))
+        {
+            return false;
+        }
+
+        versions[index] = parse.address_version();
+        compressions[index] = parse.compressed();
+    }
+
+    out_secrets = std::move(secrets);
+    out_versions = std::move(versions);
+    out_compressed = std::move(compressions);
+    return true;
+}
+
+static bool decrypt_secrets(secret_list& out_secrets,
+    data_chunk& out_versions, std::vector<bool>& out_compressed,
+    const encrypted_private_list& keys, const std::string& passphrase,
+    scrypt_arena& arena)
+{
+    prefactor_map prefactors;
+    const auto success = decrypt_secrets(out_secrets, out_versions,
+        out_compressed, keys, passphrase, arena, prefactors);
+
+    // A prefactor decrypts every key of its token, so is not left in memory.
+    for (auto& prefactor: prefactors)
+        zeroize(prefactor.second.data(), prefactor.second.size());
+
+    return success;
+}
+
+bool decrypt(secret_list& out_secrets, data_chunk& out_versions,
+    std::vector<bool>& out_compressed, const encrypted_private_list& keys,
+    const std::string& passphrase)
+{
+    scrypt_arena arena;
+    return decrypt_secrets(out_secrets, out_versions, out_compressed, keys,
+        passphrase, arena);
+}
+
+bool decrypt(secret_list& out_secrets, data_chunk& out_versions,
+    std::vector<bool>& out_compressed, const encrypted_private_list& keys,
+    const std::string& passphrase, threadpool& pool, size_t lanes)
+{
+    scrypt_arena arena(pool, lanes);
+    return decrypt_secrets(out_secrets, out_versions, out_compressed, keys,
+        passphrase, arena);
+}
+
 // decrypt public_key
 // ----------------------------------------------------------------------------
 
@@ -467,7 +605,8 @@ bool decrypt(ec_compressed& out_point, uint8_t& out_version,
 
     const auto version = parse.address_version();
     const auto lot_sequence = parse.lot_sequence();
-    auto factor = scrypt_token(normal(passphrase), parse.owner_salt());
+    scrypt_arena arena;
+    auto factor = scrypt_token(normal(passphrase), parse.owner_salt(), arena);
 
     if (lot_sequence)
         factor = bitcoin_hash(splice(factor, parse.entropy()));
@@ -19,6 +19,8 @@
  */
 #include <bitcoin/bitcoin/wallet/hd_private.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <boost/program_options.hpp>
@@ -34,7 +36,9 @@
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
 #include <bitcoin/bitcoin/utility/serializer.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/wallet/ec_private.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
 
@@ -168,7 +172,7 @@ hd_private hd_private::from_string(const std::string& encoded,
     uint32_t public_prefix)
 {
     hd_key key;
-    if (!decode_base58(key, encoded))
+    if (!decode_base58_checked(key, encoded))
         return{};
 
     return hd_private(from_key(key, public_prefix));
@@ -178,7 +182,7 @@ hd_private hd_private::from_string(const std::string& encoded,
     uint64_t prefixes)
 {
     hd_key key;
-    return decode_base58(key, encoded) ? hd_private(key, prefixes) :
+    return decode_base58_checked(key, encoded) ? hd_private(key, prefixes) :
         hd_private{};
 }
 
@@ -195,7 +199,7 @@ hd_private::operator const ec_secret&() const
 
 std::string hd_private::encoded() const
 {
-    return encode_base58(to_hd_key());
+    return encode_base58_checked(to_payload());
 }
 
 /// Accessors.
@@ -213,11 +217,19 @@ const ec_secret& hd_private::secret() const
 // So we are currently not converting to ec_public or ec_private.
 
 hd_key hd_private::to_hd_key() const
+{
+    hd_key out;
+    build_checked_array(out, { to_payload() });
+    return out;
+}
+
+// private
+hd_key_payload hd_private::to_payload() const
 {
     static constexpr uint8_t private_key_padding = 0x00;
 
-    hd_key out;
-    build_checked_array(out,
+    hd_key_payload out;
+    build_array(out,
     {
         to_big_endian(to_prefix(lineage_.prefixes)),
         to_array(lineage_.depth),
@@ -271,6 +283,82 @@ hd_public hd_private::derive_public(uint32_t index) const
     return derive_private(index).to_public();
 }
 
+hd_private::list hd_private::derive_range(uint32_t first,
+    uint32_t count) const
+{
+    list out(count);
+    derive_part(out, first, 0, count);
+    return out;
+}
+
+hd_private::list hd_private::derive_range(uint32_t first, uint32_t count,
+    threadpool& pool) const
+{
+    list out(count);
+    const auto derive = [&](size_t begin, size_t end)
+    {
+        derive_part(out, first, begin, end);
+    };
+
+    parallel_for(pool, count, derive);
+    return out;
+}
+
+// Derive children [first + begin, first + end) into the same positions.
+void hd_private::derive_part(list& out, uint32_t first, size_t begin,
+    size_t end) const
+{
+    constexpr uint8_t depth = 0;
+
+    if (lineage_.depth == max_uint8)
+        return;
+
+    // Indexes cannot wrap.
+    const auto limit = uint64_t(max_uint32) - first + 1;
+    if (end > limit)
+        end = static_cast<size_t>(limit);
+
+    // The parent key and fingerprint are common to all children, so they
+    // are serialized and hashed once, leaving only the index to update.
+    auto normal = splice(point_, to_big_endian(first));
+    auto hardened = splice(to_array(depth), secret_, to_big_endian(first));
+
+    hd_lineage lineage
+    {
+        lineage_.prefixes,
+        static_cast<uint8_t>(lineage_.depth + 1),
+        fingerprint(),
+        0
+    };
+
+    // The chain code keys every child, so its hmac state is computed once.
+    const hmac_sha512_context hmac(chain_);
+
+    for (auto position = begin; position < end; ++position)
+    {
+        const auto index = static_cast<uint32_t>(first + position);
+        const auto bytes = to_big_endian(index);
+        const auto is_hardened = index >= hd_first_hardened_key;
+        const data_slice data = is_hardened ? data_slice(hardened) :
+            data_slice(normal);
+
+        // Both serializations are the 33 byte key followed by the index.
+        std::copy(bytes.begin(), bytes.end(), is_hardened ?
+            hardened.begin() + ec_compressed_size :
+            normal.begin() + ec_compressed_size);
+
+        const auto intermediate = split(hmac.hash(data));
+
+        // The child key ki is (parse256(IL) + kpar) mod n:
+        auto child = secret_;
+        if (!ec_add(child, intermediate.left))
+            continue;
+
+        lineage.child_number = index;
+        out[position] = hd_private(child, intermediate.right, lineage);
+    }
+}
+
 // Operators.
 // ----------------------------------------------------------------------------
 
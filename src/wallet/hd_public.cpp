@@ -19,6 +19,8 @@
  */
 #include <bitcoin/bitcoin/wallet/hd_public.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <boost/program_options.hpp>
@@ -33,6 +35,8 @@
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
 #include <bitcoin/bitcoin/wallet/hd_private.hpp>
 
@@ -107,7 +111,7 @@ hd_public hd_public::from_key(const hd_key& key)
 hd_public hd_public::from_string(const std::string& encoded)
 {
     hd_key key;
-    if (!decode_base58(key, encoded))
+    if (!decode_base58_checked(key, encoded))
         return{};
 
     return hd_public(from_key(key));
@@ -146,7 +150,7 @@ hd_public hd_public::from_string(const std::string& encoded,
     uint32_t prefix)
 {
     hd_key key;
-    if (!decode_base58(key, encoded))
+    if (!decode_base58_checked(key, encoded))
         return{};
 
     return hd_public(from_key(key, prefix));
@@ -170,7 +174,7 @@ hd_public::operator const ec_compressed&() const
 
 std::string hd_public::encoded() const
 {
-    return encode_base58(to_hd_key());
+    return encode_base58_checked(to_payload());
 }
 
 // Accessors.
@@ -200,7 +204,15 @@ const ec_compressed& hd_public::point() const
 hd_key hd_public::to_hd_key() const
 {
     hd_key out;
-    build_checked_array(out,
+    build_checked_array(out, { to_payload() });
+    return out;
+}
+
+// private
+hd_key_payload hd_public::to_payload() const
+{
+    hd_key_payload out;
+    build_array(out,
     {
         to_big_endian(to_prefix(lineage_.prefixes)),
         to_array(lineage_.depth),
@@ -240,6 +252,71 @@ hd_public hd_public::derive_public(uint32_t index) const
     return hd_public(combined, intermediate.right, lineage);
 }
 
+hd_public::list hd_public::derive_range(uint32_t first, uint32_t count) const
+{
+    list out(count);
+    derive_part(out, first, 0, count);
+    return out;
+}
+
+hd_public::list hd_public::derive_range(uint32_t first, uint32_t count,
+    threadpool& pool) const
+{
+    list out(count);
+    const auto derive = [&](size_t begin, size_t end)
+    {
+        derive_part(out, first, begin, end);
+    };
+
+    parallel_for(pool, count, derive);
+    return out;
+}
+
+// Derive children [first + begin, first + end) into the same positions.
+void hd_public::derive_part(list& out, uint32_t first, size_t begin,
+    size_t end) const
+{
+    if (lineage_.depth == max_uint8)
+        return;
+
+    // Only non-hardened children can be derived, and indexes cannot wrap.
+    const auto limit = hd_first_hardened_key > first ?
+        hd_first_hardened_key - first : 0;
+    end = std::min(end, static_cast<size_t>(limit));
+
+    // The parent point and fingerprint are common to all children, so they
+    // are serialized and hashed once, leaving only the index to update.
+    auto data = splice(point_, to_big_endian(first));
+    const auto index_begin = data.begin() + ec_compressed_size;
+
+    hd_lineage lineage
+    {
+        lineage_.prefixes,
+        static_cast<uint8_t>(lineage_.depth + 1),
+        fingerprint(),
+        0
+    };
+
+    // The chain code keys every child, so its hmac state is computed once.
+    const hmac_sha512_context hmac(chain_);
+
+    for (auto position = begin; position < end; ++position)
+    {
+        const auto index = static_cast<uint32_t>(first + position);
+        const auto bytes = to_big_endian(index);
+        std::copy(bytes.begin(), bytes.end(), index_begin);
+        const auto intermediate = split(hmac.hash(data));
+
+        // The returned child key Ki is point(parse256(IL)) + Kpar.
+        auto combined = point_;
+        if (!ec_add(combined, intermediate.left))
+            continue;
+
+        lineage.child_number = index;
+        out[position] = hd_public(combined, intermediate.right, lineage);
+    }
+}
+
 // Helpers.
 // ----------------------------------------------------------------------------
 
@@ -20,7 +20,11 @@
 #include <bitcoin/bitcoin/wallet/mnemonic.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <string>
+#include <vector>
 #include <boost/locale.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/unicode/unicode.hpp>
@@ -40,14 +44,110 @@ static constexpr size_t entropy_bit_divisor = 32;
 static constexpr size_t hmac_iterations = 2048;
 static const char* passphrase_prefix = "mnemonic";
 
+// Word index private constants.
+static constexpr size_t index_slots = 2 * dictionary_size;
+static constexpr uint16_t empty_slot = dictionary_size;
+
 inline uint8_t bip39_shift(size_t bit)
 {
     return (1 << (byte_bits - (bit % byte_bits) - 1));
 }
 
-bool validate_mnemonic(const word_list& words, const dictionary& lexicon)
+// word_index
+// ----------------------------------------------------------------------------
+
+// An open addressed hash index of the positions of dictionary words.
+// The table is half full, so a lookup averages close to one comparison.
+class word_index
 {
-    const auto word_count = words.size();
+public:
+    // A word hash is computed once and used to probe all indexes.
+    static uint32_t hash(const std::string& word)
+    {
+        // FNV-1a
+        uint32_t hash = 0x811c9dc5;
+        for (const auto character: word)
+            hash = (hash ^ static_cast<uint8_t>(character)) * 0x01000193;
+
+        return hash;
+    }
+
+    word_index(const dictionary& lexicon)
+      : lexicon_(lexicon)
+    {
+        slots_.fill(empty_slot);
+
+        for (size_t position = 0; position < lexicon.size(); ++position)
+        {
+            auto slot = hash(lexicon[position]) % index_slots;
+            while (slots_[slot] != empty_slot)
+                slot = (slot + 1) % index_slots;
+
+            slots_[slot] = static_cast<uint16_t>(position);
+        }
+    }
+
+    const dictionary& lexicon() const
+    {
+        return lexicon_;
+    }
+
+    // Returns the dictionary position of the word, or -1 if not found.
+    int find(const std::string& word, uint32_t hash) const
+    {
+        for (auto slot = hash % index_slots; slots_[slot] != empty_slot;
+            slot = (slot + 1) % index_slots)
+            if (word == lexicon_[slots_[slot]])
+                return slots_[slot];
+
+        return -1;
+    }
+
+private:
+    const dictionary& lexicon_;
+    std::array<uint16_t, index_slots> slots_;
+};
+
+// The built-in dictionaries are constant initialized, so may be indexed
+// during the dynamic initialization of this translation unit.
+static const std::array<word_index, 5> indexes
+{
+    {
+        { language::en },
+        { language::es },
+        { language::ja },
+        { language::zh_Hans },
+        { language::zh_Hant }
+    }
+};
+
+// Copies of built-in dictionaries share the index of the original.
+static const word_index* find_index(const dictionary& lexicon)
+{
+    for (const auto& index: indexes)
+        if (&index.lexicon() == &lexicon)
+            return &index;
+
+    for (const auto& index: indexes)
+        if (index.lexicon() == lexicon)
+            return &index;
+
+    return nullptr;
+}
+
+// Returns the dictionary position of the word, or -1 if not found.
+static int find_word(const word_index* index, const dictionary& lexicon,
+    const std::string& word, uint32_t hash)
+{
+    return index == nullptr ? find_position(lexicon, word) :
+        index->find(word, hash);
+}
+
+// Pack the word positions and verify the checksum, setting the entropy.
+static bool to_entropy(data_chunk& out_entropy,
+    const std::vector<uint16_t>& positions)
+{
+    const auto word_count = positions.size();
     if ((word_count % mnemonic_word_multiple) != 0)
         return false;
 
@@ -60,12 +160,8 @@ bool validate_mnemonic(const word_list& words, const dictionary& lexicon)
     size_t bit = 0;
     data_chunk data((total_bits + byte_bits - 1) / byte_bits, 0);
 
-    for (const auto& word: words)
+    for (const auto position: positions)
     {
-        const auto position = find_position(lexicon, word);
-        if (position == -1)
-            return false;
-
         for (size_t loop = 0; loop < bits_per_word; loop++, bit++)
         {
             if (position & (1 << (bits_per_word - loop - 1)))
@@ -76,10 +172,46 @@ bool validate_mnemonic(const word_list& words, const dictionary& lexicon)
         }
     }
 
-    data.resize(entropy_bits / byte_bits);
+    // The check bits are the leading bits of the entropy hash.
+    const auto entropy_bytes = entropy_bits / byte_bits;
+    const data_slice entropy(data.data(), data.data() + entropy_bytes);
+    const auto hash = sha256_hash(entropy);
 
-    const auto mnemonic = create_mnemonic(data, lexicon);
-    return std::equal(mnemonic.begin(), mnemonic.end(), words.begin());
+    bit = entropy_bits;
+    for (size_t check = 0; check < check_bits; ++check, ++bit)
+    {
+        const auto bit_set = (data[bit / byte_bits] & bip39_shift(bit)) != 0;
+        if (bit_set != ((hash[check / byte_bits] & bip39_shift(check)) != 0))
+            return false;
+    }
+
+    data.resize(entropy_bytes);
+    out_entropy = std::move(data);
+    return true;
+}
+
+bool validate_mnemonic(const word_list& words, const dictionary& lexicon)
+{
+    if ((words.size() % mnemonic_word_multiple) != 0)
+        return false;
+
+    const auto index = find_index(lexicon);
+    std::vector<uint16_t> positions;
+    positions.reserve(words.size());
+
+    for (const auto& word: words)
+    {
+        const auto position = find_word(index, lexicon, word,
+            word_index::hash(word));
+
+        if (position == -1)
+            return false;
+
+        positions.push_back(static_cast<uint16_t>(position));
+    }
+
+    data_chunk entropy;
+    return to_entropy(entropy, positions);
 }
 
 word_list create_mnemonic(data_slice entropy, const dictionary &lexicon)
@@ -125,9 +257,61 @@ word_list create_mnemonic(data_slice entropy, const dictionary &lexicon)
 bool validate_mnemonic(const word_list& mnemonic,
     const dictionary_list& lexicons)
 {
-    for (const auto& lexicon: lexicons)
-        if (validate_mnemonic(mnemonic, *lexicon))
+    data_chunk entropy;
+    const dictionary* lexicon;
+    return decode_entropy(entropy, lexicon, mnemonic, lexicons);
+}
+
+bool decode_entropy(data_chunk& out_entropy, const dictionary*& out_lexicon,
+    const word_list& mnemonic, const dictionary_list& lexicons)
+{
+    if ((mnemonic.size() % mnemonic_word_multiple) != 0)
+        return false;
+
+    // Each language remains a candidate until one of its words is missing.
+    const auto count = lexicons.size();
+    std::vector<const word_index*> candidates(count);
+    std::vector<std::vector<uint16_t>> positions(count);
+    std::vector<bool> found(count, true);
+
+    for (size_t language = 0; language < count; ++language)
+    {
+        candidates[language] = find_index(*lexicons[language]);
+        positions[language].reserve(mnemonic.size());
+    }
+
+    // Each word is hashed once and resolved against each candidate.
+    for (const auto& word: mnemonic)
+    {
+        const auto hash = word_index::hash(word);
+        auto remaining = false;
+
+        for (size_t language = 0; language < count; ++language)
+        {
+            if (!found[language])
+                continue;
+
+            const auto position = find_word(candidates[language],
+                *lexicons[language], word, hash);
+
+            found[language] = position != -1;
+            remaining |= found[language];
+            positions[language].push_back(static_cast<uint16_t>(position));
+        }
+
+        if (!remaining)
+            return false;
+    }
+
+    // Languages may share words, so the first to pass the checksum is used.
+    for (size_t language = 0; language < count; ++language)
+    {
+        if (found[language] && to_entropy(out_entropy, positions[language]))
+        {
+            out_lexicon = lexicons[language];
             return true;
+        }
+    }
 
     return false;
 }
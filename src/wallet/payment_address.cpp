@@ -95,7 +95,7 @@ bool payment_address::is_address(data_slice decoded)
 payment_address payment_address::from_string(const std::string& address)
 {
     payment decoded;
-    if (!decode_base58(decoded, address) || !is_address(decoded))
+    if (!decode_base58_checked(decoded, address))
         return payment_address();
 
     return payment_address(decoded);
@@ -154,7 +154,9 @@ payment_address::operator const short_hash&() const
 
 std::string payment_address::encoded() const
 {
-    return encode_base58(wrap(version_, hash_));
+    byte_array<1 + short_hash_size> payload;
+    build_array(payload, { to_array(version_), hash_ });
+    return encode_base58_checked(payload);
 }
 
 // Accessors.
@@ -20,19 +20,48 @@
 #include <bitcoin/bitcoin/wallet/select_outputs.hpp>
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <vector>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/formats/base_16.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/random.hpp>
+#include <bitcoin/bitcoin/wallet/unspent_index.hpp>
 
 namespace libbitcoin {
 namespace wallet {
 
 using namespace bc::chain;
 
+typedef unspent_index::iterator iterator;
+typedef unspent_index::reverse_iterator reverse_iterator;
+
+// Branch and bound gives up after this many steps of its search.
+static constexpr size_t branch_and_bound_tries = 100000;
+
+// Knapsack takes the best of this many random subsets.
+static constexpr size_t knapsack_iterations = 1000;
+
+// Knapsack considers at most this many of the largest lesser outputs.
+static constexpr size_t knapsack_window = 1024;
+
+template <typename Iterator>
+static void to_points_info(points_info& out, const std::vector<Iterator>& in,
+    uint64_t value, uint64_t minimum_value)
+{
+    BITCOIN_ASSERT(value >= minimum_value);
+    out.change = value - minimum_value;
+    out.points.reserve(in.size());
+
+    for (const auto& it: in)
+        out.points.push_back(it->second);
+}
+
 void select_outputs::select(points_info& out, output_info::list unspent,
-    uint64_t minimum_value, algorithm DEBUG_ONLY(option))
+    uint64_t minimum_value, algorithm option)
 {
     out.change = 0;
     out.points.clear();
@@ -40,6 +69,12 @@ void select_outputs::select(points_info& out, output_info::list unspent,
     if (unspent.empty())
         return;
 
+    if (option != algorithm::greedy)
+    {
+        select(out, unspent_index(unspent), minimum_value, option);
+        return;
+    }
+
     const auto below_minimum = [minimum_value](const output_info& out_info)
     {
         return out_info.value < minimum_value;
@@ -92,5 +127,259 @@ void select_outputs::select(points_info& out, output_info::list unspent,
     out.points.clear();
 }
 
+void select_outputs::select(points_info& out, const unspent_index& unspent,
+    uint64_t minimum_value, algorithm option, uint64_t cost_of_change)
+{
+    out.change = 0;
+    out.points.clear();
+
+    if (unspent.empty() || unspent.total() < minimum_value)
+        return;
+
+    switch (option)
+    {
+        case algorithm::largest_first:
+            largest_first(out, unspent, minimum_value);
+            break;
+        case algorithm::branch_and_bound:
+            branch_and_bound(out, unspent, minimum_value, cost_of_change);
+            break;
+        case algorithm::knapsack:
+            knapsack(out, unspent, minimum_value);
+            break;
+        case algorithm::greedy:
+        default:
+            greedy(out, unspent, minimum_value);
+            break;
+    }
+}
+
+// private
+void select_outputs::greedy(points_info& out, const unspent_index& unspent,
+    uint64_t minimum_value)
+{
+    const auto& values = unspent.by_value();
+    const auto minimum_greater = values.lower_bound(minimum_value);
+
+    if (minimum_greater != values.end())
+    {
+        out.change = minimum_greater->first - minimum_value;
+        out.points.push_back(minimum_greater->second);
+        return;
+    }
+
+    // Not found in greaters, so all are lessers, and the total suffices.
+    largest_first(out, unspent, minimum_value);
+}
+
+// private
+void select_outputs::largest_first(points_info& out,
+    const unspent_index& unspent, uint64_t minimum_value)
+{
+    uint64_t value = 0;
+    const auto& values = unspent.by_value();
+
+    for (auto it = values.rbegin(); it != values.rend(); ++it)
+    {
+        value = ceiling_add(value, it->first);
+        out.points.push_back(it->second);
+
+        if (value >= minimum_value)
+        {
+            out.change = value - minimum_value;
+            return;
+        }
+    }
+
+    out.change = 0;
+    out.points.clear();
+}
+
+// private
+// Search subsets of outputs not exceeding the limit, in descending order of
+// value, including each output before excluding it. A branch is abandoned
+// once it exceeds the limit or cannot reach the minimum with what remains.
+void select_outputs::branch_and_bound(points_info& out,
+    const unspent_index& unspent, uint64_t minimum_value,
+    uint64_t cost_of_change)
+{
+    const auto& values = unspent.by_value();
+    const auto limit = ceiling_add(minimum_value, cost_of_change);
+    const auto upper = values.upper_bound(limit);
+
+    // The total of the candidates, excluding the (few) outputs over limit.
+    auto available = unspent.total();
+    for (auto it = upper; it != values.end(); ++it)
+        available -= it->first;
+
+    const reverse_iterator first(upper);
+    const reverse_iterator last(values.rend());
+
+    uint64_t value = 0;
+    uint64_t best_value = max_uint64;
+    std::vector<reverse_iterator> chosen;
+    std::vector<reverse_iterator> best;
+    auto it = first;
+
+    for (size_t tries = 0; tries < branch_and_bound_tries; ++tries)
+    {
+        auto backtrack = value > limit ||
+            ceiling_add(value, available) < minimum_value;
+
+        if (!backtrack && value >= minimum_value)
+        {
+            if (value < best_value)
+            {
+                best_value = value;
+                best = chosen;
+            }
+
+            if (value == minimum_value)
+                break;
+
+            backtrack = true;
+        }
+
+        if (backtrack)
+        {
+            if (chosen.empty())
+                break;
+
+            // Exclude the last included output, restoring those after it.
+            const auto included = chosen.back();
+            chosen.pop_back();
+
+            for (const auto next = std::next(included); it != next;)
+                available += (--it)->first;
+
+            value -= included->first;
+            continue;
+        }
+
+        BITCOIN_ASSERT(it != last);
+        available -= it->first;
+
+        // Including an output of equal value to a preceding excluded output
+        // repeats the search in which that output was included.
+        const auto repeat = it != first &&
+            std::prev(it)->first == it->first &&
+            (chosen.empty() || chosen.back() != std::prev(it));
+
+        if (!repeat)
+        {
+            value += it->first;
+            chosen.push_back(it);
+        }
+
+        ++it;
+    }
+
+    if (best_value != max_uint64)
+        to_points_info(out, best, best_value, minimum_value);
+}
+
+// private
+// Randomly include outputs from the largest lessers, completing each subset
+// with a deterministic pass, and retain the subset of least excess.
+void select_outputs::knapsack(points_info& out, const unspent_index& unspent,
+    uint64_t minimum_value)
+{
+    const auto& values = unspent.by_value();
+    const auto minimum_greater = values.lower_bound(minimum_value);
+
+    // An exact match cannot be improved upon.
+    if (minimum_greater != values.end() &&
+        minimum_greater->first == minimum_value)
+    {
+        out.points.push_back(minimum_greater->second);
+        return;
+    }
+
+    // Gather the largest lessers, sufficient to cover the value twice over.
+    uint64_t window_value = 0;
+    const auto twice = ceiling_add(minimum_value, minimum_value);
+    std::vector<iterator> window;
+
+    for (auto it = minimum_greater; it != values.begin() &&
+        window.size() < knapsack_window && window_value < twice;)
+    {
+        window.push_back(--it);
+        window_value = ceiling_add(window_value, it->first);
+    }
+
+    if (window_value < minimum_value)
+    {
+        if (minimum_greater != values.end())
+            greedy(out, unspent, minimum_value);
+        else
+            largest_first(out, unspent, minimum_value);
+
+        return;
+    }
+
+    const auto count = window.size();
+    std::vector<bool> included(count);
+    std::vector<bool> best(count, true);
+    auto best_value = window_value;
+    uint64_t bits = 0;
+
+    for (size_t iteration = 0; iteration < knapsack_iterations &&
+        best_value != minimum_value; ++iteration)
+    {
+        uint64_t value = 0;
+        auto reached = false;
+        std::fill(included.begin(), included.end(), false);
+
+        for (size_t pass = 0; pass < 2 && !reached; ++pass)
+        {
+            for (size_t index = 0; index < count; ++index)
+            {
+                if (pass == 0)
+                {
+                    if (index % 64 == 0)
+                        bits = pseudo_random();
+
+                    if (((bits >> (index % 64)) & 1) == 0)
+                        continue;
+                }
+                else if (included[index])
+                    continue;
+
+                value += window[index]->first;
+                included[index] = true;
+
+                if (value >= minimum_value)
+                {
+                    reached = true;
+                    if (value < best_value)
+                    {
+                        best_value = value;
+                        best = included;
+                    }
+
+                    value -= window[index]->first;
+                    included[index] = false;
+                }
+            }
+        }
+    }
+
+    // Prefer a single greater output unless the subset has less excess.
+    if (minimum_greater != values.end() &&
+        minimum_greater->first <= best_value)
+    {
+        out.change = minimum_greater->first - minimum_value;
+        out.points.push_back(minimum_greater->second);
+        return;
+    }
+
+    std::vector<iterator> selected;
+    for (size_t index = 0; index < count; ++index)
+        if (best[index])
+            selected.push_back(window[index]);
+
+    to_points_info(out, selected, best_value, minimum_value);
+}
+
 } // namespace wallet
 } // namespace libbitcoin
@@ -0,0 +1,266 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/wallet/stealth_scanner.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/chain/script/script.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/stealth.hpp>
+#include <bitcoin/bitcoin/utility/binary.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+#include <bitcoin/bitcoin/wallet/stealth_address.hpp>
+
+namespace libbitcoin {
+namespace wallet {
+
+using namespace bc::chain;
+
+// The stealth prefix is the leading 32 bits of the stealth script hash.
+static constexpr size_t prefix_bits = 32;
+
+// A pay-key-hash output of a transaction with a stealth output.
+struct payment
+{
+    short_hash hash;
+    uint32_t index;
+};
+
+typedef std::vector<payment> payments;
+
+static payments to_payments(const transaction& tx)
+{
+    payments out;
+    const auto& outputs = tx.outputs();
+
+    for (uint32_t index = 0; index < outputs.size(); ++index)
+    {
+        const auto& script = outputs[index].script();
+        if (script.pattern() != script_pattern::pay_key_hash)
+            continue;
+
+        const auto& data = script.operations()[2].data();
+        out.push_back({ to_array<short_hash_size>(data), index });
+    }
+
+    return out;
+}
+
+stealth_scanner::stealth_scanner()
+  : nodes_(1, node{ { 0, 0 }, {} })
+{
+}
+
+bool stealth_scanner::watch(const stealth_address& address,
+    const ec_secret& scan_secret)
+{
+    ec_compressed scan_key;
+    const auto& filter = address.filter();
+    const auto& spend_keys = address.spend_keys();
+
+    if (!address || spend_keys.empty() || filter.size() > prefix_bits ||
+        !secret_to_public(scan_key, scan_secret) ||
+        scan_key != address.scan_key())
+        return false;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
+
+    uint32_t index = 0;
+    for (size_t bit = 0; bit < filter.size(); ++bit)
+    {
+        const auto child = filter[bit] ? 1 : 0;
+        if (nodes_[index].children[child] == 0)
+        {
+            nodes_[index].children[child] = static_cast<uint32_t>(
+                nodes_.size());
+            nodes_.push_back(node{ { 0, 0 }, {} });
+        }
+
+        index = nodes_[index].children[child];
+    }
+
+    nodes_[index].entries.push_back(static_cast<uint32_t>(entries_.size()));
+    entries_.push_back({ scan_secret, spend_keys.front() });
+    return true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+size_t stealth_scanner::size() const
+{
+    shared_lock lock(mutex_);
+    return entries_.size();
+}
+
+// private
+// Collect the entries of each node on the path of the prefix bits.
+void stealth_scanner::find(std::vector<uint32_t>& out_entries,
+    uint32_t prefix) const
+{
+    // Filter bits are read from the little endian prefix, high bit first.
+    const auto blocks = to_little_endian(prefix);
+    uint32_t index = 0;
+
+    for (size_t bit = 0; ; ++bit)
+    {
+        const auto& current = nodes_[index];
+        out_entries.insert(out_entries.end(), current.entries.begin(),
+            current.entries.end());
+
+        if (bit == prefix_bits)
+            return;
+
+        const auto shift = binary::bits_per_block - (bit % 8) - 1;
+        const auto child = (blocks[bit / 8] >> shift) & 0x01;
+        index = current.children[child];
+
+        if (index == 0)
+            return;
+    }
+}
+
+void stealth_scanner::scan(const transaction::list& transactions,
+    match_handler handler) const
+{
+    const auto range = [](size_t count, const range_handler& part)
+    {
+        part(0, count);
+    };
+
+    scan(transactions, range, handler);
+}
+
+void stealth_scanner::scan(const transaction::list& transactions,
+    threadpool& pool, match_handler handler) const
+{
+    const auto range = [&pool](size_t count, const range_handler& part)
+    {
+        parallel_for(pool, count, part);
+    };
+
+    scan(transactions, range, handler);
+}
+
+// private
+// The handler is invoked outside of the critical section so it may watch.
+void stealth_scanner::scan(const transaction::list& transactions,
+    const partitioner& range, match_handler handler) const
+{
+    matches found;
+    collect(found, transactions, range);
+
+    for (const auto& match: found)
+        handler(match);
+}
+
+// private
+void stealth_scanner::collect(matches& out,
+    const transaction::list& transactions, const partitioner& range) const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
+
+    // Prefilter stealth outputs, which requires only a hash per output.
+    candidates work;
+    std::vector<uint32_t> found;
+
+    for (size_t tx = 0; tx < transactions.size(); ++tx)
+    {
+        for (const auto& output: transactions[tx].outputs())
+        {
+            uint32_t prefix;
+            ec_compressed ephemeral;
+            const auto& script = output.script();
+
+            if (!to_stealth_prefix(prefix, script) ||
+                !extract_ephemeral_key(ephemeral, script))
+                continue;
+
+            found.clear();
+            find(found, prefix);
+
+            for (const auto entry: found)
+                work.push_back({ tx, entry, ephemeral });
+        }
+    }
+
+    if (work.empty())
+        return;
+
+    // Payment outputs are extracted once per transaction with a candidate.
+    std::vector<payments> outputs(transactions.size());
+    for (size_t index = 0; index < work.size(); ++index)
+    {
+        const auto tx = work[index].transaction;
+        if (index == 0 || work[index - 1].transaction != tx)
+            outputs[tx] = to_payments(transactions[tx]);
+    }
+
+    // Compute shared secrets over parts of the work, in parallel if pooled.
+    std::vector<ec_compressed> keys(work.size());
+    std::vector<payments> paid(work.size());
+
+    range(work.size(), [&](size_t begin, size_t end)
+    {
+        for (auto index = begin; index < end; ++index)
+        {
+            const auto& item = work[index];
+            const auto& watched = entries_[item.entry];
+
+            auto& key = keys[index];
+            if (!uncover_stealth(key, item.ephemeral_public_key,
+                watched.scan_secret, watched.spend_key))
+                continue;
+
+            const auto hash = bitcoin_short_hash(key);
+            for (const auto& payment: outputs[item.transaction])
+                if (payment.hash == hash)
+                    paid[index].push_back(payment);
+        }
+    });
+
+    // Collect the matches in transaction order.
+    for (size_t index = 0; index < work.size(); ++index)
+    {
+        const auto& item = work[index];
+        for (const auto& payment: paid[index])
+            out.push_back(
+            {
+                item.entry,
+                keys[index],
+                item.ephemeral_public_key,
+                transactions[item.transaction].hash(),
+                payment.index
+            });
+    }
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+} // namespace wallet
+} // namespace libbitcoin
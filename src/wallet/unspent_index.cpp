@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/wallet/unspent_index.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <bitcoin/bitcoin/chain/output_point.hpp>
+#include <bitcoin/bitcoin/chain/point.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/limits.hpp>
+
+namespace libbitcoin {
+namespace wallet {
+
+using namespace bc::chain;
+
+unspent_index::unspent_index()
+  : total_(0)
+{
+}
+
+unspent_index::unspent_index(const output_info::list& unspent)
+  : total_(0)
+{
+    for (const auto& output: unspent)
+        add(output);
+}
+
+unspent_index::unspent_index(unspent_index&& other)
+  : values_(std::move(other.values_)),
+    points_(std::move(other.points_)),
+    total_(other.total_)
+{
+    other.clear();
+}
+
+unspent_index& unspent_index::operator=(unspent_index&& other)
+{
+    if (this == &other)
+        return *this;
+
+    values_ = std::move(other.values_);
+    points_ = std::move(other.points_);
+    total_ = other.total_;
+    other.clear();
+    return *this;
+}
+
+bool unspent_index::add(const output_info& unspent)
+{
+    if (points_.find(unspent.point) != points_.end())
+        return false;
+
+    const auto it = values_.emplace(unspent.value, unspent.point);
+    points_.emplace(unspent.point, it);
+    total_ = ceiling_add(total_, unspent.value);
+    return true;
+}
+
+bool unspent_index::remove(const point& spent)
+{
+    const auto it = points_.find(spent);
+    if (it == points_.end())
+        return false;
+
+    const auto value = it->second->first;
+    values_.erase(it->second);
+    points_.erase(it);
+
+    // A saturated total is recomputed, as the true sum is unknown.
+    if (total_ != max_uint64)
+    {
+        total_ -= value;
+        return true;
+    }
+
+    total_ = 0;
+    for (const auto& output: values_)
+        total_ = ceiling_add(total_, output.first);
+
+    return true;
+}
+
+void unspent_index::clear()
+{
+    values_.clear();
+    points_.clear();
+    total_ = 0;
+}
+
+bool unspent_index::empty() const
+{
+    return values_.empty();
+}
+
+size_t unspent_index::size() const
+{
+    return values_.size();
+}
+
+uint64_t unspent_index::total() const
+{
+    return total_;
+}
+
+const unspent_index::values& unspent_index::by_value() const
+{
+    return values_;
+}
+
+} // namespace wallet
+} // namespace libbitcoin
@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+
+BOOST_AUTO_TEST_SUITE(chain_state_tests)
+
+// A chain with version upgrades, irregular spacing and minimum difficulty.
+static header::list make_chain(size_t count, size_t upgrade)
+{
+    header::list headers;
+    uint32_t timestamp = 1231006505;
+
+    for (size_t height = 0; height < count; ++height)
+    {
+        const auto stage = std::min<size_t>(height / upgrade + 1,
+            bip65_version);
+        const auto version = static_cast<uint32_t>(stage);
+        const auto bits = static_cast<uint32_t>(height % 7 == 0 ?
+            max_work_bits : 0x1c0fffff);
+        timestamp += static_cast<uint32_t>((height * 7919) % 1500);
+        headers.emplace_back(version, null_hash, null_hash, timestamp, bits,
+            0);
+    }
+
+    return headers;
+}
+
+// Populate state data for the height only by query of the map, as a store.
+static chain_state::data make_data(const header::list& headers,
+    size_t height, bool enabled, bool testnet)
+{
+    const auto map = chain_state::get_map(height, enabled, testnet);
+
+    chain_state::data data;
+    data.testnet = testnet;
+    data.enabled = enabled;
+    data.height = height;
+    data.hash = headers[height].hash();
+    data.bits.self = headers[map.bits_self].bits();
+    data.version.self = headers[map.version_self].version();
+    data.timestamp.self = headers[map.timestamp_self].timestamp();
+    data.timestamp.retarget = headers[map.timestamp_retarget].timestamp();
+
+    for (auto index = map.bits.low; index <= map.bits.high; ++index)
+        data.bits.ordered.push_back(headers[index].bits());
+
+    for (auto index = map.version.low; index <= map.version.high; ++index)
+        data.version.unordered.push_back(headers[index].version());
+
+    for (auto index = map.timestamp.low; index <= map.timestamp.high; ++index)
+        data.timestamp.ordered.push_back(headers[index].timestamp());
+
+    return data;
+}
+
+static void promote_and_compare(const header::list& headers, size_t from,
+    bool enabled, bool testnet)
+{
+    const chain_state::checkpoints checkpoints;
+    auto state = std::make_shared<chain_state>(
+        make_data(headers, from, enabled, testnet), checkpoints);
+
+    for (auto height = from + 1; height < headers.size(); ++height)
+    {
+        state = std::make_shared<chain_state>(*state, headers[height]);
+        const chain_state queried(make_data(headers, height, enabled,
+            testnet), checkpoints);
+
+        BOOST_REQUIRE(state->is_valid());
+        BOOST_REQUIRE_EQUAL(state->height(), height);
+        BOOST_REQUIRE_EQUAL(state->enabled_forks(), queried.enabled_forks());
+        BOOST_REQUIRE_EQUAL(state->minimum_version(),
+            queried.minimum_version());
+        BOOST_REQUIRE_EQUAL(state->median_time_past(),
+            queried.median_time_past());
+        BOOST_REQUIRE_EQUAL(state->work_required(), queried.work_required());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__promote__testnet__same_as_queried)
+{
+    const auto headers = make_chain(retargeting_interval + 100, 60);
+    promote_and_compare(headers, 1, true, true);
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__promote__mainnet__same_as_queried)
+{
+    const auto headers = make_chain(retargeting_interval + 100, 500);
+    promote_and_compare(headers, 1, true, false);
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__promote__not_enabled__same_as_queried)
+{
+    const auto headers = make_chain(300, 60);
+    promote_and_compare(headers, 1, false, true);
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__promote__from_full_sample__same_as_queried)
+{
+    const auto headers = make_chain(400, 60);
+    promote_and_compare(headers, 200, true, true);
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__promote__from_reduced_sample__invalid)
+{
+    const auto headers = make_chain(100, 60);
+    const chain_state::checkpoints checkpoints;
+    const chain_state reduced(make_data(headers, testnet_active, true, true),
+        checkpoints);
+    BOOST_REQUIRE(reduced.is_valid());
+
+    const chain_state child(reduced, headers[testnet_active + 1]);
+    BOOST_REQUIRE(!child.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__promote__reduced_to_reduced__valid)
+{
+    const auto headers = make_chain(100, 60);
+    const chain_state::checkpoints checkpoints;
+    const chain_state reduced(make_data(headers, 10, true, true),
+        checkpoints);
+
+    const chain_state child(reduced, headers[11]);
+    BOOST_REQUIRE(child.is_valid());
+    BOOST_REQUIRE_EQUAL(child.height(), 11u);
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__get_map__self__height)
+{
+    const auto map = chain_state::get_map(42, true, false);
+    BOOST_REQUIRE_EQUAL(map.bits_self, 42u);
+    BOOST_REQUIRE_EQUAL(map.version_self, 42u);
+    BOOST_REQUIRE_EQUAL(map.timestamp_self, 42u);
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__data__aggregate_value_initialized__zeroed)
+{
+    const chain_state::data data{};
+    BOOST_REQUIRE(!data.testnet);
+    BOOST_REQUIRE(!data.enabled);
+    BOOST_REQUIRE_EQUAL(data.height, 0u);
+    BOOST_REQUIRE(data.hash == null_hash);
+    BOOST_REQUIRE_EQUAL(data.bits.self, 0u);
+    BOOST_REQUIRE_EQUAL(data.version.self, 0u);
+    BOOST_REQUIRE_EQUAL(data.timestamp.self, 0u);
+    BOOST_REQUIRE_EQUAL(data.timestamp.retarget, 0u);
+}
+
+// State populated only from get_map and the store promotes as queried.
+BOOST_AUTO_TEST_CASE(chain_state__promote__populated_from_map__same_as_queried)
+{
+    const auto headers = make_chain(retargeting_interval + 20, 60);
+    promote_and_compare(headers, retargeting_interval - 10, true, true);
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__promote__oversized_sample__invalid)
+{
+    const auto headers = make_chain(400, 60);
+    const chain_state::checkpoints checkpoints;
+    auto data = make_data(headers, 200, true, true);
+    data.version.unordered.push_back(data.version.unordered.back());
+    const chain_state parent(std::move(data), checkpoints);
+
+    const chain_state child(parent, headers[201]);
+    BOOST_REQUIRE(!child.is_valid());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -419,6 +419,105 @@ BOOST_AUTO_TEST_CASE(header__is_valid_proof_of_work__hash_less_than_bits__return
     BOOST_REQUIRE_EQUAL(true, instance.is_valid_proof_of_work());
 }
 
+BOOST_AUTO_TEST_CASE(header__is_valid_proof_of_work__genesis_maximum_bits__returns_true)
+{
+    const chain::header instance(
+        1u,
+        null_hash,
+        hash_literal("4a5e1e4baab89f3a32518a88c31bc87f618f76673e2cc77ab2127b7afdeda33b"),
+        1231006505u,
+        max_work_bits,
+        2083236893u);
+
+    BOOST_REQUIRE_EQUAL(true, instance.is_valid_proof_of_work());
+}
+
+BOOST_AUTO_TEST_CASE(header__is_valid_proof_of_work__negative_bits__returns_false)
+{
+    chain::header instance;
+    instance.set_bits(0x1c800001);
+    BOOST_REQUIRE_EQUAL(false, instance.is_valid_proof_of_work());
+}
+
+BOOST_AUTO_TEST_CASE(header__is_valid_proof_of_work__bits_and_hash__matches_member)
+{
+    const auto genesis = chain::block::genesis_mainnet().header();
+    BOOST_REQUIRE(chain::header::is_valid_proof_of_work(genesis.bits(),
+        genesis.hash()));
+    BOOST_REQUIRE(!chain::header::is_valid_proof_of_work(genesis.bits(),
+        hash_literal("00000001ffffffffffffffffffffffffffffffffffffffffffffffffffffffff")));
+}
+
+BOOST_AUTO_TEST_CASE(header__is_valid_proof_of_work__bits_range__matches_hash_number)
+{
+    hash_number maximum;
+    BOOST_REQUIRE(maximum.set_compact(max_work_bits));
+
+    chain::header instance(
+        4u,
+        hash_literal("000000000000000003ddc1e929e2944b8b0039af9aa0d826c480a83d8b39c373"),
+        hash_literal("a6cb0b0d6531a71abe2daaa4a991e5498e1b6b0b51549568d0f9d55329b905df"),
+        1474388414u,
+        0u,
+        2842832236u);
+
+    const hash_number value(instance.hash());
+
+    for (uint32_t size = 0; size <= 36; ++size)
+    {
+        for (const uint32_t mantissa: { 0x000000u, 0x000001u, 0x0000ffu,
+            0x00ffffu, 0x7fffffu, 0x800000u, 0x12345u, 0x3d8b39u })
+        {
+            const auto bits = (size << 24) | mantissa;
+            instance.set_bits(bits);
+
+            hash_number target;
+            const auto expected = target.set_compact(bits) &&
+                !(target > maximum) && value <= target;
+
+            BOOST_REQUIRE_EQUAL(instance.is_valid_proof_of_work(), expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(header__is_valid_proof_of_work_list__all_valid__returns_true)
+{
+    const chain::header valid(
+        4u,
+        hash_literal("000000000000000003ddc1e929e2944b8b0039af9aa0d826c480a83d8b39c373"),
+        hash_literal("a6cb0b0d6531a71abe2daaa4a991e5498e1b6b0b51549568d0f9d55329b905df"),
+        1474388414u,
+        402972254u,
+        2842832236u);
+
+    const chain::header genesis(
+        1u,
+        null_hash,
+        hash_literal("4a5e1e4baab89f3a32518a88c31bc87f618f76673e2cc77ab2127b7afdeda33b"),
+        1231006505u,
+        max_work_bits,
+        2083236893u);
+
+    BOOST_REQUIRE(chain::header::is_valid_proof_of_work({}));
+    BOOST_REQUIRE(chain::header::is_valid_proof_of_work({ genesis, valid, valid }));
+}
+
+BOOST_AUTO_TEST_CASE(header__is_valid_proof_of_work_list__one_invalid__returns_false)
+{
+    const chain::header valid(
+        4u,
+        hash_literal("000000000000000003ddc1e929e2944b8b0039af9aa0d826c480a83d8b39c373"),
+        hash_literal("a6cb0b0d6531a71abe2daaa4a991e5498e1b6b0b51549568d0f9d55329b905df"),
+        1474388414u,
+        402972254u,
+        2842832236u);
+
+    auto invalid = valid;
+    invalid.set_nonce(0);
+
+    BOOST_REQUIRE(!chain::header::is_valid_proof_of_work({ valid, invalid, valid }));
+}
+
 BOOST_AUTO_TEST_CASE(header__operator_assign_equals__always__matches_equivalent)
 {
     // This must be non-const.
@@ -215,6 +215,27 @@ BOOST_AUTO_TEST_CASE(operation__data_setter_2__roundtrip__success)
 
 //BOOST_AUTO_TEST_CASE(operation__is_pay_multisig_pattern__checkmultisig)
 
+BOOST_AUTO_TEST_CASE(operation__to_pay_multisig_pattern__two_of_three__expected_operations)
+{
+    ec_compressed point;
+    data_stack points;
+
+    for (uint8_t index = 1; index <= 3; ++index)
+    {
+        ec_secret secret{ { index } };
+        BOOST_REQUIRE(secret_to_public(point, secret));
+        points.push_back(to_chunk(point));
+    }
+
+    const auto ops = chain::operation::to_pay_multisig_pattern(2, points);
+    BOOST_REQUIRE_EQUAL(ops.size(), 6u);
+    BOOST_REQUIRE(ops.front().code() == chain::opcode::op_2);
+    BOOST_REQUIRE(ops[1].data() == points[0]);
+    BOOST_REQUIRE(ops[3].data() == points[2]);
+    BOOST_REQUIRE(ops[4].code() == chain::opcode::op_3);
+    BOOST_REQUIRE(ops.back().code() == chain::opcode::checkmultisig);
+}
+
 BOOST_AUTO_TEST_CASE(operation__operator_assign_equals_1__always__matches_equivalent)
 {
     chain::operation expected;
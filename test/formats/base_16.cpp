@@ -81,4 +81,101 @@ BOOST_AUTO_TEST_CASE(base16_array_test)
     BOOST_REQUIRE(converted == expected);
 }
 
+BOOST_AUTO_TEST_CASE(base16__encode__all_bytes__expected)
+{
+    data_chunk data(256);
+    for (size_t byte = 0; byte < data.size(); ++byte)
+        data[byte] = static_cast<uint8_t>(byte);
+
+    const auto encoded = encode_base16(data);
+    BOOST_REQUIRE_EQUAL(encoded.size(), 512u);
+    BOOST_REQUIRE_EQUAL(encoded.substr(0, 8), "00010203");
+    BOOST_REQUIRE_EQUAL(encoded.substr(508), "feff");
+
+    data_chunk decoded;
+    BOOST_REQUIRE(decode_base16(decoded, encoded));
+    BOOST_REQUIRE(decoded == data);
+}
+
+BOOST_AUTO_TEST_CASE(base16__decode__mixed_case__expected)
+{
+    data_chunk decoded;
+    BOOST_REQUIRE(decode_base16(decoded, "aBcDeF09"));
+    BOOST_REQUIRE_EQUAL(encode_base16(decoded), "abcdef09");
+}
+
+BOOST_AUTO_TEST_CASE(base16__decode__invalid_character__false_unchanged)
+{
+    data_chunk decoded{ 0x42 };
+    BOOST_REQUIRE(!decode_base16(decoded, "0g"));
+    BOOST_REQUIRE(!decode_base16(decoded, "\xff" "0"));
+    BOOST_REQUIRE(!decode_base16(decoded, "0 "));
+    BOOST_REQUIRE(decoded == data_chunk{ 0x42 });
+}
+
+BOOST_AUTO_TEST_CASE(base16__buffer__round_trip__expected)
+{
+    const auto data = base16_literal("01ff42bc");
+    char encoded[2 * 4];
+    encode_base16(encoded, data);
+    BOOST_REQUIRE_EQUAL(std::string(encoded, sizeof(encoded)), "01ff42bc");
+
+    byte_array<4> decoded;
+    BOOST_REQUIRE(decode_base16(decoded.data(), decoded.size(), encoded));
+    BOOST_REQUIRE(decoded == data);
+}
+
+BOOST_AUTO_TEST_CASE(base16__encode_hash__reversed__round_trips)
+{
+    const char text[] = "000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f";
+    const auto hash = hash_literal(text);
+    BOOST_REQUIRE_EQUAL(hash.front(), 0x6f);
+    BOOST_REQUIRE_EQUAL(encode_hash(hash), text);
+
+    hash_digest decoded;
+    BOOST_REQUIRE(decode_hash(decoded, text));
+    BOOST_REQUIRE(decoded == hash);
+}
+
+// Lengths cover the vector blocks and the table driven tail.
+BOOST_AUTO_TEST_CASE(base16__encode__vector_lengths__expected)
+{
+    const std::string digits = "0123456789abcdef";
+
+    for (size_t size = 0; size < 100; ++size)
+    {
+        data_chunk data(size);
+        std::string expected;
+        for (size_t index = 0; index < size; ++index)
+        {
+            data[index] = static_cast<uint8_t>(index * 37 + size);
+            expected += digits[data[index] >> 4];
+            expected += digits[data[index] & 0x0f];
+        }
+
+        BOOST_REQUIRE_EQUAL(encode_base16(data), expected);
+
+        data_chunk decoded;
+        BOOST_REQUIRE(decode_base16(decoded, expected));
+        BOOST_REQUIRE(decoded == data);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(base16__decode__invalid_character_any_position__false)
+{
+    const std::string valid(2 * 99, 'a');
+    const std::string invalid("/:@G`g \xff", 8);
+
+    for (size_t position = 0; position < valid.size(); ++position)
+    {
+        for (const auto character: invalid)
+        {
+            auto text = valid;
+            text[position] = character;
+            data_chunk decoded;
+            BOOST_REQUIRE(!decode_base16(decoded, text));
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
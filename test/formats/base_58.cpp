@@ -101,4 +101,87 @@ BOOST_AUTO_TEST_CASE(base58_array_test)
     BOOST_REQUIRE(converted == expected);
 }
 
+BOOST_AUTO_TEST_CASE(base58__decode__invalid_character__false)
+{
+    data_chunk decoded{ 0x42 };
+    BOOST_REQUIRE(!decode_base58(decoded, "19TbMSWwHvnxAKy12iNm3Kdb0fzfaMFViT"));
+    BOOST_REQUIRE(!decode_base58(decoded, "2g\xff"));
+    BOOST_REQUIRE(decoded == data_chunk{ 0x42 });
+}
+
+BOOST_AUTO_TEST_CASE(base58__round_trip__sizes_and_zero_prefixes__expected)
+{
+    // Sizes span partial limbs and the heap fallback beyond the stack limbs.
+    for (size_t size = 0; size <= 300; size += (size < 40 ? 1 : 37))
+    {
+        for (size_t zeros = 0; zeros <= std::min(size, size_t(3)); ++zeros)
+        {
+            data_chunk data(size, 0xff);
+            for (size_t index = 0; index < size; ++index)
+                data[index] = static_cast<uint8_t>(index * 131 + size);
+
+            std::fill(data.begin(), data.begin() + zeros, 0x00);
+            if (zeros < size && data[zeros] == 0x00)
+                data[zeros] = 0x01;
+
+            const auto encoded = encode_base58(data);
+            BOOST_REQUIRE_EQUAL(encoded.find_first_not_of('1'),
+                zeros == size ? std::string::npos : zeros);
+
+            data_chunk decoded;
+            BOOST_REQUIRE(decode_base58(decoded, encoded));
+            BOOST_REQUIRE(decoded == data);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(base58_array__wrong_size__false)
+{
+    byte_array<24> short_array;
+    byte_array<26> long_array;
+    BOOST_REQUIRE(!decode_base58(short_array, "19TbMSWwHvnxAKy12iNm3KdbGfzfaMFViT"));
+    BOOST_REQUIRE(!decode_base58(long_array, "19TbMSWwHvnxAKy12iNm3KdbGfzfaMFViT"));
+}
+
+BOOST_AUTO_TEST_CASE(base58_checked__payment_address__round_trips)
+{
+    const auto payload = base16_literal("005cc87f4a3fdfe3a2346b6953267ca867282630d3");
+    BOOST_REQUIRE_EQUAL(encode_base58_checked(payload), "19TbMSWwHvnxAKy12iNm3KdbGfzfaMFViT");
+
+    byte_array<25> decoded;
+    BOOST_REQUIRE(decode_base58_checked(decoded, "19TbMSWwHvnxAKy12iNm3KdbGfzfaMFViT"));
+    BOOST_REQUIRE(std::equal(payload.begin(), payload.end(), decoded.begin()));
+}
+
+BOOST_AUTO_TEST_CASE(base58_checked__bad_checksum__false)
+{
+    // The last character of the address has been changed.
+    byte_array<25> decoded;
+    BOOST_REQUIRE(!decode_base58_checked(decoded, "19TbMSWwHvnxAKy12iNm3KdbGfzfaMFViU"));
+}
+
+// github.com/bitcoin/bips/blob/master/bip-0032.mediawiki#test-vector-1
+BOOST_AUTO_TEST_CASE(base58_checked__extended_key__round_trips)
+{
+    const std::string encoded = "xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8";
+
+    byte_array<82> decoded;
+    BOOST_REQUIRE(decode_base58_checked(decoded, encoded));
+    BOOST_REQUIRE_EQUAL(encode_base58(decoded), encoded);
+
+    const data_slice payload(decoded.begin(), decoded.end() - checksum_size);
+    BOOST_REQUIRE_EQUAL(encode_base58_checked(payload), encoded);
+}
+
+BOOST_AUTO_TEST_CASE(base58_checked__long_payload__round_trips)
+{
+    const data_chunk payload(200, 0x2a);
+    const auto encoded = encode_base58_checked(payload);
+
+    data_chunk decoded;
+    BOOST_REQUIRE(decode_base58(decoded, encoded));
+    BOOST_REQUIRE(verify_checksum(decoded));
+    BOOST_REQUIRE(std::equal(payload.begin(), payload.end(), decoded.begin()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -85,4 +85,107 @@ BOOST_AUTO_TEST_CASE(decode_base64_invalid_test)
     BOOST_REQUIRE(!decode_base64(result, "!@#$%^&*()"));
 }
 
+BOOST_AUTO_TEST_CASE(decode_base64_misplaced_pad_invalid_test)
+{
+    data_chunk result;
+    BOOST_REQUIRE(!decode_base64(result, "TQ=u"));
+    BOOST_REQUIRE(!decode_base64(result, "T=Q="));
+    BOOST_REQUIRE(!decode_base64(result, "TQ==TWFu"));
+}
+
+BOOST_AUTO_TEST_CASE(base64_round_trip_lengths_test)
+{
+    for (size_t size = 0; size < 64; ++size)
+    {
+        data_chunk data(size);
+        for (size_t index = 0; index < size; ++index)
+            data[index] = static_cast<uint8_t>(index * 37 + size);
+
+        const auto encoded = encode_base64(data);
+        BOOST_REQUIRE_EQUAL(encoded.size(), (size + 2) / 3 * 4);
+
+        data_chunk result;
+        BOOST_REQUIRE(decode_base64(result, encoded));
+        BOOST_REQUIRE(result == data);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(encode_base64_buffer_test)
+{
+    const data_chunk decoded(BASE64_DATA_BOOK);
+    char encoded[sizeof(BASE64_BOOK) - 1];
+    BOOST_REQUIRE_EQUAL(encode_base64(encoded, decoded), sizeof(encoded));
+    BOOST_REQUIRE_EQUAL(std::string(encoded, sizeof(encoded)), BASE64_BOOK);
+}
+
+// Lengths cover the vector blocks and the table driven tail.
+BOOST_AUTO_TEST_CASE(base64_vector_lengths_test)
+{
+    const std::string table =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    for (size_t size = 0; size < 100; ++size)
+    {
+        data_chunk data(size);
+        for (size_t index = 0; index < size; ++index)
+            data[index] = static_cast<uint8_t>(index * 37 + size);
+
+        // Encode one bit at a time.
+        std::string expected;
+        for (size_t bit = 0; bit < 8 * size; bit += 6)
+        {
+            size_t value = 0;
+            for (size_t offset = bit; offset < bit + 6; ++offset)
+            {
+                const auto set = offset < 8 * size &&
+                    ((data[offset / 8] >> (7 - offset % 8)) & 1) != 0;
+                value = (value << 1) | (set ? 1 : 0);
+            }
+
+            expected += table[value];
+        }
+
+        expected.append((4 - expected.size() % 4) % 4, '=');
+        BOOST_REQUIRE_EQUAL(encode_base64(data), expected);
+
+        data_chunk result;
+        BOOST_REQUIRE(decode_base64(result, expected));
+        BOOST_REQUIRE(result == data);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(decode_base64_invalid_character_any_position_test)
+{
+    const std::string valid(4 * 25, 'A');
+
+    for (size_t position = 0; position < valid.size(); ++position)
+    {
+        for (size_t character = 0; character < 256; ++character)
+        {
+            if ((character >= 'A' && character <= 'Z') ||
+                (character >= 'a' && character <= 'z') ||
+                (character >= '0' && character <= '9') ||
+                character == '+' || character == '/' ||
+                (character == '=' && position == valid.size() - 1))
+                continue;
+
+            auto text = valid;
+            text[position] = static_cast<char>(character);
+            data_chunk result;
+            BOOST_REQUIRE(!decode_base64(result, text));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(decode_base64_buffer_test)
+{
+    const std::string encoded(BASE64_BOOK);
+    uint8_t decoded[3 * (sizeof(BASE64_BOOK) - 1) / 4];
+    size_t size;
+    BOOST_REQUIRE(decode_base64(decoded, size, encoded.data(),
+        encoded.size()));
+    BOOST_REQUIRE(data_chunk(decoded, decoded + size) ==
+        data_chunk(BASE64_DATA_BOOK));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <string>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::log;
+
+BOOST_AUTO_TEST_SUITE(levels_tests)
+
+BOOST_AUTO_TEST_CASE(levels__enabled__default__true)
+{
+    BOOST_REQUIRE(levels::enabled("levels_default", severity::debug));
+    BOOST_REQUIRE(levels::enabled("levels_default", severity::fatal));
+}
+
+BOOST_AUTO_TEST_CASE(levels__enabled__global_info__debug_disabled)
+{
+    levels::set(severity::info);
+    BOOST_REQUIRE(!levels::enabled("levels_global", severity::debug));
+    BOOST_REQUIRE(levels::enabled("levels_global", severity::info));
+    BOOST_REQUIRE(levels::enabled("levels_global", severity::error));
+    levels::set(severity::debug);
+    BOOST_REQUIRE(levels::enabled("levels_global", severity::debug));
+}
+
+BOOST_AUTO_TEST_CASE(levels__enabled__channel_override__only_channel_enabled)
+{
+    levels::set(severity::warning);
+    BOOST_REQUIRE(levels::set("levels_channel", severity::debug));
+    BOOST_REQUIRE(levels::enabled("levels_channel", severity::debug));
+    BOOST_REQUIRE(levels::enabled(std::string("levels_channel"),
+        severity::debug));
+    BOOST_REQUIRE(!levels::enabled("levels_other", severity::info));
+    BOOST_REQUIRE(levels::enabled("levels_other", severity::warning));
+    levels::set(severity::debug);
+}
+
+BOOST_AUTO_TEST_CASE(levels__enabled__channel_raised__channel_disabled)
+{
+    BOOST_REQUIRE(levels::set("levels_raised", severity::error));
+    BOOST_REQUIRE(!levels::enabled("levels_raised", severity::warning));
+    BOOST_REQUIRE(levels::enabled("levels_unraised", severity::warning));
+    BOOST_REQUIRE(levels::set("levels_raised", severity::debug));
+    BOOST_REQUIRE(levels::enabled("levels_raised", severity::debug));
+}
+
+BOOST_AUTO_TEST_CASE(levels__log__disabled__stream_not_evaluated)
+{
+    size_t calls = 0;
+    const auto call = [&calls]()
+    {
+        return ++calls;
+    };
+
+    levels::set(severity::warning);
+    LOG_INFO("levels_stream") << call();
+    levels::set(severity::debug);
+    BOOST_REQUIRE_EQUAL(calls, 0u);
+}
+
+// The table is never emptied, so this must remain the last case to set it.
+BOOST_AUTO_TEST_CASE(levels__set__table_full__false)
+{
+    auto filled = false;
+
+    for (size_t index = 0; index <= levels::capacity; ++index)
+    {
+        const auto channel = "levels_full_" + std::to_string(index);
+        if (!levels::set(channel, severity::debug))
+        {
+            filled = true;
+            break;
+        }
+    }
+
+    BOOST_REQUIRE(filled);
+    BOOST_REQUIRE(!levels::set("levels_full_extra", severity::debug));
+    BOOST_REQUIRE(levels::set("levels_full_0", severity::debug));
+    BOOST_REQUIRE(levels::enabled("levels_full_0", severity::debug));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,189 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::log;
+
+BOOST_AUTO_TEST_SUITE(ring_queue_tests)
+
+// Expose the queueing strategy interface used by the asynchronous sink.
+class accessor
+  : public ring_queue
+{
+public:
+    accessor(size_t capacity, overflow policy)
+      : ring_queue(capacity, policy)
+    {
+    }
+
+    using ring_queue::enqueue;
+    using ring_queue::try_enqueue;
+    using ring_queue::try_dequeue_ready;
+    using ring_queue::try_dequeue;
+    using ring_queue::dequeue_ready;
+    using ring_queue::interrupt_dequeue;
+};
+
+BOOST_AUTO_TEST_CASE(ring_queue__try_enqueue__full__false)
+{
+    accessor queue(4, overflow::drop);
+    const ring_queue::record_view record;
+
+    for (size_t index = 0; index < 4; ++index)
+        BOOST_REQUIRE(queue.try_enqueue(record));
+
+    BOOST_REQUIRE(!queue.try_enqueue(record));
+
+    ring_queue::record_view out;
+    BOOST_REQUIRE(queue.try_dequeue(out));
+    BOOST_REQUIRE(queue.try_enqueue(record));
+}
+
+BOOST_AUTO_TEST_CASE(ring_queue__enqueue__drop_full__counts_dropped)
+{
+    accessor queue(2, overflow::drop);
+    const ring_queue::record_view record;
+
+    for (size_t index = 0; index < 5; ++index)
+        queue.enqueue(record);
+
+    const auto counts = queue.overflow_counts();
+    BOOST_REQUIRE_EQUAL(counts.dropped, 3u);
+    BOOST_REQUIRE_EQUAL(counts.blocked, 0u);
+
+    ring_queue::record_view out;
+    BOOST_REQUIRE(queue.try_dequeue(out));
+    BOOST_REQUIRE(queue.try_dequeue(out));
+    BOOST_REQUIRE(!queue.try_dequeue(out));
+}
+
+BOOST_AUTO_TEST_CASE(ring_queue__enqueue__block_full__waits_for_space)
+{
+    static const size_t count = 10000;
+    accessor queue(2, overflow::block);
+    const ring_queue::record_view record;
+
+    std::thread producer([&]()
+    {
+        for (size_t index = 0; index < count; ++index)
+            queue.enqueue(record);
+    });
+
+    size_t consumed = 0;
+    ring_queue::record_view out;
+    while (consumed < count && queue.dequeue_ready(out))
+        ++consumed;
+
+    producer.join();
+    BOOST_REQUIRE_EQUAL(consumed, count);
+    BOOST_REQUIRE_EQUAL(queue.overflow_counts().dropped, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(ring_queue__dequeue_ready__interrupted__false)
+{
+    accessor queue(4, overflow::block);
+    std::thread interrupter([&]()
+    {
+        queue.interrupt_dequeue();
+    });
+
+    ring_queue::record_view out;
+    BOOST_REQUIRE(!queue.dequeue_ready(out));
+    interrupter.join();
+}
+
+BOOST_AUTO_TEST_CASE(ring_queue__enqueue__block_full_interrupted__not_dropped)
+{
+    accessor queue(2, overflow::block);
+    const ring_queue::record_view record;
+    queue.enqueue(record);
+    queue.enqueue(record);
+
+    std::thread producer([&]()
+    {
+        queue.enqueue(record);
+    });
+
+    // A flush interrupts the reader, which then drains the ring.
+    while (queue.overflow_counts().blocked == 0)
+        std::this_thread::yield();
+
+    queue.interrupt_dequeue();
+
+    size_t consumed = 0;
+    ring_queue::record_view out;
+    while (consumed < 3)
+        if (queue.try_dequeue(out))
+            ++consumed;
+
+    producer.join();
+    BOOST_REQUIRE_EQUAL(queue.overflow_counts().dropped, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(ring_queue__close__block_full__dropped)
+{
+    accessor queue(2, overflow::block);
+    const ring_queue::record_view record;
+    queue.enqueue(record);
+    queue.enqueue(record);
+
+    std::thread producer([&]()
+    {
+        queue.enqueue(record);
+    });
+
+    while (queue.overflow_counts().blocked == 0)
+        std::this_thread::yield();
+
+    queue.close();
+    producer.join();
+    BOOST_REQUIRE_EQUAL(queue.overflow_counts().dropped, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(ring_queue__try_dequeue_ready__drained__handler_once)
+{
+    accessor queue(4, overflow::block);
+    size_t drained = 0;
+    queue.set_drained_handler([&drained]()
+    {
+        ++drained;
+    });
+
+    const ring_queue::record_view record;
+    ring_queue::record_view out;
+    BOOST_REQUIRE(!queue.try_dequeue_ready(out));
+    BOOST_REQUIRE_EQUAL(drained, 0u);
+
+    queue.enqueue(record);
+    queue.enqueue(record);
+    BOOST_REQUIRE(queue.try_dequeue_ready(out));
+    BOOST_REQUIRE(queue.try_dequeue_ready(out));
+    BOOST_REQUIRE(!queue.try_dequeue_ready(out));
+    BOOST_REQUIRE(!queue.try_dequeue_ready(out));
+    BOOST_REQUIRE_EQUAL(drained, 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
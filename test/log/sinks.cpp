@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <boost/filesystem.hpp>
+#include <boost/make_shared.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::log;
+
+BOOST_AUTO_TEST_SUITE(sinks_tests)
+
+// A stream buffer that stalls its writer until released.
+class stalled_buffer
+  : public std::streambuf
+{
+public:
+    stalled_buffer()
+      : entered(false), released(false)
+    {
+    }
+
+    std::atomic<bool> entered;
+    std::atomic<bool> released;
+
+protected:
+    int_type overflow(int_type character) override
+    {
+        entered = true;
+
+        while (!released)
+            std::this_thread::yield();
+
+        return traits_type::not_eof(character);
+    }
+};
+
+static path make_path(const std::string& name)
+{
+    return temp_directory_path() / unique_path(name + "-%%%%%%");
+}
+
+BOOST_AUTO_TEST_CASE(sinks__stop__producer_blocked_on_full_ring__released)
+{
+    stalled_buffer buffer;
+    const auto debug_path = make_path("sinks-debug");
+    const auto error_path = make_path("sinks-error");
+    auto debug_file = boost::make_shared<bc::ofstream>(debug_path.string());
+    auto error_file = boost::make_shared<bc::ofstream>(error_path.string());
+    log::stream output_stream = boost::make_shared<std::ostream>(&buffer);
+    log::stream error_stream = boost::make_shared<std::ostream>(nullptr);
+    const asynchronous settings{ 2, overflow::block };
+    initialize(debug_file, error_file, output_stream, error_stream,
+        settings);
+
+    const auto before = overflow_counts();
+    std::atomic<size_t> logged(0);
+
+    // The stalled writer holds at most one record and the ring two more, so
+    // the producer blocks on the fourth record until the sink is stopped.
+    std::thread producer([&logged]()
+    {
+        for (size_t index = 0; index < 4; ++index, ++logged)
+            LOG_INFO("sinks_stop") << index;
+    });
+
+    while (!buffer.entered || logged != 3 ||
+        overflow_counts().blocked == before.blocked)
+        std::this_thread::yield();
+
+    std::thread stopper([]()
+    {
+        log::stop();
+    });
+
+    // The producer is released while the writer remains stalled.
+    producer.join();
+    buffer.released = true;
+    stopper.join();
+
+    debug_file.reset();
+    error_file.reset();
+    remove(debug_path);
+    remove(error_path);
+    BOOST_REQUIRE_EQUAL(logged, 4u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
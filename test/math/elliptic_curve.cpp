@@ -65,6 +65,40 @@ BOOST_AUTO_TEST_CASE(elliptic_curve__sign__positive__test)
     BOOST_REQUIRE_EQUAL(result, EC_SIGNATURE3);
 }
 
+BOOST_AUTO_TEST_CASE(elliptic_curve__sign__repeated_beyond_reblinding__deterministic)
+{
+    ec_signature signature;
+    const ec_secret secret = hash_literal(SECRET3);
+    const hash_digest sighash = hash_literal(SIGHASH3);
+
+    // Blinding is refreshed periodically but signatures are rfc6979.
+    for (size_t count = 0; count < 1100; ++count)
+    {
+        BOOST_REQUIRE(sign(signature, secret, sighash));
+        BOOST_REQUIRE_EQUAL(encode_base16(signature), EC_SIGNATURE3);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(elliptic_curve__sign__concurrent_threads__deterministic)
+{
+    const ec_secret secret = hash_literal(SECRET3);
+    const hash_digest sighash = hash_literal(SIGHASH3);
+    std::vector<ec_signature> signatures(4);
+    std::vector<std::thread> threads;
+
+    for (auto& signature: signatures)
+        threads.emplace_back([&]()
+        {
+            sign(signature, secret, sighash);
+        });
+
+    for (auto& thread: threads)
+        thread.join();
+
+    for (const auto& signature: signatures)
+        BOOST_REQUIRE_EQUAL(encode_base16(signature), EC_SIGNATURE3);
+}
+
 BOOST_AUTO_TEST_CASE(elliptic_curve__encode_signature__positive__test)
 {
     der_signature out;
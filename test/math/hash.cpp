@@ -91,4 +91,110 @@ BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512_test)
     }
 }
 
+BOOST_AUTO_TEST_CASE(hmac_sha512_context__hash__repeated__matches_hmac_sha512_hash)
+{
+    const data_chunk key{ 'k', 'e', 'y' };
+    const data_chunk long_key(200, 0x42);
+    const hmac_sha512_context context(key);
+    const hmac_sha512_context long_context(long_key);
+
+    for (const auto& chunk: { data_chunk{}, data_chunk{ 'd', 'a', 't', 'a' },
+        data_chunk(300, 0x07) })
+    {
+        BOOST_REQUIRE(context.hash(chunk) == hmac_sha512_hash(chunk, key));
+        BOOST_REQUIRE(long_context.hash(chunk) ==
+            hmac_sha512_hash(chunk, long_key));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512__batch__matches_single)
+{
+    for (const auto& result: pkcs5_pbkdf2_hmac_sha512_tests)
+    {
+        // Five passphrases span a full and a partial group of lanes.
+        const data_stack passphrases
+        {
+            to_chunk(result.passphrase),
+            data_chunk{},
+            data_chunk(200, 0x01),
+            to_chunk(result.salt),
+            to_chunk(result.passphrase)
+        };
+
+        const auto salt = to_chunk(result.salt);
+        const auto hashes = pkcs5_pbkdf2_hmac_sha512(passphrases, salt,
+            result.iterations);
+        BOOST_REQUIRE_EQUAL(hashes.size(), passphrases.size());
+        BOOST_REQUIRE_EQUAL(encode_base16(hashes[0]), result.result);
+        BOOST_REQUIRE_EQUAL(encode_base16(hashes[4]), result.result);
+
+        for (size_t index = 0; index < passphrases.size(); ++index)
+            BOOST_REQUIRE(hashes[index] == pkcs5_pbkdf2_hmac_sha512(
+                passphrases[index], salt, result.iterations));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512__batch_empty__empty)
+{
+    const auto hashes = pkcs5_pbkdf2_hmac_sha512(data_stack{},
+        to_chunk("salt"), 2048);
+    BOOST_REQUIRE(hashes.empty());
+}
+
+// tools.ietf.org/html/rfc7914#section-12
+BOOST_AUTO_TEST_CASE(scrypt__rfc7914_vectors__expected)
+{
+    const auto empty = scrypt(data_chunk{}, data_chunk{}, 16, 1, 1, 64);
+    BOOST_REQUIRE_EQUAL(encode_base16(empty),
+        "77d6576238657b203b19ca42c18a0497f16b4844e3074ae8dfdffa3fede21442"
+        "fcd0069ded0948f8326a753a0fc81f17e8d3e0fb2e0d3628cf35e20c38d18906");
+
+    const auto password = scrypt(to_chunk(std::string("password")),
+        to_chunk(std::string("NaCl")), 1024, 16, 8, 64);
+    BOOST_REQUIRE_EQUAL(encode_base16(password),
+        "fdbabe1c9d3472007856e7190d01e9fe7c6ad7cbc8237830e77376634b373162"
+        "2eaf30d92e22a3886ff109279d9830dac727afb94a83ee6d8360cbdfa2cc0640");
+}
+
+BOOST_AUTO_TEST_CASE(scrypt_arena__hash__lanes__matches_scrypt)
+{
+    const auto data = to_chunk(std::string("password"));
+    const auto salt = to_chunk(std::string("NaCl"));
+    const auto expected = scrypt(data, salt, 1024, 16, 8, 64);
+
+    threadpool pool(2);
+
+    // Three lanes span full and partial batches of the sixteen blocks.
+    for (size_t lanes = 1; lanes <= 3; ++lanes)
+    {
+        scrypt_arena arena(pool, lanes);
+        BOOST_REQUIRE_EQUAL(arena.lanes(), lanes);
+        BOOST_REQUIRE(arena.hash(data, salt, 1024, 16, 8, 64) == expected);
+
+        // Reuse of the arena with smaller parameters.
+        BOOST_REQUIRE(arena.hash(data_chunk{}, data_chunk{}, 16, 1, 1, 64) ==
+            scrypt(data_chunk{}, data_chunk{}, 16, 1, 1, 64));
+    }
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(scrypt_arena__hash__default__matches_scrypt)
+{
+    scrypt_arena arena;
+    BOOST_REQUIRE_EQUAL(arena.lanes(), 1u);
+    BOOST_REQUIRE(arena.hash(data_chunk{}, data_chunk{}, 16, 1, 1, 64) ==
+        scrypt(data_chunk{}, data_chunk{}, 16, 1, 1, 64));
+}
+
+BOOST_AUTO_TEST_CASE(scrypt_arena__hash__invalid_N__throws)
+{
+    scrypt_arena arena;
+    BOOST_REQUIRE_THROW(arena.hash(data_chunk{}, data_chunk{}, 15, 1, 1, 64),
+        std::runtime_error);
+    BOOST_REQUIRE_THROW(arena.hash(data_chunk{}, data_chunk{}, 0, 1, 1, 64),
+        std::runtime_error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -40,4 +40,50 @@ BOOST_AUTO_TEST_CASE(hash_number__simple__test)
     BOOST_REQUIRE(!(our_value > target));
 }
 
+BOOST_AUTO_TEST_CASE(hash_number__divide__maximum_work__expected)
+{
+    hash_number target;
+    BOOST_REQUIRE(target.set_compact(max_work_bits));
+
+    // The work of a block at maximum target: ~target / (target + 1) + 1.
+    const hash_number one(1);
+    auto work = ~target / (target + one);
+    work += one;
+    BOOST_REQUIRE(work == 4295032833u);
+}
+
+BOOST_AUTO_TEST_CASE(hash_number__divide__multiple_digit_divisor__expected)
+{
+    hash_number numerator(hash_literal("00000000b873e79784647a6c82962c70d228557d24a747ea4d1b8bbe878e1206"));
+    const hash_number divisor(hash_literal("0000000000000000000000000000000000000000c0ffee00123456789abcdef1"));
+    numerator /= divisor;
+    BOOST_REQUIRE_EQUAL(encode_hash(numerator.hash()), "00000000000000000000000000000000f4a9bebb8928bbbc8ff2506f85b33f93");
+}
+
+BOOST_AUTO_TEST_CASE(hash_number__divide__greater_divisor__zero)
+{
+    hash_number numerator(42);
+    numerator /= hash_number(43);
+    BOOST_REQUIRE(numerator == 0);
+}
+
+BOOST_AUTO_TEST_CASE(hash_number__retarget__scaled__expected_compact)
+{
+    hash_number target;
+    BOOST_REQUIRE(target.set_compact(0x1b0404cb));
+    target *= 1209600;
+    target /= 1200000;
+    BOOST_REQUIRE_EQUAL(target.compact(), 0x1b040d05u);
+}
+
+BOOST_AUTO_TEST_CASE(hash_number__shift__across_limbs__round_trips_compact)
+{
+    hash_number value(0xffff);
+    value <<= 208;
+    hash_number expected;
+    BOOST_REQUIRE(expected.set_compact(max_work_bits));
+    BOOST_REQUIRE(!(value > expected) && !(value < expected));
+    BOOST_REQUIRE_EQUAL(value.compact(), max_work_bits);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
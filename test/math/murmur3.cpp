@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(murmur3_tests)
+
+struct murmur3_result
+{
+    uint32_t hash;
+    uint32_t seed;
+    std::string data;
+};
+
+// Reference values of the x86_32 variant, as used by bip37.
+static const std::vector<murmur3_result> murmur3_tests
+{
+    { 0x00000000, 0x00000000, "" },
+    { 0x6a396f08, 0xfba4c795, "" },
+    { 0x81f16f39, 0xffffffff, "" },
+    { 0x514e28b7, 0x00000000, "00" },
+    { 0xea3f0b17, 0xfba4c795, "00" },
+    { 0xfd6cf10d, 0x00000000, "ff" },
+    { 0x16c6b7ab, 0x00000000, "0011" },
+    { 0x8eb51c3d, 0x00000000, "001122" },
+    { 0xb4471bf8, 0x00000000, "00112233" },
+    { 0xe2301fa8, 0x00000000, "0011223344" },
+    { 0xfc2e4a15, 0x00000000, "001122334455" },
+    { 0xb074502c, 0x00000000, "00112233445566" },
+    { 0x8034d2a0, 0x00000000, "0011223344556677" },
+    { 0xb4698def, 0x00000000, "001122334455667788" }
+};
+
+BOOST_AUTO_TEST_CASE(murmur3__vectors__always__expected)
+{
+    for (const auto& result: murmur3_tests)
+    {
+        data_chunk data;
+        BOOST_REQUIRE(decode_base16(data, result.data));
+        BOOST_REQUIRE_EQUAL(murmur3(data, result.seed), result.hash);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(signature_cache_tests)
+
+static const auto secret = base16_literal(
+    "8010b1bb119ad37d4b65a1022a314897b1b3614b345974332cb1b9582cf03536");
+static const auto hash = hash_literal(
+    "4a5e1e4baab89f3a32518a88c31bc87f618f76673e2cc77ab2127b7afdeda33b");
+static const auto other_hash = hash_literal(
+    "000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+
+struct signed_hash
+{
+    ec_compressed point;
+    ec_signature signature;
+};
+
+static signed_hash sign_hash(const hash_digest& digest)
+{
+    signed_hash result;
+    BOOST_REQUIRE(secret_to_public(result.point, secret));
+    BOOST_REQUIRE(sign(result.signature, secret, digest));
+    return result;
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__verify__valid__caches_and_hits)
+{
+    signature_cache instance;
+    const auto signed_ = sign_hash(hash);
+    BOOST_REQUIRE(instance.verify(signed_.point, hash, signed_.signature));
+    BOOST_REQUIRE_EQUAL(instance.misses(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.hits(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+
+    BOOST_REQUIRE(instance.verify(signed_.point, hash, signed_.signature));
+    BOOST_REQUIRE_EQUAL(instance.misses(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.hits(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__verify__invalid__false_not_cached)
+{
+    signature_cache instance;
+    const auto signed_ = sign_hash(hash);
+    BOOST_REQUIRE(!instance.verify(signed_.point, other_hash,
+        signed_.signature));
+    BOOST_REQUIRE(!instance.contains(signed_.point, other_hash,
+        signed_.signature));
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__verify__invalid_point__false)
+{
+    signature_cache instance;
+    const auto signed_ = sign_hash(hash);
+    const data_chunk point(ec_compressed_size, 0x00);
+    BOOST_REQUIRE(!instance.verify(point, hash, signed_.signature));
+    BOOST_REQUIRE(!instance.verify(data_chunk(100, 0x02), hash,
+        signed_.signature));
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__verify__same_point__point_cache_hit)
+{
+    signature_cache instance;
+    const auto first = sign_hash(hash);
+    const auto second = sign_hash(other_hash);
+    BOOST_REQUIRE(instance.verify(first.point, hash, first.signature));
+    BOOST_REQUIRE(instance.verify(second.point, other_hash,
+        second.signature));
+    BOOST_REQUIRE_EQUAL(instance.point_misses(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.point_hits(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.misses(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__store__contains__true)
+{
+    signature_cache instance;
+    const auto signed_ = sign_hash(hash);
+    BOOST_REQUIRE(!instance.contains(signed_.point, hash, signed_.signature));
+    instance.store(signed_.point, hash, signed_.signature);
+    BOOST_REQUIRE(instance.contains(signed_.point, hash, signed_.signature));
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__store__over_capacity__bounded)
+{
+    signature_cache instance(2, 0);
+    const auto signed_ = sign_hash(hash);
+    instance.store(signed_.point, hash, signed_.signature);
+    instance.store(signed_.point, other_hash, signed_.signature);
+    instance.store(signed_.point, null_hash, signed_.signature);
+    BOOST_REQUIRE_EQUAL(instance.size(), 2u);
+    BOOST_REQUIRE(instance.contains(signed_.point, null_hash,
+        signed_.signature));
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__verify__zero_capacity__verifies_uncached)
+{
+    signature_cache instance(0, 0);
+    const auto signed_ = sign_hash(hash);
+    BOOST_REQUIRE(instance.verify(signed_.point, hash, signed_.signature));
+    BOOST_REQUIRE(instance.verify(signed_.point, hash, signed_.signature));
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.hits(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.misses(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__clear__cached__empty)
+{
+    signature_cache instance;
+    const auto signed_ = sign_hash(hash);
+    BOOST_REQUIRE(instance.verify(signed_.point, hash, signed_.signature));
+    instance.clear();
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE(!instance.contains(signed_.point, hash, signed_.signature));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(siphash_tests)
+
+// Reference vectors from the SipHash paper (key 00..0f, message 00..n-1).
+static const siphash_key reference_key{ 0x0706050403020100, 0x0f0e0d0c0b0a0908 };
+
+static data_chunk reference_message(size_t size)
+{
+    data_chunk message(size);
+    for (size_t index = 0; index < size; ++index)
+        message[index] = static_cast<uint8_t>(index);
+
+    return message;
+}
+
+BOOST_AUTO_TEST_CASE(siphash__empty__expected)
+{
+    BOOST_REQUIRE_EQUAL(siphash(reference_key, reference_message(0)), 0x726fdb47dd0e0e31u);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__one_byte__expected)
+{
+    BOOST_REQUIRE_EQUAL(siphash(reference_key, reference_message(1)), 0x74f839c593dc67fdu);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__one_word__expected)
+{
+    BOOST_REQUIRE_EQUAL(siphash(reference_key, reference_message(8)), 0x93f5f5799a932462u);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__fifteen_bytes__expected)
+{
+    BOOST_REQUIRE_EQUAL(siphash(reference_key, reference_message(15)), 0xa129ca6149be45e5u);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__sixty_three_bytes__expected)
+{
+    BOOST_REQUIRE_EQUAL(siphash(reference_key, reference_message(63)), 0x958a324ceb064572u);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__hash_digest__equals_general_form)
+{
+    hash_digest hash;
+    const auto message = reference_message(hash_size);
+    std::copy(message.begin(), message.end(), hash.begin());
+    BOOST_REQUIRE_EQUAL(siphash(reference_key, hash), 0x7127512f72f27cceu);
+    BOOST_REQUIRE_EQUAL(siphash(reference_key, hash), siphash(reference_key, message));
+}
+
+BOOST_AUTO_TEST_CASE(siphash__to_siphash_key__little_endian_words)
+{
+    half_hash hash;
+    const auto message = reference_message(half_hash_size);
+    std::copy(message.begin(), message.end(), hash.begin());
+    const auto key = to_siphash_key(hash);
+    BOOST_REQUIRE_EQUAL(key.first, reference_key.first);
+    BOOST_REQUIRE_EQUAL(key.second, reference_key.second);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::message;
+
+BOOST_AUTO_TEST_SUITE(bloom_filter_tests)
+
+static const auto first_element = base16_literal(
+    "99108ad8ed9bb6274d3980bab5a85c048f0950c8");
+static const auto second_element = base16_literal(
+    "b5a2c786d9ef4658287ced5914b37a1b4aa32eee");
+static const auto third_element = base16_literal(
+    "b9300670b4c5366e95b2699e8b18bc75e5f729c5");
+static const auto absent_element = base16_literal(
+    "19108ad8ed9bb6274d3980bab5a85c048f0950c8");
+
+static chain::transaction pay_key_hash(const chain::output_point& previous,
+    const short_hash& hash)
+{
+    const chain::input input(previous, chain::script{}, max_uint32);
+    const chain::output output(1000,
+        chain::script(chain::operation::to_pay_key_hash_pattern(hash)));
+    return chain::transaction(1, 0, { input }, { output });
+}
+
+static bloom_filter empty_filter(uint8_t flags)
+{
+    return bloom_filter(data_chunk(64, 0x00), 5, 42, flags);
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__constructor_1__always__invalid_contains_nothing)
+{
+    const bloom_filter instance;
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(!instance.contains(first_element));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__insert__bip37_vector__expected_filter)
+{
+    bloom_filter instance(data_chunk(3, 0x00), 5, 0, bloom_filter::all);
+    instance.insert(first_element);
+    BOOST_REQUIRE(instance.contains(first_element));
+    BOOST_REQUIRE(!instance.contains(absent_element));
+
+    instance.insert(second_element);
+    instance.insert(third_element);
+    BOOST_REQUIRE(instance.contains(second_element));
+    BOOST_REQUIRE(instance.contains(third_element));
+    BOOST_REQUIRE_EQUAL(encode_base16(instance.filter()), "614e9b");
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__insert__bip37_tweak_vector__expected_filter)
+{
+    bloom_filter instance(data_chunk(3, 0x00), 5, 2147483649,
+        bloom_filter::all);
+    instance.insert(first_element);
+    instance.insert(second_element);
+    instance.insert(third_element);
+    BOOST_REQUIRE(!instance.contains(absent_element));
+    BOOST_REQUIRE_EQUAL(encode_base16(instance.filter()), "ce4299");
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__constructor_2__filter_load__contains_loaded)
+{
+    const filter_load load(data_chunk{ 0x61, 0x4e, 0x9b }, 5, 0,
+        bloom_filter::all);
+    const bloom_filter instance(load);
+    BOOST_REQUIRE(instance.contains(first_element));
+    BOOST_REQUIRE(instance.contains(second_element));
+    BOOST_REQUIRE(instance.contains(third_element));
+    BOOST_REQUIRE(!instance.contains(absent_element));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__add__filter_add__contains_element)
+{
+    auto instance = empty_filter(bloom_filter::none);
+    instance.add(filter_add(to_chunk(first_element)));
+    BOOST_REQUIRE(instance.contains(first_element));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__is_valid__oversized__false)
+{
+    const bloom_filter size(data_chunk(bloom_filter::max_filter_size + 1),
+        1, 0, 0);
+    const bloom_filter functions(data_chunk(1),
+        bloom_filter::max_hash_functions + 1, 0, 0);
+    BOOST_REQUIRE(!size.is_valid());
+    BOOST_REQUIRE(!functions.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__is_relevant__transaction_hash__true)
+{
+    const auto tx = pay_key_hash({ null_hash, 0 }, first_element);
+    auto instance = empty_filter(bloom_filter::none);
+    BOOST_REQUIRE(!instance.is_relevant(tx));
+
+    instance.insert(tx.hash());
+    BOOST_REQUIRE(instance.is_relevant(tx));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__is_relevant__update_all__matches_spend)
+{
+    const auto funding = pay_key_hash({ null_hash, 0 }, first_element);
+    const auto spending = pay_key_hash({ funding.hash(), 0 }, second_element);
+    auto instance = empty_filter(bloom_filter::all);
+    instance.insert(first_element);
+    BOOST_REQUIRE(!instance.is_relevant(spending));
+    BOOST_REQUIRE(instance.is_relevant(funding));
+    BOOST_REQUIRE(instance.is_relevant(spending));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__is_relevant__pubkey_only_key_hash__no_update)
+{
+    const auto funding = pay_key_hash({ null_hash, 0 }, first_element);
+    const auto spending = pay_key_hash({ funding.hash(), 0 }, second_element);
+    auto instance = empty_filter(bloom_filter::pubkey_only);
+    instance.insert(first_element);
+    BOOST_REQUIRE(instance.is_relevant(funding));
+    BOOST_REQUIRE(!instance.is_relevant(spending));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__match__multiple_filters__expected_flags)
+{
+    const auto funding = pay_key_hash({ null_hash, 0 }, first_element);
+    const auto spending = pay_key_hash({ funding.hash(), 0 }, second_element);
+    const chain::transaction::list transactions{ funding, spending };
+
+    bloom_filter::list filters
+    {
+        empty_filter(bloom_filter::all),
+        empty_filter(bloom_filter::none),
+        empty_filter(bloom_filter::none)
+    };
+
+    filters[0].insert(first_element);
+    filters[1].insert(first_element);
+    filters[2].insert(second_element);
+
+    const auto result = bloom_filter::match(filters, transactions);
+    BOOST_REQUIRE_EQUAL(result.size(), 3u);
+    BOOST_REQUIRE(result[0] == bloom_filter::matches({ true, true }));
+    BOOST_REQUIRE(result[1] == bloom_filter::matches({ true, false }));
+    BOOST_REQUIRE(result[2] == bloom_filter::matches({ false, true }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
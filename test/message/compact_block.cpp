@@ -708,5 +708,25 @@ BOOST_AUTO_TEST_CASE(compact_block__operator_boolean_not_equals__differs__return
     BOOST_REQUIRE_EQUAL(true, instance != expected);
 }
 
+BOOST_AUTO_TEST_CASE(compact_block__to_short_id__always__low_six_siphash_bytes)
+{
+    const siphash_key key{ 0x0706050403020100, 0x0f0e0d0c0b0a0908 };
+    const auto hash = hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+    const auto expected = to_little_endian(siphash(key, hash));
+    const auto result = message::compact_block::to_short_id(key, hash);
+    BOOST_REQUIRE(std::equal(result.begin(), result.end(), expected.begin()));
+}
+
+BOOST_AUTO_TEST_CASE(compact_block__short_id_key__always__sha256_of_header_and_nonce)
+{
+    const auto header = chain::block::genesis_mainnet().header();
+    const uint64_t nonce = 42;
+    const message::compact_block instance(header, nonce, {}, {});
+    const auto digest = sha256_hash(header.to_data(), to_little_endian(nonce));
+    const auto key = instance.short_id_key();
+    BOOST_REQUIRE_EQUAL(key.first, from_little_endian_unsafe<uint64_t>(digest.begin()));
+    BOOST_REQUIRE_EQUAL(key.second, from_little_endian_unsafe<uint64_t>(digest.begin() + 8));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
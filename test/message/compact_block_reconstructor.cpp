@@ -0,0 +1,190 @@
+/**
+ * Copyright (c) 2011-2013 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::message;
+
+BOOST_AUTO_TEST_SUITE(compact_block_reconstructor_tests)
+
+static const uint64_t nonce = 42;
+
+static chain::block three_transaction_block()
+{
+    const auto genesis = chain::block::genesis_mainnet();
+    const chain::transaction::list transactions
+    {
+        genesis.transactions().front(),
+        chain::transaction(1, 48, {}, {}),
+        chain::transaction(2, 32, {}, {})
+    };
+
+    chain::block block(genesis.header(), transactions);
+    block.header().set_merkle(block.generate_merkle_root());
+    return block;
+}
+
+// Prefill the coinbase and provide short ids for the others.
+static compact_block to_compact_block(const chain::block& block)
+{
+    const auto& transactions = block.transactions();
+    compact_block instance(block.header(), nonce, {},
+        { prefilled_transaction(0, transactions.front()) });
+
+    const auto key = instance.short_id_key();
+    instance.set_short_ids(
+    {
+        compact_block::to_short_id(key, transactions[1].hash()),
+        compact_block::to_short_id(key, transactions[2].hash())
+    });
+
+    return instance;
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_reconstructor__construct__valid__incomplete)
+{
+    const auto block = three_transaction_block();
+    compact_block_reconstructor instance(to_compact_block(block));
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(!instance.is_complete());
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_reconstructor__construct__duplicate_short_ids__invalid)
+{
+    const auto block = three_transaction_block();
+    auto compact = to_compact_block(block);
+    compact.short_ids()[1] = compact.short_ids()[0];
+    compact_block_reconstructor instance(compact);
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_reconstructor__construct__prefilled_index_overflow__invalid)
+{
+    const auto block = three_transaction_block();
+    auto compact = to_compact_block(block);
+    compact.transactions().front().set_index(3);
+    compact_block_reconstructor instance(compact);
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_reconstructor__match__all_known__complete)
+{
+    const auto block = three_transaction_block();
+    compact_block_reconstructor instance(to_compact_block(block));
+    const chain::transaction::list known
+    {
+        chain::transaction(3, 16, {}, {}),
+        block.transactions()[2],
+        block.transactions()[1]
+    };
+
+    BOOST_REQUIRE_EQUAL(instance.match(known), 2u);
+    BOOST_REQUIRE(instance.is_complete());
+    BOOST_REQUIRE(instance.missing().indexes().empty());
+
+    block_message result;
+    BOOST_REQUIRE(instance.to_block(result));
+    BOOST_REQUIRE(result == block);
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_reconstructor__missing__one_known__requests_other)
+{
+    const auto block = three_transaction_block();
+    compact_block_reconstructor instance(to_compact_block(block));
+    BOOST_REQUIRE_EQUAL(instance.match({ block.transactions()[2] }), 1u);
+    BOOST_REQUIRE(!instance.is_complete());
+
+    block_message result;
+    BOOST_REQUIRE(!instance.to_block(result));
+
+    const auto request = instance.missing();
+    BOOST_REQUIRE(request.block_hash() == block.hash());
+    BOOST_REQUIRE_EQUAL(request.indexes().size(), 1u);
+    BOOST_REQUIRE_EQUAL(request.indexes()[0], 1u);
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_reconstructor__missing__none_known__differential_indexes)
+{
+    const auto block = three_transaction_block();
+    compact_block_reconstructor instance(to_compact_block(block));
+    const auto request = instance.missing();
+    BOOST_REQUIRE_EQUAL(request.indexes().size(), 2u);
+    BOOST_REQUIRE_EQUAL(request.indexes()[0], 1u);
+    BOOST_REQUIRE_EQUAL(request.indexes()[1], 0u);
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_reconstructor__fill__missing_reply__complete)
+{
+    const auto block = three_transaction_block();
+    compact_block_reconstructor instance(to_compact_block(block));
+    instance.match({ block.transactions()[2] });
+    const block_transactions reply(block.hash(), { block.transactions()[1] });
+    BOOST_REQUIRE(instance.fill(reply));
+    BOOST_REQUIRE(instance.is_complete());
+
+    block_message result;
+    BOOST_REQUIRE(instance.to_block(result));
+    BOOST_REQUIRE(result == block);
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_reconstructor__fill__excess_transactions__unchanged)
+{
+    const auto block = three_transaction_block();
+    compact_block_reconstructor instance(to_compact_block(block));
+    instance.match({ block.transactions()[2] });
+    const block_transactions reply(block.hash(),
+        { block.transactions()[1], block.transactions()[2] });
+    BOOST_REQUIRE(!instance.fill(reply));
+    BOOST_REQUIRE(!instance.is_complete());
+    BOOST_REQUIRE_EQUAL(instance.missing().indexes().size(), 1u);
+
+    block_message result;
+    BOOST_REQUIRE(!instance.to_block(result));
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_reconstructor__fill__short_reply__false_unchanged)
+{
+    const auto block = three_transaction_block();
+    compact_block_reconstructor instance(to_compact_block(block));
+    const block_transactions reply(block.hash(), { block.transactions()[1] });
+    BOOST_REQUIRE(!instance.fill(reply));
+    BOOST_REQUIRE(!instance.is_complete());
+    BOOST_REQUIRE_EQUAL(instance.missing().indexes().size(), 2u);
+
+    const block_transactions full(block.hash(),
+        { block.transactions()[1], block.transactions()[2] });
+    BOOST_REQUIRE(instance.fill(full));
+    BOOST_REQUIRE(instance.is_complete());
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_reconstructor__to_block__wrong_transaction__false)
+{
+    const auto block = three_transaction_block();
+    compact_block_reconstructor instance(to_compact_block(block));
+    instance.match({ block.transactions()[2] });
+    const block_transactions reply(block.hash(), { chain::transaction(3, 16, {}, {}) });
+    BOOST_REQUIRE(instance.fill(reply));
+
+    block_message result;
+    BOOST_REQUIRE(!instance.to_block(result));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -633,4 +633,63 @@ BOOST_AUTO_TEST_CASE(headers__to_inventory__non_empty__returns_header_hash_inven
     BOOST_REQUIRE(expected == result);
 }
 
+static header_message::list mainnet_headers()
+{
+    return
+    {
+        header_message{
+            1u,
+            null_hash,
+            hash_literal("4a5e1e4baab89f3a32518a88c31bc87f618f76673e2cc77ab2127b7afdeda33b"),
+            1231006505u,
+            0x1d00ffff,
+            2083236893u
+        },
+        header_message{
+            1u,
+            hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f"),
+            hash_literal("0e3e2357e806b6cdb1f70b54c3a3a17b6714ee1f0e68bebb44a74b1efd512098"),
+            1231469665u,
+            0x1d00ffff,
+            2573394689u
+        },
+        header_message{
+            1u,
+            hash_literal("00000000839a8e6886ab5951d76f411475428afc90947ee320161bbf18eb6048"),
+            hash_literal("9b0fc92260312ce44e74ef369f5c66bbb85848f2eddd5a7a1cde251e54ccfdd5"),
+            1231469744u,
+            0x1d00ffff,
+            1639830024u
+        }
+    };
+}
+
+BOOST_AUTO_TEST_CASE(headers__check_chain__empty__returns_zero)
+{
+    headers instance;
+    BOOST_REQUIRE_EQUAL(instance.check_chain(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(headers__check_chain__mainnet_sequence__returns_size)
+{
+    const headers instance(mainnet_headers());
+    BOOST_REQUIRE_EQUAL(instance.check_chain(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(headers__check_chain__broken_linkage__returns_failing_index)
+{
+    auto elements = mainnet_headers();
+    elements[2].set_previous_block_hash(null_hash);
+    const headers instance(std::move(elements));
+    BOOST_REQUIRE_EQUAL(instance.check_chain(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(headers__check_chain__insufficient_work__returns_failing_index)
+{
+    auto elements = mainnet_headers();
+    elements[1].set_nonce(0);
+    const headers instance(std::move(elements));
+    BOOST_REQUIRE_EQUAL(instance.check_chain(), 1u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
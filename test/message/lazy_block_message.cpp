@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2011-2013 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::message;
+
+BOOST_AUTO_TEST_SUITE(lazy_block_message_tests)
+
+static chain::block two_transaction_block()
+{
+    const chain::header header(10u,
+        hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f"),
+        hash_literal("4a5e1e4baab89f3a32518a88c31bc87f618f76673e2cc77ab2127b7afdeda33b"),
+        531234u,
+        6523454u,
+        68644u);
+
+    const auto genesis = chain::block::genesis_mainnet();
+    const auto& coinbase = genesis.transactions().front();
+    const chain::transaction::list transactions
+    {
+        coinbase,
+        chain::transaction(2, 32, {}, {})
+    };
+
+    return chain::block(header, transactions);
+}
+
+BOOST_AUTO_TEST_CASE(lazy_block_message__constructor__always__invalid)
+{
+    lazy_block_message instance;
+    BOOST_REQUIRE_EQUAL(false, instance.is_valid());
+    BOOST_REQUIRE_EQUAL(0u, instance.transaction_count());
+}
+
+BOOST_AUTO_TEST_CASE(lazy_block_message__from_data__insufficient_bytes__failure)
+{
+    const data_chunk data{ 10 };
+    lazy_block_message instance;
+    BOOST_REQUIRE_EQUAL(false, instance.from_data(block_message::version_minimum, data));
+    BOOST_REQUIRE_EQUAL(false, instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(lazy_block_message__from_data__truncated_transaction__failure)
+{
+    auto data = two_transaction_block().to_data();
+    data.pop_back();
+    lazy_block_message instance;
+    BOOST_REQUIRE_EQUAL(false, instance.from_data(block_message::version_minimum, data));
+    BOOST_REQUIRE_EQUAL(false, instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(lazy_block_message__from_data__trailing_bytes__failure)
+{
+    auto data = two_transaction_block().to_data();
+    data.push_back(42);
+    lazy_block_message instance;
+    BOOST_REQUIRE_EQUAL(false, instance.from_data(block_message::version_minimum, data));
+}
+
+BOOST_AUTO_TEST_CASE(lazy_block_message__from_data__valid__header_and_count)
+{
+    const auto expected = two_transaction_block();
+    const auto instance = lazy_block_message::factory_from_data(
+        block_message::version_minimum, expected.to_data());
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(expected.header() == instance.header());
+    BOOST_REQUIRE(expected.hash() == instance.hash());
+    BOOST_REQUIRE_EQUAL(2u, instance.transaction_count());
+    BOOST_REQUIRE_EQUAL(expected.serialized_size(),
+        instance.serialized_size(block_message::version_minimum));
+}
+
+BOOST_AUTO_TEST_CASE(lazy_block_message__transaction_at__valid__equals_source)
+{
+    const auto expected = two_transaction_block();
+    const auto instance = lazy_block_message::factory_from_data(
+        block_message::version_minimum, expected.to_data());
+    BOOST_REQUIRE(expected.transactions()[0] == instance.transaction_at(0));
+    BOOST_REQUIRE(expected.transactions()[1] == instance.transaction_at(1));
+    BOOST_REQUIRE_EQUAL(false, instance.transaction_at(2).is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(lazy_block_message__to_block_message__valid__equals_source)
+{
+    const auto expected = two_transaction_block();
+    const auto data = expected.to_data();
+    const auto instance = lazy_block_message::factory_from_data(
+        block_message::version_minimum, data);
+    const auto result = instance.to_block_message();
+    BOOST_REQUIRE(result == expected);
+    BOOST_REQUIRE(data == instance.to_data(block_message::version_minimum));
+}
+
+BOOST_AUTO_TEST_CASE(lazy_block_message__transaction_at__non_canonical_sizes__equals_source)
+{
+    static const size_t count_offset = 80;
+    static const size_t inputs_offset = count_offset + 1 + 4;
+    const auto expected = two_transaction_block();
+    auto data = expected.to_data();
+    BOOST_REQUIRE_EQUAL(data[count_offset], 2u);
+    BOOST_REQUIRE_EQUAL(data[inputs_offset], 1u);
+
+    // Encode the first input count and then the transaction count in three
+    // bytes, as the deserializer accepts non-canonical sizes.
+    data[inputs_offset] = varint_two_bytes;
+    data.insert(data.begin() + inputs_offset + 1, { 0x01, 0x00 });
+    data[count_offset] = varint_two_bytes;
+    data.insert(data.begin() + count_offset + 1, { 0x02, 0x00 });
+
+    const auto instance = lazy_block_message::factory_from_data(
+        block_message::version_minimum, data);
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE_EQUAL(2u, instance.transaction_count());
+    BOOST_REQUIRE(expected.transactions()[0] == instance.transaction_at(0));
+    BOOST_REQUIRE(expected.transactions()[1] == instance.transaction_at(1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
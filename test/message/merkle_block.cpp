@@ -612,4 +612,169 @@ BOOST_AUTO_TEST_CASE(merkle_block__operator_boolean_not_equals__differs__returns
     BOOST_REQUIRE_EQUAL(true, instance != expected);
 }
 
+static chain::block three_transaction_block()
+{
+    chain::transaction::list transactions
+    {
+        chain::transaction(1, 0, {}, {}),
+        chain::transaction(1, 1, {}, {}),
+        chain::transaction(1, 2, {}, {})
+    };
+
+    chain::block block(chain::header{}, transactions);
+    block.header().set_merkle(block.generate_merkle_root());
+    return block;
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__constructor_block__no_matches__root_only)
+{
+    const auto block = three_transaction_block();
+    const message::merkle_block instance(block, { false, false, false });
+    BOOST_REQUIRE_EQUAL(instance.total_transactions(), 3u);
+    BOOST_REQUIRE(instance.flags() == data_chunk{ 0x00 });
+    BOOST_REQUIRE_EQUAL(instance.hashes().size(), 1u);
+    BOOST_REQUIRE(instance.hashes().front() == block.header().merkle());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__constructor_block__match_count_mismatch__invalid)
+{
+    const auto block = three_transaction_block();
+    const message::merkle_block fewer(block, { true });
+    BOOST_REQUIRE(!fewer.is_valid());
+    BOOST_REQUIRE_EQUAL(fewer.total_transactions(), 0u);
+    BOOST_REQUIRE(fewer.hashes().empty());
+    BOOST_REQUIRE(fewer.flags().empty());
+
+    const message::merkle_block more(block, { true, true, true, true });
+    BOOST_REQUIRE(!more.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__constructor_block__middle_match__expected_tree)
+{
+    const auto block = three_transaction_block();
+    const auto& transactions = block.transactions();
+    const auto last = transactions[2].hash();
+    const message::merkle_block instance(block, { false, true, false });
+    BOOST_REQUIRE_EQUAL(instance.total_transactions(), 3u);
+
+    // Flags (depth first): root, left pair, first, second, right pair.
+    BOOST_REQUIRE(instance.flags() == data_chunk{ 0x0b });
+    BOOST_REQUIRE_EQUAL(instance.hashes().size(), 3u);
+    BOOST_REQUIRE(instance.hashes()[0] == transactions[0].hash());
+    BOOST_REQUIRE(instance.hashes()[1] == transactions[1].hash());
+    BOOST_REQUIRE(instance.hashes()[2] == bitcoin_hash(splice(last, last)));
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__constructor_block__single_transaction__leaf_only)
+{
+    const chain::block block(chain::header{},
+        { chain::transaction(1, 0, {}, {}) });
+    const message::merkle_block instance(block, { true });
+    BOOST_REQUIRE(instance.flags() == data_chunk{ 0x01 });
+    BOOST_REQUIRE_EQUAL(instance.hashes().size(), 1u);
+    BOOST_REQUIRE(instance.hashes().front() ==
+        block.transactions().front().hash());
+}
+
+static chain::block sequential_block(size_t count)
+{
+    chain::transaction::list transactions;
+
+    for (uint32_t locktime = 0; locktime < count; ++locktime)
+        transactions.emplace_back(1, locktime, chain::input::list{},
+            chain::output::list{});
+
+    chain::block block(chain::header{}, transactions);
+    block.header().set_merkle(block.generate_merkle_root());
+    return block;
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__extract_matches__constructed__round_trips)
+{
+    for (size_t count = 1; count <= 17; ++count)
+    {
+        const auto block = sequential_block(count);
+
+        // Match every third transaction, offset by the count.
+        std::vector<bool> matches(count);
+        hash_list expected_hashes;
+        chain::block::indexes expected_positions;
+
+        for (size_t index = 0; index < count; ++index)
+        {
+            matches[index] = ((index + count) % 3 == 0);
+
+            if (matches[index])
+            {
+                expected_hashes.push_back(block.transactions()[index].hash());
+                expected_positions.push_back(index);
+            }
+        }
+
+        const message::merkle_block instance(block, matches);
+        hash_list hashes;
+        chain::block::indexes positions;
+        BOOST_REQUIRE(instance.extract_matches(hashes, positions));
+        BOOST_REQUIRE(hashes == expected_hashes);
+        BOOST_REQUIRE(positions == expected_positions);
+        BOOST_REQUIRE(instance.is_valid_merkle_root());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__is_valid_merkle_root__default__false)
+{
+    const message::merkle_block instance;
+    BOOST_REQUIRE(!instance.is_valid_merkle_root());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__is_valid_merkle_root__wrong_header__false)
+{
+    auto block = sequential_block(5);
+    block.header().set_merkle(null_hash);
+    const message::merkle_block instance(block,
+        { false, true, false, false, true });
+    BOOST_REQUIRE(!instance.is_valid_merkle_root());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__is_valid_merkle_root__tampered_hash__false)
+{
+    const auto block = sequential_block(5);
+    message::merkle_block instance(block, { false, true, false, false, true });
+    instance.hashes().front().front() ^= 0x01;
+    BOOST_REQUIRE(!instance.is_valid_merkle_root());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__is_valid_merkle_root__extra_hash__false)
+{
+    const auto block = sequential_block(5);
+    message::merkle_block instance(block, { false, true, false, false, true });
+    instance.hashes().push_back(null_hash);
+    BOOST_REQUIRE(!instance.is_valid_merkle_root());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__is_valid_merkle_root__extra_flags__false)
+{
+    const auto block = sequential_block(5);
+    message::merkle_block instance(block, { false, true, false, false, true });
+    instance.flags().push_back(0x00);
+    BOOST_REQUIRE(!instance.is_valid_merkle_root());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__is_valid_merkle_root__duplicated_siblings__false)
+{
+    // Three transactions hash to the same root as four with the last repeated.
+    const auto block = sequential_block(3);
+    const auto last = block.transactions().back().hash();
+    const auto root = block.header().merkle();
+    message::merkle_block instance(block, { false, false, true });
+    BOOST_REQUIRE(instance.is_valid_merkle_root());
+
+    instance.set_total_transactions(4);
+    instance.set_flags({ 0x1d });
+    hash_list hashes{ instance.hashes().front(), last, last };
+    instance.set_hashes(hashes);
+    BOOST_REQUIRE(instance.header().merkle() == root);
+    BOOST_REQUIRE(!instance.is_valid_merkle_root());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,324 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(parallel_tests)
+
+static void finish(threadpool& pool)
+{
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__grain__each_element_once)
+{
+    static const size_t count = 10007;
+    threadpool pool(4);
+    std::vector<std::atomic<size_t>> visits(count);
+    for (auto& visit: visits)
+        visit = 0;
+
+    std::atomic<size_t> chunks(0);
+    parallel_for(pool, count, 100, [&](size_t begin, size_t end)
+    {
+        BOOST_REQUIRE_LE(end - begin, 100u);
+        ++chunks;
+
+        for (auto index = begin; index < end; ++index)
+            ++visits[index];
+    });
+
+    finish(pool);
+    BOOST_REQUIRE_EQUAL(chunks.load(), 101u);
+
+    for (const auto& visit: visits)
+        BOOST_REQUIRE_EQUAL(visit.load(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__empty_pool__inline)
+{
+    threadpool pool;
+    size_t total = 0;
+    parallel_for(pool, 10, 3, [&](size_t begin, size_t end)
+    {
+        total += end - begin;
+    });
+
+    BOOST_REQUIRE_EQUAL(total, 10u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__zero_count__no_calls)
+{
+    threadpool pool(2);
+    size_t calls = 0;
+    parallel_for(pool, 0, [&](size_t, size_t)
+    {
+        ++calls;
+    });
+
+    finish(pool);
+    BOOST_REQUIRE_EQUAL(calls, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__handler_throws__rethrown)
+{
+    threadpool pool(4);
+    std::atomic<size_t> calls(0);
+    const auto handler = [&](size_t begin, size_t)
+    {
+        ++calls;
+        if (begin == 50)
+            throw std::runtime_error("failure");
+    };
+
+    BOOST_REQUIRE_THROW(parallel_for(pool, 1000, 10, handler),
+        std::runtime_error);
+
+    finish(pool);
+    BOOST_REQUIRE_LE(calls.load(), 100u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__from_every_pool_thread__completes)
+{
+    static const size_t threads = 2;
+    static const size_t count = 1000;
+    threadpool pool(threads);
+    std::atomic<size_t> visits(0);
+    std::atomic<size_t> completed(0);
+
+    // Each pool thread blocks in parallel_for, so no helper task can start.
+    for (size_t task = 0; task < threads; ++task)
+    {
+        pool.service().post([&]()
+        {
+            parallel_for(pool, count, 10, [&](size_t begin, size_t end)
+            {
+                visits += end - begin;
+            });
+
+            ++completed;
+        });
+    }
+
+    while (completed != threads)
+        std::this_thread::yield();
+
+    finish(pool);
+    BOOST_REQUIRE_EQUAL(visits.load(), threads * count);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__stopped_pool__completes_on_caller)
+{
+    threadpool pool(2);
+    finish(pool);
+
+    std::atomic<size_t> visits(0);
+    parallel_for(pool, 100, 10, [&](size_t begin, size_t end)
+    {
+        visits += end - begin;
+    });
+
+    BOOST_REQUIRE_EQUAL(visits.load(), 100u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_reduce__sum__expected)
+{
+    static const size_t count = 100000;
+    threadpool pool(4);
+    const auto map = [](size_t begin, size_t end)
+    {
+        uint64_t sum = 0;
+        for (auto index = begin; index < end; ++index)
+            sum += index;
+
+        return sum;
+    };
+
+    const auto add = [](uint64_t left, uint64_t right)
+    {
+        return left + right;
+    };
+
+    const auto sum = parallel_reduce(pool, count, 1000, uint64_t(0), map,
+        add);
+
+    finish(pool);
+    BOOST_REQUIRE_EQUAL(sum, uint64_t(count) * (count - 1) / 2);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_reduce__concatenate__chunk_order)
+{
+    threadpool pool(4);
+    const auto map = [](size_t begin, size_t end)
+    {
+        std::string out;
+        for (auto index = begin; index < end; ++index)
+            out += static_cast<char>('a' + index);
+
+        return out;
+    };
+
+    const auto join = [](std::string left, std::string right)
+    {
+        return left + right;
+    };
+
+    const auto text = parallel_reduce(pool, 26, 3, std::string(), map, join);
+    finish(pool);
+    BOOST_REQUIRE_EQUAL(text, "abcdefghijklmnopqrstuvwxyz");
+}
+
+BOOST_AUTO_TEST_CASE(parallel__pipeline__ordered_stage__push_order)
+{
+    static const size_t count = 1000;
+    threadpool pool(4);
+    std::vector<size_t> connected;
+
+    {
+        pipeline<size_t> stages(pool, 16);
+        stages.concurrent([](size_t& item)
+        {
+            item *= 2;
+            return true;
+        });
+
+        stages.ordered([&connected](size_t& item)
+        {
+            connected.push_back(item);
+            return true;
+        });
+
+        for (size_t item = 0; item < count; ++item)
+            stages.push(item);
+    }
+
+    finish(pool);
+    BOOST_REQUIRE_EQUAL(connected.size(), count);
+
+    for (size_t index = 0; index < count; ++index)
+        BOOST_REQUIRE_EQUAL(connected[index], index * 2);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__pipeline__rejected__skips_later_stages)
+{
+    threadpool pool(4);
+    std::atomic<size_t> checked(0);
+    std::vector<size_t> connected;
+
+    {
+        pipeline<size_t> stages(pool, 4);
+        stages.concurrent([&checked](size_t& item)
+        {
+            ++checked;
+            return item % 3 != 0;
+        });
+
+        stages.ordered([&connected](size_t& item)
+        {
+            connected.push_back(item);
+            return true;
+        });
+
+        for (size_t item = 0; item < 10; ++item)
+            stages.push(item);
+
+        stages.wait();
+    }
+
+    finish(pool);
+    BOOST_REQUIRE_EQUAL(checked.load(), 10u);
+    const std::vector<size_t> expected{ 1, 2, 4, 5, 7, 8 };
+    BOOST_REQUIRE(connected == expected);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__pipeline__stage_throws__skipped_and_rethrown)
+{
+    threadpool pool(4);
+    std::vector<size_t> connected;
+
+    {
+        pipeline<size_t> stages(pool, 4);
+        stages.concurrent([](size_t& item)
+        {
+            if (item == 5)
+                throw std::runtime_error("failure");
+
+            return true;
+        });
+
+        stages.ordered([&connected](size_t& item)
+        {
+            connected.push_back(item);
+            return true;
+        });
+
+        for (size_t item = 0; item < 10; ++item)
+            stages.push(item);
+
+        BOOST_REQUIRE_THROW(stages.wait(), std::runtime_error);
+        stages.wait();
+    }
+
+    finish(pool);
+    const std::vector<size_t> expected{ 0, 1, 2, 3, 4, 6, 7, 8, 9 };
+    BOOST_REQUIRE(connected == expected);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__pipeline__capacity__bounds_in_flight)
+{
+    static const size_t capacity = 3;
+    threadpool pool(4);
+    std::atomic<size_t> active(0);
+    std::atomic<size_t> peak(0);
+
+    {
+        pipeline<size_t> stages(pool, capacity);
+        stages.concurrent([&](size_t&)
+        {
+            const auto now = ++active;
+            auto prior = peak.load();
+            while (now > prior && !peak.compare_exchange_weak(prior, now));
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            --active;
+            return true;
+        });
+
+        for (size_t item = 0; item < 50; ++item)
+            stages.push(item);
+    }
+
+    finish(pool);
+    BOOST_REQUIRE_LE(peak.load(), capacity);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -83,4 +83,13 @@ BOOST_AUTO_TEST_CASE(random__pseudo_randomize__superminute_ratio_255__expected)
     BOOST_REQUIRE(result >= minimum);
 }
 
+BOOST_AUTO_TEST_CASE(random__secure_random_fill__two_fills__different)
+{
+    data_chunk first(32);
+    data_chunk second(32);
+    secure_random_fill(first);
+    secure_random_fill(second);
+    BOOST_REQUIRE(first != second);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
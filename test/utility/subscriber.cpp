@@ -0,0 +1,214 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(subscriber_tests)
+
+typedef subscriber<int> int_subscriber;
+typedef resubscriber<int> int_resubscriber;
+
+BOOST_AUTO_TEST_CASE(subscriber__subscribe__stopped__invokes_stopped_args)
+{
+    threadpool pool;
+    const auto instance = std::make_shared<int_subscriber>(pool, "test");
+    auto result = 0;
+    instance->subscribe([&](int value) { result = value; }, 42);
+    BOOST_REQUIRE_EQUAL(result, 42);
+}
+
+BOOST_AUTO_TEST_CASE(subscriber__invoke__started__notifies_once_in_order)
+{
+    threadpool pool;
+    const auto instance = std::make_shared<int_subscriber>(pool, "test");
+    instance->start();
+
+    std::vector<int> notified;
+    for (auto index = 0; index < 3; ++index)
+        instance->subscribe([&notified, index](int value)
+        {
+            notified.push_back(index * 10 + value);
+        }, 0);
+
+    instance->invoke(1);
+    instance->invoke(2);
+    instance->stop();
+    instance->invoke(3);
+    BOOST_REQUIRE(notified == (std::vector<int>{ 1, 11, 21 }));
+}
+
+BOOST_AUTO_TEST_CASE(subscriber__subscribe__after_stop__invokes_stopped_args)
+{
+    threadpool pool;
+    const auto instance = std::make_shared<int_subscriber>(pool, "test");
+    instance->start();
+    instance->stop();
+    auto result = 0;
+    instance->subscribe([&](int value) { result = value; }, 7);
+    BOOST_REQUIRE_EQUAL(result, 7);
+}
+
+BOOST_AUTO_TEST_CASE(subscriber__subscribe__concurrent__all_notified)
+{
+    static const size_t threads = 4;
+    static const size_t subscriptions = 1000;
+
+    threadpool pool;
+    const auto instance = std::make_shared<int_subscriber>(pool, "test");
+    instance->start();
+
+    std::atomic<size_t> notified(0);
+    std::vector<std::thread> workers;
+    for (size_t thread = 0; thread < threads; ++thread)
+        workers.emplace_back([&]()
+        {
+            for (size_t index = 0; index < subscriptions; ++index)
+                instance->subscribe([&](int) { ++notified; }, 0);
+        });
+
+    for (auto& worker: workers)
+        worker.join();
+
+    instance->invoke(0);
+    instance->stop();
+    BOOST_REQUIRE_EQUAL(notified.load(), threads * subscriptions);
+}
+
+BOOST_AUTO_TEST_CASE(resubscriber__invoke__resubscribe__retains_in_order)
+{
+    threadpool pool;
+    const auto instance = std::make_shared<int_resubscriber>(pool, "test");
+    instance->start();
+
+    std::vector<int> notified;
+    for (auto index = 0; index < 4; ++index)
+        instance->subscribe([&notified, index](int value)
+        {
+            notified.push_back(index * 10 + value);
+            return index % 2 == 0;
+        }, 0);
+
+    instance->invoke(1);
+    instance->invoke(2);
+    instance->stop();
+    instance->invoke(3);
+    const std::vector<int> expected{ 1, 11, 21, 31, 2, 22, 3, 23 };
+    BOOST_REQUIRE(notified == expected);
+}
+
+BOOST_AUTO_TEST_CASE(resubscriber__invoke__subscribe_in_handler__notified_next)
+{
+    threadpool pool;
+    const auto instance = std::make_shared<int_resubscriber>(pool, "test");
+    instance->start();
+
+    std::vector<int> notified;
+    instance->subscribe([&](int value)
+    {
+        notified.push_back(value);
+        instance->subscribe([&](int inner)
+        {
+            notified.push_back(100 + inner);
+            return false;
+        }, 0);
+
+        return value < 2;
+    }, 0);
+
+    instance->invoke(1);
+    instance->invoke(2);
+    instance->stop();
+    instance->invoke(3);
+    BOOST_REQUIRE(notified == (std::vector<int>{ 1, 102, 2, 103 }));
+}
+
+BOOST_AUTO_TEST_CASE(resubscriber__invoke__stopped_during_invoke__not_retained)
+{
+    threadpool pool;
+    const auto instance = std::make_shared<int_resubscriber>(pool, "test");
+    instance->start();
+
+    auto count = 0;
+    instance->subscribe([&](int)
+    {
+        ++count;
+        instance->stop();
+        return true;
+    }, 0);
+
+    instance->invoke(0);
+    instance->invoke(0);
+    BOOST_REQUIRE_EQUAL(count, 1);
+}
+
+BOOST_AUTO_TEST_CASE(subscriber__invoke__handler_throws__releases_remaining)
+{
+    threadpool pool;
+    const auto instance = std::make_shared<int_subscriber>(pool, "test");
+    instance->start();
+
+    const auto token = std::make_shared<int>(0);
+    const std::weak_ptr<int> observer(token);
+    instance->subscribe([](int) { throw std::runtime_error("handler"); }, 0);
+    instance->subscribe([token](int) {}, 0);
+    instance->subscribe([token](int) {}, 0);
+
+    BOOST_REQUIRE_THROW(instance->invoke(1), std::runtime_error);
+    instance->stop();
+    instance->invoke(0);
+
+    BOOST_REQUIRE_EQUAL(observer.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(resubscriber__invoke__handler_throws__retains_notified)
+{
+    threadpool pool;
+    const auto instance = std::make_shared<int_resubscriber>(pool, "test");
+    instance->start();
+
+    const auto token = std::make_shared<int>(0);
+    const std::weak_ptr<int> observer(token);
+    auto count = 0;
+    instance->subscribe([&](int) { ++count; return true; }, 0);
+    instance->subscribe([](int) -> bool
+    {
+        throw std::runtime_error("handler");
+    }, 0);
+    instance->subscribe([token](int) { return true; }, 0);
+
+    BOOST_REQUIRE_THROW(instance->invoke(1), std::runtime_error);
+    BOOST_REQUIRE_EQUAL(observer.use_count(), 1);
+
+    instance->invoke(2);
+    BOOST_REQUIRE_EQUAL(count, 2);
+    instance->stop();
+    instance->invoke(0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
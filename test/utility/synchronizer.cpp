@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <thread>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(synchronizer_tests)
+
+typedef std::function<void(const code&)> result_handler;
+
+struct recorder
+{
+    void operator()(const code& ec)
+    {
+        ++calls;
+        result = ec;
+    }
+
+    size_t calls = 0;
+    code result;
+};
+
+template <template <typename> class Synchronizer>
+static void complete_all(synchronizer_terminate mode,
+    const std::vector<code>& codes, recorder& out)
+{
+    const auto handler = [&out](const code& ec) { out(ec); };
+    Synchronizer<result_handler> call(handler, codes.size(), "test", mode);
+
+    for (const auto& ec: codes)
+        call(ec);
+}
+
+BOOST_AUTO_TEST_CASE(synchronizer__on_count__errors__success_once)
+{
+    recorder out;
+    complete_all<synchronizer>(synchronizer_terminate::on_count,
+        { error::success, error::bad_stream, error::success }, out);
+    BOOST_REQUIRE_EQUAL(out.calls, 1u);
+    BOOST_REQUIRE_EQUAL(out.result, error::success);
+}
+
+BOOST_AUTO_TEST_CASE(synchronizer__on_count_first_error__errors__first_error)
+{
+    recorder out;
+    complete_all<synchronizer>(synchronizer_terminate::on_count_first_error,
+        { error::success, error::bad_stream, error::operation_failed }, out);
+    BOOST_REQUIRE_EQUAL(out.calls, 1u);
+    BOOST_REQUIRE_EQUAL(out.result, error::bad_stream);
+}
+
+BOOST_AUTO_TEST_CASE(atomic_synchronizer__on_count__errors__success_once)
+{
+    recorder out;
+    complete_all<atomic_synchronizer>(synchronizer_terminate::on_count,
+        { error::success, error::bad_stream, error::success }, out);
+    BOOST_REQUIRE_EQUAL(out.calls, 1u);
+    BOOST_REQUIRE_EQUAL(out.result, error::success);
+}
+
+BOOST_AUTO_TEST_CASE(atomic_synchronizer__on_count_first_error__errors__first)
+{
+    recorder out;
+    complete_all<atomic_synchronizer>(
+        synchronizer_terminate::on_count_first_error,
+        { error::success, error::bad_stream, error::operation_failed }, out);
+    BOOST_REQUIRE_EQUAL(out.calls, 1u);
+    BOOST_REQUIRE_EQUAL(out.result, error::bad_stream);
+}
+
+BOOST_AUTO_TEST_CASE(atomic_synchronizer__on_count_first_error__none__success)
+{
+    recorder out;
+    complete_all<atomic_synchronizer>(
+        synchronizer_terminate::on_count_first_error,
+        { error::success, error::success }, out);
+    BOOST_REQUIRE_EQUAL(out.calls, 1u);
+    BOOST_REQUIRE_EQUAL(out.result, error::success);
+}
+
+BOOST_AUTO_TEST_CASE(atomic_synchronizer__on_error__error__terminates_early)
+{
+    recorder out;
+    complete_all<atomic_synchronizer>(synchronizer_terminate::on_error,
+        { error::success, error::bad_stream, error::operation_failed }, out);
+    BOOST_REQUIRE_EQUAL(out.calls, 1u);
+    BOOST_REQUIRE_EQUAL(out.result, error::bad_stream);
+}
+
+BOOST_AUTO_TEST_CASE(atomic_synchronizer__on_success__success__terminates_early)
+{
+    recorder out;
+    complete_all<atomic_synchronizer>(synchronizer_terminate::on_success,
+        { error::bad_stream, error::success, error::success }, out);
+    BOOST_REQUIRE_EQUAL(out.calls, 1u);
+    BOOST_REQUIRE_EQUAL(out.result, error::success);
+}
+
+BOOST_AUTO_TEST_CASE(atomic_synchronizer__on_success__failures__failed)
+{
+    recorder out;
+    complete_all<atomic_synchronizer>(synchronizer_terminate::on_success,
+        { error::bad_stream, error::bad_stream }, out);
+    BOOST_REQUIRE_EQUAL(out.calls, 1u);
+    BOOST_REQUIRE_EQUAL(out.result, error::operation_failed);
+}
+
+BOOST_AUTO_TEST_CASE(atomic_synchronizer__concurrent_copies__handler_once)
+{
+    static const size_t threads = 4;
+    static const size_t each = 10000;
+
+    std::atomic<size_t> calls(0);
+    auto call = synchronize_atomic([&calls](const code&) { ++calls; },
+        threads * each, "test", synchronizer_terminate::on_count);
+
+    std::vector<std::thread> workers;
+    for (size_t thread = 0; thread < threads; ++thread)
+        workers.emplace_back([call]() mutable
+        {
+            for (size_t index = 0; index < each; ++index)
+                call(error::success);
+        });
+
+    for (auto& worker: workers)
+        worker.join();
+
+    BOOST_REQUIRE_EQUAL(calls.load(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(dispatcher__parallel__atomic_synchronizer__all_complete)
+{
+    threadpool pool(4);
+    dispatcher dispatch(pool, "test");
+    const std::vector<size_t> elements{ 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    std::atomic<size_t> sum(0);
+    std::promise<code> complete;
+    const auto job = [&sum](size_t element, result_handler handler)
+    {
+        sum += element;
+        handler(error::success);
+    };
+
+    dispatch.parallel<atomic_synchronizer>(elements, "test",
+        [&complete](const code& ec) { complete.set_value(ec); }, job);
+
+    BOOST_REQUIRE_EQUAL(complete.get_future().get(), error::success);
+    BOOST_REQUIRE_EQUAL(sum.load(), 36u);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
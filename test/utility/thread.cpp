@@ -19,7 +19,9 @@
  */
 #include <boost/test/unit_test.hpp>
 
+#include <future>
 #include <stdexcept>
+#include <string>
 #include <bitcoin/bitcoin.hpp>
 
 #ifdef _MSC_VER
@@ -113,4 +115,55 @@ BOOST_AUTO_TEST_CASE(thread__set_thread_priority__invalid__throws_invalid_argume
     BOOST_REQUIRE_THROW(set_thread_priority(static_cast<thread_priority>(42)), std::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE(thread__parse_processors__ranges_and_singles__expected)
+{
+    const processor_set expected{ 0, 1, 2, 3, 8, 10, 11 };
+    BOOST_REQUIRE(parse_processors("0-3,8,10-11") == expected);
+}
+
+BOOST_AUTO_TEST_CASE(thread__parse_processors__invalid__empty)
+{
+    BOOST_REQUIRE(parse_processors("").empty());
+    BOOST_REQUIRE(parse_processors("3-1").empty());
+    BOOST_REQUIRE(parse_processors("0,x").empty());
+    BOOST_REQUIRE(parse_processors("0-").empty());
+    BOOST_REQUIRE(parse_processors("99999").empty());
+}
+
+BOOST_AUTO_TEST_CASE(thread__set_thread_affinity__empty__true)
+{
+    BOOST_REQUIRE(set_thread_affinity({}));
+}
+
+BOOST_AUTO_TEST_CASE(thread__set_thread_affinity__out_of_range__false)
+{
+    BOOST_REQUIRE(!set_thread_affinity({ 1u << 20 }));
+}
+
+BOOST_AUTO_TEST_CASE(thread__threadpool__placed__named_and_runs)
+{
+    std::string name;
+    const thread_placement placement{ "pool", numa_processors(0), true };
+    threadpool pool(2, thread_priority::normal, placement);
+    std::promise<void> ran;
+
+    pool.service().post([&]()
+    {
+#ifdef __linux__
+        char buffer[16] = { 0 };
+        pthread_getname_np(pthread_self(), buffer, sizeof(buffer));
+        name = buffer;
+#endif
+        ran.set_value();
+    });
+
+    ran.get_future().wait();
+    pool.shutdown();
+    pool.join();
+
+#ifdef __linux__
+    BOOST_REQUIRE(name == "pool-0" || name == "pool-1");
+#endif
+}
+
 BOOST_AUTO_TEST_SUITE_END()
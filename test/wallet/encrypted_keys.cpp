@@ -661,6 +661,91 @@ BOOST_AUTO_TEST_CASE(encrypted__create_token_lot__private_and_public_compressed_
 
 BOOST_AUTO_TEST_SUITE_END()
 
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(encrypted__batch)
+
+BOOST_AUTO_TEST_CASE(encrypted__encrypt_batch__vectors_0_and_1__expected)
+{
+    const secret_list secrets
+    {
+        base16_literal("cbf4b9f70470856bb4f40f80b87edb90865997ffee6df315ab166d713af433a5"),
+        base16_literal("09c2686880095b1a4c249ee3ac4eea8a014f11e6f986d0b5025ac1f39afbd9ae")
+    };
+
+    // Each secret under the same passphrase matches the single encryption.
+    threadpool pool(2);
+    encrypted_private_list out_private;
+    BOOST_REQUIRE(encrypt(out_private, secrets, "TestingOneTwoThree", 0x00, false, pool, 2));
+    pool.shutdown();
+    pool.join();
+    BOOST_REQUIRE_EQUAL(out_private.size(), 2u);
+    BOOST_REQUIRE_EQUAL(encode_base58(out_private[0]), "6PRVWUbkzzsbcVac2qwfssoUJAN1Xhrg6bNk8J7Nzm5H7kxEbn2Nh2ZoGg");
+
+    encrypted_private expected;
+    BOOST_REQUIRE(encrypt(expected, secrets[1], "TestingOneTwoThree", 0x00, false));
+    BOOST_REQUIRE_EQUAL(encode_base58(out_private[1]), encode_base58(expected));
+}
+
+BOOST_AUTO_TEST_CASE(encrypted__decrypt_batch__mixed_keys__expected)
+{
+    // Vector 8 appears twice and so shares an owner salt prefactor.
+    const encrypted_private_list keys
+    {
+        base58_literal("6PfPAw5HErFdzMyBvGMwSfSWjKmzgm3jDg7RxQyVCSSBJFZLAZ6hVupmpn"),
+        base58_literal("6PfPAw5HErFdzMyBvGMwSfSWjKmzgm3jDg7RxQyVCSSBJFZLAZ6hVupmpn")
+    };
+
+    secret_list out_secrets;
+    data_chunk out_versions;
+    std::vector<bool> out_compressed;
+    threadpool pool(3);
+    BOOST_REQUIRE(decrypt(out_secrets, out_versions, out_compressed, keys, "libbitcoin test", pool, 3));
+    pool.shutdown();
+    pool.join();
+    BOOST_REQUIRE_EQUAL(out_secrets.size(), 2u);
+    BOOST_REQUIRE_EQUAL(encode_base16(out_secrets[0]), "fb4bfb0bfe151d524b0b11983b9f826d6a0bc7f7bdc480864a1b557ff0c59eb4");
+    BOOST_REQUIRE_EQUAL(encode_base16(out_secrets[1]), "fb4bfb0bfe151d524b0b11983b9f826d6a0bc7f7bdc480864a1b557ff0c59eb4");
+    BOOST_REQUIRE_EQUAL(out_versions[0], 0x00);
+    BOOST_REQUIRE(!out_compressed[1]);
+}
+
+BOOST_AUTO_TEST_CASE(encrypted__decrypt_batch__round_trip__expected)
+{
+    const secret_list secrets
+    {
+        base16_literal("cbf4b9f70470856bb4f40f80b87edb90865997ffee6df315ab166d713af433a5"),
+        base16_literal("09c2686880095b1a4c249ee3ac4eea8a014f11e6f986d0b5025ac1f39afbd9ae")
+    };
+
+    encrypted_private_list keys;
+    BOOST_REQUIRE(encrypt(keys, secrets, "passphrase", 111, true));
+
+    secret_list out_secrets;
+    data_chunk out_versions;
+    std::vector<bool> out_compressed;
+    BOOST_REQUIRE(decrypt(out_secrets, out_versions, out_compressed, keys, "passphrase"));
+    BOOST_REQUIRE(out_secrets == secrets);
+    BOOST_REQUIRE_EQUAL(out_versions[1], 111u);
+    BOOST_REQUIRE(out_compressed[0]);
+}
+
+BOOST_AUTO_TEST_CASE(encrypted__decrypt_batch__wrong_passphrase__false_unchanged)
+{
+    const encrypted_private_list keys
+    {
+        base58_literal("6PRVWUbkzzsbcVac2qwfssoUJAN1Xhrg6bNk8J7Nzm5H7kxEbn2Nh2ZoGg")
+    };
+
+    secret_list out_secrets;
+    data_chunk out_versions;
+    std::vector<bool> out_compressed;
+    BOOST_REQUIRE(!decrypt(out_secrets, out_versions, out_compressed, keys, "Satoshi"));
+    BOOST_REQUIRE(out_secrets.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 #endif
 
 // ----------------------------------------------------------------------------
@@ -131,4 +131,44 @@ BOOST_AUTO_TEST_CASE(hd_private__derive_public__long_seed__expected)
     BOOST_REQUIRE_EQUAL(m0xH1yH2_pub.encoded(), "xpub6FnCn6nSzZAw5Tw7cgR9bi15UV96gLZhjDstkXXxvCLsUXBGXPdSnLFbdpq8p9HmGsApME5hQTZ3emM2rnY5agb9rXpVGyy3bdW6EEgAtqt");
 }
 
+BOOST_AUTO_TEST_CASE(hd_private__derive_range__spans_hardened__matches_derive_private)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    const auto first = hd_first_hardened_key - 3;
+    const auto children = m.derive_range(first, 6);
+    BOOST_REQUIRE_EQUAL(children.size(), 6u);
+
+    for (uint32_t index = 0; index < children.size(); ++index)
+        BOOST_REQUIRE(children[index] == m.derive_private(first + index));
+}
+
+BOOST_AUTO_TEST_CASE(hd_private__derive_range__last_index__no_wrap)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    const auto children = m.derive_range(max_uint32, 2);
+    BOOST_REQUIRE_EQUAL(children.size(), 2u);
+    BOOST_REQUIRE(children[0] == m.derive_private(max_uint32));
+    BOOST_REQUIRE(!children[1]);
+}
+
+BOOST_AUTO_TEST_CASE(hd_private__derive_range__threadpool__matches_serial)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, LONG_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    threadpool pool(4);
+    const auto parallel = m.derive_range(0, 9, pool);
+    pool.shutdown();
+    pool.join();
+
+    BOOST_REQUIRE(parallel == m.derive_range(0, 9));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -96,4 +96,48 @@ BOOST_AUTO_TEST_CASE(hd_public__derive_public__long_seed__expected)
     BOOST_REQUIRE_EQUAL(m0xH1yH2_pub.encoded(), "xpub6FnCn6nSzZAw5Tw7cgR9bi15UV96gLZhjDstkXXxvCLsUXBGXPdSnLFbdpq8p9HmGsApME5hQTZ3emM2rnY5agb9rXpVGyy3bdW6EEgAtqt");
 }
 
+BOOST_AUTO_TEST_CASE(hd_public__derive_range__short_seed__matches_derive_public)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    const hd_public m_pub = m;
+    const auto children = m_pub.derive_range(5, 20);
+    BOOST_REQUIRE_EQUAL(children.size(), 20u);
+
+    for (uint32_t index = 0; index < children.size(); ++index)
+        BOOST_REQUIRE(children[index] == m_pub.derive_public(5 + index));
+}
+
+BOOST_AUTO_TEST_CASE(hd_public__derive_range__spans_hardened__hardened_invalid)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    const hd_public m_pub = m;
+    const auto children = m_pub.derive_range(hd_first_hardened_key - 2, 4);
+    BOOST_REQUIRE_EQUAL(children.size(), 4u);
+    BOOST_REQUIRE(children[0]);
+    BOOST_REQUIRE(children[1]);
+    BOOST_REQUIRE(!children[2]);
+    BOOST_REQUIRE(!children[3]);
+}
+
+BOOST_AUTO_TEST_CASE(hd_public__derive_range__threadpool__matches_serial)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, LONG_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    const hd_public m_pub = m;
+    threadpool pool(3);
+    const auto parallel = m_pub.derive_range(0, 10, pool);
+    pool.shutdown();
+    pool.join();
+
+    BOOST_REQUIRE(parallel == m_pub.derive_range(0, 10));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -99,6 +99,63 @@ BOOST_AUTO_TEST_CASE(mnemonic__validate_mnemonic__invalid)
     }
 }
 
+BOOST_AUTO_TEST_CASE(mnemonic__decode_entropy__trezor__expected_entropy_and_language)
+{
+    for (const auto& vector: mnemonic_trezor_vectors)
+    {
+        data_chunk entropy;
+        const dictionary* lexicon = nullptr;
+        const auto words = split(vector.mnemonic, ",");
+        BOOST_REQUIRE(decode_entropy(entropy, lexicon, words));
+        BOOST_REQUIRE_EQUAL(encode_base16(entropy), vector.entropy);
+        BOOST_REQUIRE(lexicon == &language::en);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mnemonic__decode_entropy__each_language__expected)
+{
+    const data_chunk entropy(32, 0x5a);
+
+    for (const auto lexicon: language::all)
+    {
+        data_chunk out_entropy;
+        const dictionary* out_lexicon = nullptr;
+        const auto words = create_mnemonic(entropy, *lexicon);
+        BOOST_REQUIRE(decode_entropy(out_entropy, out_lexicon, words));
+        BOOST_REQUIRE(out_entropy == entropy);
+
+        // Simplified and traditional Chinese may share every word.
+        BOOST_REQUIRE(validate_mnemonic(words, *out_lexicon));
+        BOOST_REQUIRE(create_mnemonic(entropy, *out_lexicon) == words);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mnemonic__decode_entropy__invalid__false)
+{
+    for (const auto& mnemonic: invalid_mnemonic_tests)
+    {
+        data_chunk entropy;
+        const dictionary* lexicon = nullptr;
+        const auto words = split(mnemonic, ",");
+        BOOST_REQUIRE(!decode_entropy(entropy, lexicon, words));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mnemonic__validate_mnemonic__copied_dictionary__true)
+{
+    const dictionary copy = language::es;
+    const data_chunk entropy(16, 0x42);
+    const auto words = create_mnemonic(entropy, copy);
+    BOOST_REQUIRE(validate_mnemonic(words, copy));
+    BOOST_REQUIRE(!validate_mnemonic(words, language::en));
+
+    // A modified dictionary is searched directly, not through an index.
+    auto modified = copy;
+    modified[0] = "zzzz";
+    BOOST_REQUIRE(validate_mnemonic(create_mnemonic(data_chunk(16, 0x00),
+        modified), modified));
+}
+
 BOOST_AUTO_TEST_CASE(mnemonic__create_mnemonic__tiny)
 {
     const data_chunk entropy(4, 0xa9);
@@ -0,0 +1,176 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+using namespace bc::wallet;
+
+BOOST_AUTO_TEST_SUITE(select_outputs_tests)
+
+typedef select_outputs::algorithm algorithm;
+
+static output_info::list make_outputs(const std::vector<uint64_t>& values)
+{
+    output_info::list out;
+    for (uint32_t index = 0; index < values.size(); ++index)
+        out.push_back({ { null_hash, index }, values[index] });
+
+    return out;
+}
+
+static uint64_t sum(const points_info& selected,
+    const output_info::list& unspent)
+{
+    uint64_t total = 0;
+    for (const auto& point: selected.points)
+        total += unspent[point.index()].value;
+
+    return total;
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__greedy__single_greater__smallest)
+{
+    const auto unspent = make_outputs({ 5, 40, 25, 30 });
+    points_info out;
+    select_outputs::select(out, unspent, 22);
+    BOOST_REQUIRE_EQUAL(out.points.size(), 1u);
+    BOOST_REQUIRE_EQUAL(out.points[0].index(), 2u);
+    BOOST_REQUIRE_EQUAL(out.change, 3u);
+
+    points_info indexed;
+    select_outputs::select(indexed, unspent_index(unspent), 22);
+    BOOST_REQUIRE(indexed.points == out.points);
+    BOOST_REQUIRE_EQUAL(indexed.change, out.change);
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__greedy__lessers__largest_first)
+{
+    const auto unspent = make_outputs({ 5, 10, 20, 15 });
+    points_info out;
+    select_outputs::select(out, unspent, 30);
+    BOOST_REQUIRE_EQUAL(out.points.size(), 2u);
+    BOOST_REQUIRE_EQUAL(out.change, 5u);
+
+    points_info indexed;
+    select_outputs::select(indexed, unspent_index(unspent), 30);
+    BOOST_REQUIRE(indexed.points == out.points);
+    BOOST_REQUIRE_EQUAL(indexed.change, out.change);
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__select__insufficient__empty)
+{
+    const auto unspent = make_outputs({ 5, 10 });
+    for (const auto option: { algorithm::greedy, algorithm::largest_first,
+        algorithm::branch_and_bound, algorithm::knapsack })
+    {
+        points_info out;
+        select_outputs::select(out, unspent, 16, option);
+        BOOST_REQUIRE(out.points.empty());
+        BOOST_REQUIRE_EQUAL(out.change, 0u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__largest_first__fewest_inputs)
+{
+    const auto unspent = make_outputs({ 1, 50, 2, 30, 3 });
+    points_info out;
+    select_outputs::select(out, unspent_index(unspent), 10,
+        algorithm::largest_first);
+    BOOST_REQUIRE_EQUAL(out.points.size(), 1u);
+    BOOST_REQUIRE_EQUAL(out.points[0].index(), 1u);
+    BOOST_REQUIRE_EQUAL(out.change, 40u);
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__branch_and_bound__exact__no_change)
+{
+    const auto unspent = make_outputs({ 1, 2, 4, 8, 16, 32, 100 });
+    points_info out;
+    select_outputs::select(out, unspent_index(unspent), 45,
+        algorithm::branch_and_bound);
+    BOOST_REQUIRE_EQUAL(out.points.size(), 4u);
+    BOOST_REQUIRE_EQUAL(out.change, 0u);
+    BOOST_REQUIRE_EQUAL(sum(out, unspent), 45u);
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__branch_and_bound__equal_values__exact)
+{
+    const auto unspent = make_outputs({ 7, 7, 7, 7, 7, 3, 3 });
+    points_info out;
+    select_outputs::select(out, unspent_index(unspent), 27,
+        algorithm::branch_and_bound);
+    BOOST_REQUIRE_EQUAL(out.change, 0u);
+    BOOST_REQUIRE_EQUAL(sum(out, unspent), 27u);
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__branch_and_bound__within_cost__change)
+{
+    const auto unspent = make_outputs({ 10, 20, 40 });
+    points_info out;
+    select_outputs::select(out, unspent_index(unspent), 28,
+        algorithm::branch_and_bound, 2);
+    BOOST_REQUIRE_EQUAL(out.points.size(), 2u);
+    BOOST_REQUIRE_EQUAL(out.change, 2u);
+    BOOST_REQUIRE_EQUAL(sum(out, unspent), 30u);
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__branch_and_bound__no_match__empty)
+{
+    const auto unspent = make_outputs({ 10, 20, 40 });
+    points_info out;
+    select_outputs::select(out, unspent_index(unspent), 25,
+        algorithm::branch_and_bound, 2);
+    BOOST_REQUIRE(out.points.empty());
+    BOOST_REQUIRE_EQUAL(out.change, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__knapsack__exact_single__selected)
+{
+    const auto unspent = make_outputs({ 3, 9, 12, 20 });
+    points_info out;
+    select_outputs::select(out, unspent, 12, algorithm::knapsack);
+    BOOST_REQUIRE_EQUAL(out.points.size(), 1u);
+    BOOST_REQUIRE_EQUAL(out.points[0].index(), 2u);
+    BOOST_REQUIRE_EQUAL(out.change, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__knapsack__lessers__least_excess)
+{
+    const auto unspent = make_outputs({ 6, 5, 4, 3, 100 });
+    points_info out;
+    select_outputs::select(out, unspent, 15, algorithm::knapsack);
+    BOOST_REQUIRE_EQUAL(out.change, 0u);
+    BOOST_REQUIRE_EQUAL(sum(out, unspent), 15u);
+}
+
+BOOST_AUTO_TEST_CASE(select_outputs__knapsack__greater_smaller__greater)
+{
+    const auto unspent = make_outputs({ 10, 10, 10, 18 });
+    points_info out;
+    select_outputs::select(out, unspent, 15, algorithm::knapsack);
+    BOOST_REQUIRE_EQUAL(out.points.size(), 1u);
+    BOOST_REQUIRE_EQUAL(out.points[0].index(), 3u);
+    BOOST_REQUIRE_EQUAL(out.change, 3u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
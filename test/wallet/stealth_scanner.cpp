@@ -0,0 +1,242 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+using namespace bc::wallet;
+
+BOOST_AUTO_TEST_SUITE(stealth_scanner_tests)
+
+#define SCAN_PRIVATE "fa63521e333e4b9f6a98a142680d3aef4d8e7f79723ce0043691db55c36bd905"
+#define SPEND_PRIVATE "dcc1250b51c0f03ae4e978e0256ede51dc1144e345c926262b9717b1bcc9bd1b"
+#define OTHER_PRIVATE "5f70a77b32260a7a32c62242381fba2cf40c0e209e665a7959418eae4f2da22b"
+
+static stealth_address make_address(const binary& filter,
+    const ec_secret& scan_secret)
+{
+    ec_secret spend_secret;
+    ec_compressed scan_key;
+    ec_compressed spend_key;
+    BOOST_REQUIRE(decode_base16(spend_secret, SPEND_PRIVATE));
+    BOOST_REQUIRE(secret_to_public(scan_key, scan_secret));
+    BOOST_REQUIRE(secret_to_public(spend_key, spend_secret));
+    return{ filter, scan_key, { spend_key } };
+}
+
+// A stealth payment output at index 1 following its null data output.
+static transaction make_payment(const stealth_address& address,
+    const binary& filter, uint8_t seed)
+{
+    data_chunk data;
+    ec_secret ephemeral_secret;
+    BOOST_REQUIRE(create_stealth_data(data, ephemeral_secret, filter,
+        data_chunk(32, seed)));
+
+    ec_compressed stealth_key;
+    BOOST_REQUIRE(uncover_stealth(stealth_key, address.scan_key(),
+        ephemeral_secret, address.spend_keys().front()));
+
+    const auto hash = bitcoin_short_hash(stealth_key);
+    const output::list outputs
+    {
+        { 0, script(operation::to_null_data_pattern(data)) },
+        { 42, script(operation::to_pay_key_hash_pattern(hash)) }
+    };
+
+    return{ 1, 0, {}, outputs };
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__watch__wrong_scan_secret__false)
+{
+    ec_secret scan_secret;
+    ec_secret other_secret;
+    BOOST_REQUIRE(decode_base16(scan_secret, SCAN_PRIVATE));
+    BOOST_REQUIRE(decode_base16(other_secret, OTHER_PRIVATE));
+    const auto address = make_address(binary("1010"), scan_secret);
+
+    stealth_scanner scanner;
+    BOOST_REQUIRE(!scanner.watch(address, other_secret));
+    BOOST_REQUIRE(scanner.watch(address, scan_secret));
+    BOOST_REQUIRE_EQUAL(scanner.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__scan__matching_filter__match)
+{
+    ec_secret scan_secret;
+    BOOST_REQUIRE(decode_base16(scan_secret, SCAN_PRIVATE));
+    const binary filter("1010");
+    const auto address = make_address(filter, scan_secret);
+    const transaction::list transactions
+    {
+        make_payment(address, filter, 0x2a)
+    };
+
+    stealth_scanner scanner;
+    BOOST_REQUIRE(scanner.watch(make_address(binary("01"), scan_secret),
+        scan_secret));
+    BOOST_REQUIRE(scanner.watch(address, scan_secret));
+
+    std::vector<stealth_scanner::match> matches;
+    scanner.scan(transactions, [&](const stealth_scanner::match& match)
+    {
+        matches.push_back(match);
+    });
+
+    BOOST_REQUIRE_EQUAL(matches.size(), 1u);
+    BOOST_REQUIRE_EQUAL(matches.front().address, 1u);
+    BOOST_REQUIRE_EQUAL(matches.front().output_index, 1u);
+    BOOST_REQUIRE(matches.front().transaction_hash ==
+        transactions.front().hash());
+
+    const auto script = transactions.front().outputs()[1].script();
+    BOOST_REQUIRE(bitcoin_short_hash(matches.front().stealth_public_key) ==
+        to_array<short_hash_size>(script.operations()[2].data()));
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__scan__empty_filter__matches_all)
+{
+    ec_secret scan_secret;
+    BOOST_REQUIRE(decode_base16(scan_secret, SCAN_PRIVATE));
+    const auto address = make_address(binary("0110"), scan_secret);
+    const transaction::list transactions
+    {
+        make_payment(address, binary("0110"), 0x01),
+        make_payment(address, binary("1001"), 0x02)
+    };
+
+    stealth_scanner scanner;
+    BOOST_REQUIRE(scanner.watch(make_address({}, scan_secret), scan_secret));
+
+    size_t count = 0;
+    scanner.scan(transactions, [&](const stealth_scanner::match&)
+    {
+        ++count;
+    });
+
+    BOOST_REQUIRE_EQUAL(count, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__scan__watch_from_handler__no_deadlock)
+{
+    ec_secret scan_secret;
+    BOOST_REQUIRE(decode_base16(scan_secret, SCAN_PRIVATE));
+    const binary filter("1010");
+    const auto address = make_address(filter, scan_secret);
+    const transaction::list transactions
+    {
+        make_payment(address, filter, 0x2a)
+    };
+
+    stealth_scanner scanner;
+    BOOST_REQUIRE(scanner.watch(address, scan_secret));
+
+    scanner.scan(transactions, [&](const stealth_scanner::match&)
+    {
+        BOOST_REQUIRE(scanner.watch(address, scan_secret));
+    });
+
+    BOOST_REQUIRE_EQUAL(scanner.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__scan__other_filter__no_match)
+{
+    ec_secret scan_secret;
+    BOOST_REQUIRE(decode_base16(scan_secret, SCAN_PRIVATE));
+    const auto address = make_address(binary("1010"), scan_secret);
+    const transaction::list transactions
+    {
+        make_payment(address, binary("0101"), 0x2a)
+    };
+
+    stealth_scanner scanner;
+    BOOST_REQUIRE(scanner.watch(address, scan_secret));
+
+    size_t count = 0;
+    scanner.scan(transactions, [&](const stealth_scanner::match&)
+    {
+        ++count;
+    });
+
+    BOOST_REQUIRE_EQUAL(count, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__scan__other_scan_key__no_match)
+{
+    ec_secret scan_secret;
+    ec_secret other_secret;
+    BOOST_REQUIRE(decode_base16(scan_secret, SCAN_PRIVATE));
+    BOOST_REQUIRE(decode_base16(other_secret, OTHER_PRIVATE));
+    const binary filter("11");
+    const transaction::list transactions
+    {
+        make_payment(make_address(filter, scan_secret), filter, 0x2a)
+    };
+
+    stealth_scanner scanner;
+    BOOST_REQUIRE(scanner.watch(make_address(filter, other_secret),
+        other_secret));
+
+    size_t count = 0;
+    scanner.scan(transactions, [&](const stealth_scanner::match&)
+    {
+        ++count;
+    });
+
+    BOOST_REQUIRE_EQUAL(count, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(stealth_scanner__scan__threadpool__same_matches)
+{
+    ec_secret scan_secret;
+    BOOST_REQUIRE(decode_base16(scan_secret, SCAN_PRIVATE));
+    const binary filter("1");
+    const auto address = make_address(filter, scan_secret);
+
+    transaction::list transactions;
+    for (uint8_t seed = 0; seed < 8; ++seed)
+        transactions.push_back(make_payment(address, filter, seed));
+
+    stealth_scanner scanner;
+    BOOST_REQUIRE(scanner.watch(address, scan_secret));
+
+    std::vector<hash_digest> serial;
+    scanner.scan(transactions, [&](const stealth_scanner::match& match)
+    {
+        serial.push_back(match.transaction_hash);
+    });
+
+    threadpool pool(4);
+    std::vector<hash_digest> parallel;
+    scanner.scan(transactions, pool, [&](const stealth_scanner::match& match)
+    {
+        parallel.push_back(match.transaction_hash);
+    });
+
+    pool.shutdown();
+    pool.join();
+    BOOST_REQUIRE_EQUAL(serial.size(), transactions.size());
+    BOOST_REQUIRE(serial == parallel);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
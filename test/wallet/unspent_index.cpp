@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <type_traits>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+using namespace bc::wallet;
+
+BOOST_AUTO_TEST_SUITE(unspent_index_tests)
+
+static output_info make_output(uint32_t index, uint64_t value)
+{
+    return{ { null_hash, index }, value };
+}
+
+BOOST_AUTO_TEST_CASE(unspent_index__construct__list__ordered_by_value)
+{
+    const unspent_index index(
+    {
+        make_output(0, 30), make_output(1, 10), make_output(2, 20)
+    });
+
+    BOOST_REQUIRE_EQUAL(index.size(), 3u);
+    BOOST_REQUIRE_EQUAL(index.total(), 60u);
+
+    auto it = index.by_value().begin();
+    BOOST_REQUIRE_EQUAL(it->first, 10u);
+    BOOST_REQUIRE_EQUAL(it->second.index(), 1u);
+    BOOST_REQUIRE_EQUAL((++it)->first, 20u);
+    BOOST_REQUIRE_EQUAL((++it)->first, 30u);
+}
+
+BOOST_AUTO_TEST_CASE(unspent_index__add__duplicate_point__false)
+{
+    unspent_index index;
+    BOOST_REQUIRE(index.add(make_output(0, 10)));
+    BOOST_REQUIRE(!index.add(make_output(0, 20)));
+    BOOST_REQUIRE_EQUAL(index.size(), 1u);
+    BOOST_REQUIRE_EQUAL(index.total(), 10u);
+}
+
+BOOST_AUTO_TEST_CASE(unspent_index__remove__indexed__updates_total)
+{
+    unspent_index index({ make_output(0, 10), make_output(1, 10) });
+    BOOST_REQUIRE(index.remove(point{ null_hash, 1 }));
+    BOOST_REQUIRE(!index.remove(point{ null_hash, 1 }));
+    BOOST_REQUIRE_EQUAL(index.size(), 1u);
+    BOOST_REQUIRE_EQUAL(index.total(), 10u);
+    BOOST_REQUIRE_EQUAL(index.by_value().begin()->second.index(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(unspent_index__remove__saturated_total__recomputed)
+{
+    unspent_index index({ make_output(0, max_uint64), make_output(1, 10) });
+    BOOST_REQUIRE_EQUAL(index.total(), max_uint64);
+    BOOST_REQUIRE(index.remove(point{ null_hash, 0 }));
+    BOOST_REQUIRE_EQUAL(index.total(), 10u);
+}
+
+BOOST_AUTO_TEST_CASE(unspent_index__clear__empty)
+{
+    unspent_index index({ make_output(0, 10) });
+    index.clear();
+    BOOST_REQUIRE(index.empty());
+    BOOST_REQUIRE_EQUAL(index.total(), 0u);
+    BOOST_REQUIRE(index.add(make_output(0, 10)));
+}
+
+BOOST_AUTO_TEST_CASE(unspent_index__copy__not_copyable)
+{
+    BOOST_REQUIRE(!std::is_copy_constructible<unspent_index>::value);
+    BOOST_REQUIRE(!std::is_copy_assignable<unspent_index>::value);
+}
+
+BOOST_AUTO_TEST_CASE(unspent_index__move__source_destroyed__remove_add)
+{
+    unspent_index index;
+
+    {
+        unspent_index source({ make_output(0, 10), make_output(1, 20) });
+        unspent_index moved(std::move(source));
+        BOOST_REQUIRE(source.empty());
+        BOOST_REQUIRE_EQUAL(source.total(), 0u);
+        index = std::move(moved);
+    }
+
+    BOOST_REQUIRE(index.remove(point{ null_hash, 0 }));
+    BOOST_REQUIRE(index.add(make_output(2, 5)));
+    BOOST_REQUIRE_EQUAL(index.size(), 2u);
+    BOOST_REQUIRE_EQUAL(index.total(), 25u);
+    BOOST_REQUIRE_EQUAL(index.by_value().begin()->first, 5u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()